@@ -0,0 +1,305 @@
+/**
+ * Assignment 1: priority queue of processes
+ * @file bench.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief A parameterised benchmark of the ReadyQueue implementations.
+ * It generates a random add/remove workload from the command line parameters, runs warm-up and repeated
+ * trials, and reports the throughput and the median/p99 latency of each operation.
+ *
+ * Usage: ./bench [-n table_size] [-o num_ops] [-a add_percent] [-d uniform|skewed|constant]
+ *                [-q heap|bucket|all] [-w warmup_runs] [-t trials] [-s seed]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "readyqueue.h"
+#include "bucketreadyqueue.h"
+#include "pcbtable.h"
+
+using namespace std;
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief The parameters of a benchmark run.
+ */
+struct BenchConfig {
+    // Number of PCBs in the table
+    int table_size = 500;
+    // Number of add/remove operations per run
+    int num_ops = 1000000;
+    // Percentage of the operations that are adds
+    int add_percent = 50;
+    // Distribution of the priorities: "uniform", "skewed" or "constant"
+    string distribution = "uniform";
+    // Queue implementation to run: "heap", "bucket" or "all"
+    string queue = "all";
+    // Number of untimed warm-up runs
+    int warmup = 1;
+    // Number of timed trials
+    int trials = 5;
+    // Seed of the workload generator
+    unsigned int seed = 1;
+};
+
+/**
+ * @brief One pre-generated operation. Generating the workload up front keeps the random number
+ * generator out of the measured time.
+ */
+struct Op {
+    // True for an add, false for a remove
+    bool is_add;
+    // Table index of the PCB to add
+    int idx;
+    // New priority of the PCB to add
+    unsigned int priority;
+};
+
+/**
+ * @brief Draw priorities in the range 1-50 from the configured distribution.
+ */
+class PriorityGenerator {
+private:
+    // The distribution name
+    string distribution;
+    // Cumulative weights of the skewed (Zipf) distribution, from priority 50 down to 1
+    vector<double> cumulative;
+public:
+    PriorityGenerator(const string &distribution) : distribution(distribution) {
+        double total = 0;
+        for (unsigned int rank = 1; rank <= MAX_PRIORITY; rank++) {
+            total += 1.0 / rank;
+            cumulative.push_back(total);
+        }
+        for (size_t i = 0; i < cumulative.size(); i++) {
+            cumulative[i] /= total;
+        }
+    }
+
+    /**
+     * @brief Draw a priority.
+     * @param rng: the random number generator
+     * @return unsigned int: a priority between 1 and 50
+     */
+    unsigned int next(mt19937 &rng) {
+        if (distribution == "constant") {
+            return (MIN_PRIORITY + MAX_PRIORITY) / 2;
+        }
+        if (distribution == "skewed") {
+            // Zipf: the highest priorities are by far the most common, as with a few interactive processes
+            double u = uniform_real_distribution<double>(0, 1)(rng);
+            size_t rank = lower_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin();
+            return MAX_PRIORITY - min<size_t>(rank, MAX_PRIORITY - 1);
+        }
+        return rng() % MAX_PRIORITY + MIN_PRIORITY;
+    }
+};
+
+/**
+ * @brief The latency and throughput results of all trials of one queue.
+ */
+struct BenchResult {
+    // Throughput of every trial, in operations per second
+    vector<double> ops_per_sec;
+    // Latency of every add, pooled over the trials, in nanoseconds
+    vector<double> add_ns;
+    // Latency of every remove, pooled over the trials, in nanoseconds
+    vector<double> remove_ns;
+};
+
+/**
+ * @brief Get the p-th percentile of a list of samples.
+ * @param samples: the samples; they are partially reordered
+ * @param p: the percentile between 0 and 100
+ * @return double: the percentile, or 0 if there are no samples
+ */
+double percentile(vector<double> &samples, double p) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t k = min(samples.size() - 1, (size_t)(p / 100.0 * samples.size()));
+    nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return samples[k];
+}
+
+/**
+ * @brief Reset the PCBs and the queue to the initial state of the workload: the first half of the PCBs queued.
+ * @param q: the queue, which must be empty
+ * @param table: the PCBTable
+ * @param config: the benchmark parameters
+ * @param initial: the initial priority of every PCB
+ */
+template <class Queue>
+void reset(Queue &q, PCBTable &table, const BenchConfig &config, const vector<unsigned int> &initial) {
+    while (q.size() > 0) {
+        q.removePCB();
+    }
+    for (int i = 0; i < config.table_size; i++) {
+        PCB *pcb = table.getPCB(i);
+        pcb->setPriority(initial[i]);
+        pcb->setState(ProcState::NEW);
+        if (i % 2 == 0) {
+            q.addPCB(pcb);
+        }
+    }
+}
+
+/**
+ * @brief Run the workload once.
+ * @param q: the ready queue
+ * @param table: the PCBTable
+ * @param ops: the operations to run
+ * @param result: if not null, the latency of every operation is recorded in it
+ */
+template <class Queue>
+void runOnce(Queue &q, PCBTable &table, const vector<Op> &ops, BenchResult *result) {
+    for (size_t i = 0; i < ops.size(); i++) {
+        const Op &op = ops[i];
+        Clock::time_point start;
+        if (result != nullptr) {
+            start = Clock::now();
+        }
+        if (op.is_add) {
+            PCB *pcb = table.getPCB(op.idx);
+            // As in test2, only a PCB that is not already queued is added
+            if (pcb->getState() == ProcState::READY) {
+                continue;
+            }
+            pcb->setPriority(op.priority);
+            q.addPCB(pcb);
+        } else if (q.size() > 0) {
+            q.removePCB();
+        }
+        if (result != nullptr) {
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            (op.is_add ? result->add_ns : result->remove_ns).push_back(ns);
+        }
+    }
+}
+
+/**
+ * @brief Benchmark one queue implementation: warm-up runs, then trials timing the whole run for the
+ * throughput, each followed by a run timing every operation for the latency.
+ * @param name: the name of the queue in the report
+ * @param table: the PCBTable
+ * @param config: the benchmark parameters
+ * @param ops: the operations to run
+ * @param initial: the initial priority of every PCB
+ */
+template <class Queue>
+void benchmark(const char *name, PCBTable &table, const BenchConfig &config, const vector<Op> &ops,
+               const vector<unsigned int> &initial) {
+    Queue q;
+    BenchResult result;
+    for (int i = 0; i < config.warmup; i++) {
+        reset(q, table, config, initial);
+        runOnce(q, table, ops, nullptr);
+    }
+    for (int i = 0; i < config.trials; i++) {
+        reset(q, table, config, initial);
+        Clock::time_point start = Clock::now();
+        runOnce(q, table, ops, nullptr);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        result.ops_per_sec.push_back(seconds > 0 ? ops.size() / seconds : 0);
+
+        reset(q, table, config, initial);
+        runOnce(q, table, ops, &result);
+    }
+
+    cout << name << ": throughput median = " << percentile(result.ops_per_sec, 50) << " ops/sec"
+         << " (min " << *min_element(result.ops_per_sec.begin(), result.ops_per_sec.end())
+         << ", max " << *max_element(result.ops_per_sec.begin(), result.ops_per_sec.end()) << ")" << endl;
+    cout << "    addPCB    latency: median = " << percentile(result.add_ns, 50) << " ns, p99 = "
+         << percentile(result.add_ns, 99) << " ns (" << result.add_ns.size() << " samples)" << endl;
+    cout << "    removePCB latency: median = " << percentile(result.remove_ns, 50) << " ns, p99 = "
+         << percentile(result.remove_ns, 99) << " ns (" << result.remove_ns.size() << " samples)" << endl;
+}
+
+/**
+ * @brief Estimate the cost of reading the clock, which is included in every latency sample.
+ * @return double: the median cost of a pair of clock reads in nanoseconds
+ */
+double clockOverhead() {
+    vector<double> samples;
+    for (int i = 0; i < 100000; i++) {
+        Clock::time_point start = Clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+    }
+    return percentile(samples, 50);
+}
+
+/**
+ * @brief Print the usage of the program.
+ * @param prog: the program name
+ */
+void usage(const char *prog) {
+    cerr << "Usage: " << prog << " [-n table_size] [-o num_ops] [-a add_percent] [-d uniform|skewed|constant]" << endl
+         << "       [-q heap|bucket|all] [-w warmup_runs] [-t trials] [-s seed]" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    BenchConfig config;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:o:a:d:q:w:t:s:h")) != -1) {
+        switch (opt) {
+            case 'n': config.table_size = atoi(optarg); break;
+            case 'o': config.num_ops = atoi(optarg); break;
+            case 'a': config.add_percent = atoi(optarg); break;
+            case 'd': config.distribution = optarg; break;
+            case 'q': config.queue = optarg; break;
+            case 'w': config.warmup = atoi(optarg); break;
+            case 't': config.trials = atoi(optarg); break;
+            case 's': config.seed = atoi(optarg); break;
+            default: usage(argv[0]); return 1;
+        }
+    }
+    // Validate the parameters
+    if (config.table_size <= 0 || config.num_ops <= 0 || config.add_percent < 0 || config.add_percent > 100 ||
+        config.warmup < 0 || config.trials <= 0) {
+        cerr << "Error: sizes and counts must be positive and add_percent must be between 0 and 100" << endl;
+        usage(argv[0]);
+        return 1;
+    }
+    if (config.distribution != "uniform" && config.distribution != "skewed" && config.distribution != "constant") {
+        cerr << "Error: unknown priority distribution " << config.distribution << endl;
+        return 1;
+    }
+    if (config.queue != "heap" && config.queue != "bucket" && config.queue != "all") {
+        cerr << "Error: unknown queue " << config.queue << endl;
+        return 1;
+    }
+
+    // Generate the workload once so that every queue and every trial runs the same operations
+    mt19937 rng(config.seed);
+    PriorityGenerator priorities(config.distribution);
+    PCBTable table(config.table_size);
+    vector<unsigned int> initial(config.table_size);
+    for (int i = 0; i < config.table_size; i++) {
+        initial[i] = priorities.next(rng);
+        table.addNewPCB(i + 1, initial[i], i);
+    }
+    vector<Op> ops(config.num_ops);
+    for (int i = 0; i < config.num_ops; i++) {
+        ops[i].is_add = (int)(rng() % 100) < config.add_percent;
+        ops[i].idx = rng() % config.table_size;
+        ops[i].priority = priorities.next(rng);
+    }
+
+    cout << "ReadyQueue benchmark: table size = " << config.table_size << ", ops = " << config.num_ops
+         << ", add % = " << config.add_percent << ", priorities = " << config.distribution
+         << ", warm-up runs = " << config.warmup << ", trials = " << config.trials << endl;
+    cout << "Clock overhead included in each latency sample: ~" << clockOverhead() << " ns" << endl;
+    if (config.queue == "heap" || config.queue == "all") {
+        benchmark<ReadyQueue>("ReadyQueue (binary heap)", table, config, ops, initial);
+    }
+    if (config.queue == "bucket" || config.queue == "all") {
+        benchmark<BucketReadyQueue>("BucketReadyQueue", table, config, ops, initial);
+    }
+    return 0;
+}
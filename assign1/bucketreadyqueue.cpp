@@ -0,0 +1,97 @@
+/**
+ * Assignment 1: priority queue of processes
+ * @file bucketreadyqueue.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief This is the implementation file for the BucketReadyQueue class.
+ * @version 0.1
+ */
+#include <iostream>
+#include "bucketreadyqueue.h"
+
+using namespace std;
+
+/**
+ * @brief Construct a new, empty BucketReadyQueue object
+ */
+BucketReadyQueue::BucketReadyQueue() {
+    for (unsigned int p = 0; p <= MAX_PRIORITY; p++) {
+        head[p] = nullptr;
+        tail[p] = nullptr;
+    }
+    occupancy = 0;
+    count = 0;
+}
+
+/**
+ * @brief Destructor. The PCBs are owned by the PCBTable and are not deleted.
+ */
+BucketReadyQueue::~BucketReadyQueue() {
+}
+
+/**
+ * @brief Add a PCB representing a process into the ready queue.
+ * The PCB is appended to the tail of the list of its priority level.
+ *
+ * @param pcbPtr: the pointer to the PCB to be added
+ */
+void BucketReadyQueue::addPCB(PCB *pcbPtr) {
+    // When adding a PCB to the queue, its state changes to READY.
+    pcbPtr->setState(ProcState::READY);
+    unsigned int p = level(pcbPtr->getPriority());
+    pcbPtr->next = nullptr;
+    if (tail[p] == nullptr) {
+        head[p] = pcbPtr;
+        occupancy |= (uint64_t(1) << p);
+    } else {
+        tail[p]->next = pcbPtr;
+    }
+    tail[p] = pcbPtr;
+    count++;
+}
+
+/**
+ * @brief Remove and return the PCB with the highest priority from the queue
+ * The highest non-empty level is the highest set bit of the occupancy bitmap.
+ *
+ * @return PCB*: the pointer to the PCB with the highest priority, or nullptr if the queue is empty
+ */
+PCB* BucketReadyQueue::removePCB() {
+    if (occupancy == 0) {
+        return nullptr;
+    }
+    unsigned int p = 63 - __builtin_clzll(occupancy);
+    // Unlink the oldest PCB of the level
+    PCB *top = head[p];
+    head[p] = top->next;
+    if (head[p] == nullptr) {
+        tail[p] = nullptr;
+        occupancy &= ~(uint64_t(1) << p);
+    }
+    top->next = nullptr;
+    count--;
+    // When removing a PCB from the queue, its state changes to RUNNING.
+    top->setState(ProcState::RUNNING);
+    return top;
+}
+
+/**
+ * @brief Returns the number of elements in the queue.
+ *
+ * @return int: the number of PCBs in the queue
+ */
+int BucketReadyQueue::size() {
+    return count;
+}
+
+/**
+ * @brief Display the PCBs in the queue, from the highest to the lowest priority.
+ */
+void BucketReadyQueue::displayAll() {
+    cout << "Display Processes in ReadyQueue:" << endl;
+    for (unsigned int p = MAX_PRIORITY; p >= MIN_PRIORITY; p--) {
+        for (PCB *pcb = head[p]; pcb != nullptr; pcb = pcb->next) {
+            cout << "\t";
+            pcb->display();
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * Assignment 1: priority queue of processes
+ * @file bucketreadyqueue.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief BucketReadyQueue is a ReadyQueue variant that exploits the fixed 1-50 priority range.
+ * It keeps one FIFO list per priority level and a bitmap of the non-empty levels, so both
+ * addPCB and removePCB take constant time.
+ * @version 0.1
+ */
+#pragma once
+
+#include <cstdint>
+#include "pcb.h"
+
+/**
+ * @brief A bucket queue of PCB's that are in the READY state to be scheduled to run.
+ * Each priority level has an intrusive FIFO list linked through PCB::next, and bit p of the
+ * occupancy bitmap is set while level p is non-empty. The highest priority PCB is found with a
+ * single find-highest-set-bit on the bitmap. PCBs of equal priority are removed in FIFO order.
+ */
+class BucketReadyQueue {
+private:
+    // 64-bit occupancy bitmap, so every priority level must fit in one bit of it
+    static_assert(MAX_PRIORITY < 64, "priority levels must fit in the 64-bit occupancy bitmap");
+
+    // Head (oldest PCB) of the FIFO list of each priority level
+    PCB *head[MAX_PRIORITY + 1];
+    // Tail (newest PCB) of the FIFO list of each priority level
+    PCB *tail[MAX_PRIORITY + 1];
+    // Bit p is set if and only if the list of priority level p is non-empty
+    uint64_t occupancy;
+    // Number of PCBs currently in the queue
+    int count;
+
+    /**
+     * @brief Map a PCB priority to its bucket, clamping out-of-range priorities into 1-50.
+     * @param priority: the priority of a PCB
+     * @return unsigned int: the bucket index of the priority
+     */
+    static unsigned int level(unsigned int priority) {
+        if (priority < MIN_PRIORITY) return MIN_PRIORITY;
+        if (priority > MAX_PRIORITY) return MAX_PRIORITY;
+        return priority;
+    }
+
+public:
+    /**
+     * @brief Construct a new, empty BucketReadyQueue object
+     */
+    BucketReadyQueue();
+
+    /**
+     * @brief Destructor. The PCBs are owned by the PCBTable and are not deleted.
+     */
+    ~BucketReadyQueue();
+
+    /**
+     * @brief Add a PCB representing a process into the ready queue.
+     *
+     * @param pcbPtr: the pointer to the PCB to be added
+     */
+    void addPCB(PCB* pcbPtr);
+
+    /**
+     * @brief Remove and return the PCB with the highest priority from the queue
+     *
+     * @return PCB*: the pointer to the PCB with the highest priority, or nullptr if the queue is empty
+     */
+    PCB* removePCB();
+
+    /**
+     * @brief Returns the number of elements in the queue.
+     *
+     * @return int: the number of PCBs in the queue
+     */
+    int size();
+
+    /**
+     * @brief Display the PCBs in the queue, from the highest to the lowest priority.
+     */
+    void displayAll();
+
+    /**
+     * @brief Get the priority level of the PCB that removePCB would return, without removing it.
+     *
+     * @return unsigned int: the highest non-empty priority level, or 0 if the queue is empty
+     */
+    unsigned int topPriority() const {
+        return occupancy == 0 ? 0 : 63 - __builtin_clzll(occupancy);
+    }
+};
@@ -0,0 +1,134 @@
+/**
+ * Assignment 1: priority queue of processes
+ * @file concurrentreadyqueue.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief This is the implementation file for the ConcurrentReadyQueue class.
+ * @version 0.1
+ */
+#include <iostream>
+#include <functional>
+#include <thread>
+#include "concurrentreadyqueue.h"
+
+using namespace std;
+
+/**
+ * @brief Construct a new ConcurrentReadyQueue object
+ *
+ * @param num_threads: the expected number of threads using the queue. The queue uses twice as many shards.
+ */
+ConcurrentReadyQueue::ConcurrentReadyQueue(int num_threads) {
+    num_shards = 2 * (num_threads > 0 ? num_threads : 1);
+    shards = new Shard[num_shards];
+    for (int i = 0; i < num_shards; i++) {
+        shards[i].top.store(0);
+    }
+    count.store(0);
+}
+
+/**
+ * @brief Destructor. The PCBs are owned by the PCBTable and are not deleted.
+ */
+ConcurrentReadyQueue::~ConcurrentReadyQueue() {
+    delete[] shards;
+}
+
+/**
+ * @brief Get a random shard index, using a per-thread random number generator.
+ * @return int: the index of a shard
+ */
+int ConcurrentReadyQueue::randomShard() {
+    // xorshift generator, seeded differently in every thread
+    static thread_local unsigned int state = 0;
+    if (state == 0) {
+        state = (unsigned int)hash<thread::id>()(this_thread::get_id()) | 1;
+    }
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % num_shards;
+}
+
+/**
+ * @brief Add a PCB representing a process into the ready queue. It is thread-safe.
+ * The PCB goes to a random shard whose lock is free; a busy shard is skipped instead of waited on.
+ *
+ * @param pcbPtr: the pointer to the PCB to be added
+ */
+void ConcurrentReadyQueue::addPCB(PCB *pcbPtr) {
+    while (true) {
+        Shard &shard = shards[randomShard()];
+        if (!shard.lock.try_lock()) {
+            continue;
+        }
+        shard.queue.addPCB(pcbPtr);
+        shard.top.store(shard.queue.topPriority(), memory_order_relaxed);
+        // Count the PCB before it can be removed, so the count never goes negative
+        count.fetch_add(1);
+        shard.lock.unlock();
+        return;
+    }
+}
+
+/**
+ * @brief Remove and return a PCB of high priority from the queue. It is thread-safe.
+ * Two random shards are sampled and the top PCB is taken from the one with the higher priority.
+ * If sampling keeps finding empty or busy shards, every shard is scanned in turn.
+ *
+ * @return PCB*: the pointer to the removed PCB, or nullptr if the queue is empty
+ */
+PCB* ConcurrentReadyQueue::removePCB() {
+    // Number of two-choice attempts before falling back to a full scan
+    const int MAX_ATTEMPTS = 4 * num_shards;
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+        if (count.load() == 0) {
+            return nullptr;
+        }
+        int i = randomShard();
+        int j = randomShard();
+        unsigned int top_i = shards[i].top.load(memory_order_relaxed);
+        unsigned int top_j = shards[j].top.load(memory_order_relaxed);
+        Shard &shard = shards[top_j > top_i ? j : i];
+        if (shard.top.load(memory_order_relaxed) == 0 || !shard.lock.try_lock()) {
+            continue;
+        }
+        PCB *pcb = shard.queue.removePCB();
+        shard.top.store(shard.queue.topPriority(), memory_order_relaxed);
+        shard.lock.unlock();
+        if (pcb != nullptr) {
+            count.fetch_sub(1);
+            return pcb;
+        }
+    }
+    // Full scan, waiting on every lock, so that a non-empty queue never reports empty
+    for (int i = 0; i < num_shards; i++) {
+        lock_guard<mutex> guard(shards[i].lock);
+        PCB *pcb = shards[i].queue.removePCB();
+        shards[i].top.store(shards[i].queue.topPriority(), memory_order_relaxed);
+        if (pcb != nullptr) {
+            count.fetch_sub(1);
+            return pcb;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Returns the number of elements in the queue.
+ *
+ * @return int: the number of PCBs in the queue
+ */
+int ConcurrentReadyQueue::size() {
+    return count.load();
+}
+
+/**
+ * @brief Display the PCBs in the queue, shard by shard.
+ */
+void ConcurrentReadyQueue::displayAll() {
+    for (int i = 0; i < num_shards; i++) {
+        lock_guard<mutex> guard(shards[i].lock);
+        cout << "Shard " << i << ": ";
+        shards[i].queue.displayAll();
+    }
+}
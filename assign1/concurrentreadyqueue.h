@@ -0,0 +1,93 @@
+/**
+ * Assignment 1: priority queue of processes
+ * @file concurrentreadyqueue.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief ConcurrentReadyQueue is a thread-safe ReadyQueue variant for dispatching to several CPU workers.
+ * It is a relaxed "MultiQueue": the PCBs are spread over several independently locked bucket queues.
+ * @version 0.1
+ */
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include "bucketreadyqueue.h"
+
+/**
+ * @brief A thread-safe, relaxed priority queue of PCB's in the READY state.
+ * addPCB inserts into a randomly chosen shard, and removePCB samples two random shards and removes the
+ * top PCB of the one with the higher priority. There is no single lock that all threads contend on, so
+ * throughput scales with the number of threads. In exchange removePCB returns a PCB of high priority,
+ * but not necessarily the highest one in the whole queue.
+ */
+class ConcurrentReadyQueue {
+private:
+    // Size of a cache line, used to keep the shards from false sharing
+    static const int CACHE_LINE = 64;
+
+    // One independently locked sub-queue
+    struct alignas(CACHE_LINE) Shard {
+        // Protects the queue of the shard
+        std::mutex lock;
+        // The PCBs of the shard
+        BucketReadyQueue queue;
+        // Priority of the top PCB of the shard, or 0 if it is empty.
+        // It is read without the lock to pick a shard, and only written under the lock.
+        std::atomic<unsigned int> top;
+    };
+
+    // Array of shards
+    Shard *shards;
+    // Number of shards
+    int num_shards;
+    // Total number of PCBs in the queue
+    std::atomic<int> count;
+
+    /**
+     * @brief Get a random shard index, using a per-thread random number generator.
+     * @return int: the index of a shard
+     */
+    int randomShard();
+
+public:
+    /**
+     * @brief Construct a new ConcurrentReadyQueue object
+     *
+     * @param num_threads: the expected number of threads using the queue. The queue uses twice as many shards.
+     */
+    ConcurrentReadyQueue(int num_threads = 4);
+
+    /**
+     * @brief Destructor. The PCBs are owned by the PCBTable and are not deleted.
+     */
+    ~ConcurrentReadyQueue();
+
+    // The shards hold locks, so the queue cannot be copied
+    ConcurrentReadyQueue(const ConcurrentReadyQueue &) = delete;
+    ConcurrentReadyQueue &operator=(const ConcurrentReadyQueue &) = delete;
+
+    /**
+     * @brief Add a PCB representing a process into the ready queue. It is thread-safe.
+     *
+     * @param pcbPtr: the pointer to the PCB to be added
+     */
+    void addPCB(PCB* pcbPtr);
+
+    /**
+     * @brief Remove and return a PCB of high priority from the queue. It is thread-safe.
+     *
+     * @return PCB*: the pointer to the removed PCB, or nullptr if the queue is empty
+     */
+    PCB* removePCB();
+
+    /**
+     * @brief Returns the number of elements in the queue.
+     *
+     * @return int: the number of PCBs in the queue
+     */
+    int size();
+
+    /**
+     * @brief Display the PCBs in the queue, shard by shard.
+     */
+    void displayAll();
+};
@@ -0,0 +1,197 @@
+/**
+ * Assignment 1: priority queue of processes
+ * @file objectpool.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief ObjectPool is a slab allocator for fixed-size objects such as PCBs.
+ * Objects are carved out of large slabs, freed objects are recycled through a free list, and
+ * all slabs are released in bulk when the pool is destroyed.
+ * @version 0.1
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief A slab/pool allocator of objects of type T.
+ * The first slab holds "first_slab_size" objects and every following slab doubles in size, so
+ * creating n objects costs O(log n) calls to the global operator new instead of n.
+ * Releasing the pool does not run destructors, so T must be trivially destructible.
+ */
+template <class T>
+class ObjectPool {
+private:
+    static_assert(std::is_trivially_destructible<T>::value, "pooled objects are released in bulk without destructors");
+    static_assert(sizeof(T) >= sizeof(void *), "a free object must be able to hold the free-list link");
+
+    // A slab header. The storage for "capacity" objects follows the header in the same allocation.
+    struct Slab {
+        // The next (older) slab of the pool
+        Slab *next;
+        // Number of objects the slab can hold
+        size_t capacity;
+        // Number of objects carved out of the slab so far
+        size_t used;
+    };
+
+    // A freed object is reused as a link of the free list
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    // Size of the slab header, rounded up so that the objects after it are aligned
+    static const size_t HEADER_SIZE = (sizeof(Slab) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    // Most recently allocated slab; objects are carved from it first
+    Slab *slabs;
+    // Objects that have been destroyed and can be handed out again
+    FreeNode *free_list;
+    // Number of objects the next slab will hold
+    size_t next_slab_size;
+    // Number of calls made to the global operator new
+    size_t allocation_count;
+    // Number of objects currently handed out
+    size_t object_count;
+
+    /**
+     * @brief Get the first object slot of a slab.
+     * @param slab: the slab
+     * @return T*: pointer to the storage of the first object
+     */
+    static T *items(Slab *slab) {
+        return reinterpret_cast<T *>(reinterpret_cast<char *>(slab) + HEADER_SIZE);
+    }
+
+    /**
+     * @brief Allocate a new slab with room for next_slab_size objects and make it the current slab.
+     */
+    void addSlab() {
+        Slab *slab = static_cast<Slab *>(::operator new(HEADER_SIZE + next_slab_size * sizeof(T)));
+        slab->next = slabs;
+        slab->capacity = next_slab_size;
+        slab->used = 0;
+        slabs = slab;
+        allocation_count++;
+        next_slab_size *= 2;
+    }
+
+public:
+    /**
+     * @brief Construct an empty pool. No memory is allocated until the first object is created.
+     * @param first_slab_size: number of objects in the first slab, e.g. the expected number of objects
+     */
+    explicit ObjectPool(size_t first_slab_size = 64) {
+        slabs = nullptr;
+        free_list = nullptr;
+        next_slab_size = first_slab_size > 0 ? first_slab_size : 1;
+        allocation_count = 0;
+        object_count = 0;
+    }
+
+    /**
+     * @brief Destroy the pool, releasing all slabs at once.
+     */
+    ~ObjectPool() {
+        releaseAll();
+    }
+
+    // The pool owns its slabs, so it cannot be copied
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    /**
+     * @brief Set the size of the next slab, e.g. to reserve room for a known number of objects.
+     * It only takes effect when the next slab is allocated.
+     * @param size: number of objects in the next slab
+     */
+    void setNextSlabSize(size_t size) {
+        next_slab_size = size > 0 ? size : 1;
+    }
+
+    /**
+     * @brief Create an object in the pool.
+     * A previously destroyed object is reused first, then the current slab, then a new slab.
+     * @param args: the arguments passed to the constructor of T
+     * @return T*: pointer to the new object
+     */
+    template <class... Args>
+    T *create(Args &&... args) {
+        void *slot;
+        if (free_list != nullptr) {
+            slot = free_list;
+            free_list = free_list->next;
+        } else {
+            if (slabs == nullptr || slabs->used == slabs->capacity) {
+                addSlab();
+            }
+            slot = items(slabs) + slabs->used;
+            slabs->used++;
+        }
+        object_count++;
+        return new (slot) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Return an object created by this pool so that its storage can be reused.
+     * @param obj: the object to destroy
+     */
+    void destroy(T *obj) {
+        if (obj == nullptr) {
+            return;
+        }
+        FreeNode *node = reinterpret_cast<FreeNode *>(obj);
+        node->next = free_list;
+        free_list = node;
+        object_count--;
+    }
+
+    /**
+     * @brief Check whether an object was created by this pool.
+     * It walks the slab list, which is only O(log n) long.
+     * @param obj: the object to check
+     * @return true if the object lives in one of the slabs of the pool
+     */
+    bool owns(const T *obj) const {
+        // std::less gives a total order on pointers that do not belong to the same array
+        std::less<const T *> before;
+        for (Slab *slab = slabs; slab != nullptr; slab = slab->next) {
+            const T *first = items(slab);
+            if (!before(obj, first) && before(obj, first + slab->capacity)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Release all slabs in bulk. Every object created by the pool becomes invalid.
+     */
+    void releaseAll() {
+        while (slabs != nullptr) {
+            Slab *next = slabs->next;
+            ::operator delete(slabs);
+            slabs = next;
+        }
+        free_list = nullptr;
+        object_count = 0;
+    }
+
+    /**
+     * @brief Get the number of calls made to the global operator new by this pool.
+     * @return size_t: the number of slab allocations
+     */
+    size_t allocations() const {
+        return allocation_count;
+    }
+
+    /**
+     * @brief Get the number of objects currently handed out by this pool.
+     * @return size_t: the number of live objects
+     */
+    size_t size() const {
+        return object_count;
+    }
+};
@@ -16,6 +16,10 @@ using namespace std;
 // A process (PCB) in ready queue should be in READY state
 enum class ProcState {NEW, READY, RUNNING, WAITING, TERMINATED};
 
+// The valid range of process priorities. Larger number represents higher priority
+const unsigned int MIN_PRIORITY = 1;
+const unsigned int MAX_PRIORITY = 50;
+
 /**
  * @brief A process control block (PCB) Process control block(PCB) is a data structure representing a process in the system.
    A process should have at least an ID and a state(i.e.NEW, READY, RUNNING, WAITING or TERMINATED).
@@ -31,6 +35,13 @@ public:
 	// The current state of the process.
 	// A process in the ReadyQueue should be in READY state
 	ProcState state;
+	// Slot of the PCB in the heap array of the ReadyQueue, or -1 if it is not queued.
+	// It lets the ReadyQueue find a queued PCB in O(1) to reprioritise or remove it.
+	int heap_index;
+	// Link to the next PCB in the same priority bucket of a BucketReadyQueue (intrusive FIFO).
+	// Only meaningful while the PCB is queued in a BucketReadyQueue.
+	// It is the last member so the four 32-bit fields pack into 16 bytes and a PCB takes 24.
+	PCB *next;
 
 	/**
 	 * @brief Construct a new PCB object
@@ -42,13 +53,15 @@ public:
         this->id = id;
         this->priority = priority;
         this->state = state;
+        this->heap_index = -1;
+        this->next = nullptr;
     }
 
     /**
      * @brief Destroy the PCB object.
      *
      */
-    ~PCB() {}
+    ~PCB() = default;
 
     /**
      * @brief Get the ID of the PCB.
@@ -82,7 +95,7 @@ public:
      * @param state
      */
     void setState(ProcState state) {
-        // TODO: add your code here
+        this->state = state;
     }
 
     /**
@@ -90,7 +103,7 @@ public:
      * @param priority
      */
     void setPriority(unsigned int priority) {
-        // TODO: add your code here
+        this->priority = priority;
     }
 
     /**
@@ -14,8 +14,11 @@
  *
  * @param size: the capacity of the PCBTable
  */
-PCBTable::PCBTable(int size) {
-   // TODO: add your code here
+PCBTable::PCBTable(int size)
+: pool(size > 0 ? size : 1)
+{
+    // Start with "size" empty slots; the table grows if a PCB is added beyond it
+    table.resize(size > 0 ? size : 0, nullptr);
 }
 
 /**
@@ -23,8 +26,16 @@ PCBTable::PCBTable(int size) {
  *
  */
 PCBTable::~PCBTable() {
-   // TODO: add your code here
-   // Delete all the PCBs in the table
+    // Delete the PCBs added with addPCB. The pooled PCBs are released in bulk by the pool destructor.
+    for (size_t i = 0; i < table.size(); i++) {
+        if (!pool.owns(table[i])) {
+            delete table[i];
+        }
+    }
+    for (size_t i = 0; i < retired.size(); i++) {
+        delete retired[i];
+    }
+    table.clear();
 }
 
 /**
@@ -34,8 +45,11 @@ PCBTable::~PCBTable() {
  * @return PCB*: pointer to the PCB at index "idx"
  */
 PCB* PCBTable::getPCB(unsigned int idx) {
-    // TODO: add your code here
-    return NULL;
+    // Out of range indexes have no PCB
+    if (idx >= table.size()) {
+        return NULL;
+    }
+    return table[idx];
 }
 
 /**
@@ -44,6 +58,40 @@ PCB* PCBTable::getPCB(unsigned int idx) {
  * @param pcb: the PCB to add
  */
 void PCBTable::addPCB(PCB *pcb, unsigned int idx) {
-    // TODO: add your code here
-    // Add a PCB pointer to the PCBTable at index idx.
+    // Grow the table if idx is beyond its current capacity
+    if (idx >= table.size()) {
+        table.resize(idx + 1, nullptr);
+    }
+    // The table owns its PCBs, so release the one being replaced
+    if (table[idx] != pcb) {
+        if (pool.owns(table[idx])) {
+            pool.destroy(table[idx]);
+        } else {
+            delete table[idx];
+        }
+    }
+    table[idx] = pcb;
+}
+
+/**
+ * @brief Add a new PCB to the PCBTable. The PCB is created in the slab pool of the table.
+ * @param pid Id of the new PCB
+ * @param priority Priority of the new PCB
+ * @param idx The index of the new PCB in the PCBTable
+ */
+void PCBTable::addNewPCB(unsigned int pid, unsigned int priority, unsigned int idx) {
+    PCB *old = getPCB(idx);
+    if (old != NULL && old->getState() == ProcState::READY) {
+        // The PCB may be queued: overwriting it would reset its queue links and releasing it would leave the
+        // queue pointing at freed storage. It stays alive until the table is destroyed.
+        if (!pool.owns(old)) {
+            retired.push_back(old);
+        }
+        table[idx] = pool.create(pid, priority);
+    } else if (old != NULL && pool.owns(old)) {
+        // Reuse the pooled PCB already at this index, which is in no ready queue
+        *old = PCB(pid, priority);
+    } else {
+        addPCB(pool.create(pid, priority), idx);
+    }
 }
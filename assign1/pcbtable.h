@@ -9,17 +9,27 @@
 // Remember to add sufficient and clear comments to your code
 #pragma once
 
+#include <vector>
 #include "pcb.h"
+#include "objectpool.h"
 
 /**
  * @brief PCTable is an array of all PCB's in the system
- * 
+ * PCBs created by addNewPCB come from a slab pool owned by the table. The first slab is sized to
+ * the capacity of the table, so the PCBs sit in one contiguous block: scanning the table (e.g.
+ * checking the state of every process) walks consecutive memory, and building or destroying a
+ * table of 100k PCBs takes a handful of allocations. Pooled PCBs never move, so the pointers
+ * handed out by getPCB stay valid for the lifetime of the table.
  */
 class PCBTable {
 private:
-    // TODO: add your private member variables here
-    // choose a data structure for the PCBTable. 
-    // You can use an array of PCB pointers, e.g. vector<PCB *>. 
+    // The table of PCB pointers, indexed by the table index. The table owns the PCBs it holds.
+    vector<PCB *> table;
+    // Slab pool backing the PCBs created by addNewPCB. It is released in bulk with the table.
+    ObjectPool<PCB> pool;
+    // PCBs added with addPCB that addNewPCB replaced while they were READY, so possibly still linked into a
+    // ready queue. They are deleted with the table; replaced pooled PCBs just stay in the pool until then.
+    vector<PCB *> retired;
 
 public:
     /**
@@ -35,6 +45,10 @@ public:
      */
     ~PCBTable();
 
+    // The table owns its PCBs, so it cannot be copied
+    PCBTable(const PCBTable &) = delete;
+    PCBTable &operator=(const PCBTable &) = delete;
+
     /**
      * @brief Get the PCB at index "idx" of the PCBTable.
      *
@@ -62,13 +76,31 @@ public:
     void addPCB(PCB *pcb, unsigned int idx);
 
     /**
-     * @brief Add a new PCB to the PCBTable.
+     * @brief Add a new PCB to the PCBTable. The PCB is created in the slab pool of the table.
+     * A pooled PCB already at idx is reused in place, unless it is READY: a READY PCB may be linked into a
+     * ready queue, so it is left untouched and alive until the table is destroyed, and idx gets a new PCB.
      * @param pid Id of the new PCB
      * @param priority Priority of the new PCB
      * @param idx The index of the new PCB in the PCBTable
      */
-    void addNewPCB(unsigned int pid, unsigned int priority, unsigned int idx) {
-        PCB *pcb = new PCB(pid, priority);
-        addPCB(pcb, idx);
+    void addNewPCB(unsigned int pid, unsigned int priority, unsigned int idx);
+
+    /**
+     * @brief Get the number of memory allocations made for the PCBs created by addNewPCB.
+     *
+     * @return size_t: the number of slab allocations of the PCB pool
+     */
+    size_t poolAllocations() const {
+        return pool.allocations();
+    }
+
+    /**
+     * @brief Get the number of PCBs created by addNewPCB that are still alive, including the READY ones that
+     *        addNewPCB replaced.
+     *
+     * @return size_t: the number of pooled PCBs
+     */
+    size_t pooledPCBs() const {
+        return pool.size();
     }
 };
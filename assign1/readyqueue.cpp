@@ -6,19 +6,91 @@ using namespace std;
 //You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
 // Remember to add sufficient comments to your code
 
+// Initial number of slots allocated for the heap array
+static const int INITIAL_CAPACITY = 64;
 
 /**
  * @brief Constructor for the ReadyQueue class.
  */
  ReadyQueue::ReadyQueue()  {
-     //TODO: add your code here
+     count = 0;
+     capacity = INITIAL_CAPACITY;
+     heap = new PCB*[capacity];
  }
 
 /**
  *@brief Destructor
 */
 ReadyQueue::~ReadyQueue() {
-    //TODO: add your code to release dynamically allocate memory
+    // The PCBs are owned by the PCBTable; only the heap array belongs to the queue
+    delete[] heap;
+}
+
+/**
+ * @brief Grow the heap array, doubling its capacity until it holds at least min_capacity PCBs.
+ * @param min_capacity: the number of PCBs the heap array must be able to hold
+ */
+void ReadyQueue::reserve(int min_capacity) {
+    if (min_capacity <= capacity) {
+        return;
+    }
+    int new_capacity = capacity;
+    while (new_capacity < min_capacity) {
+        new_capacity *= 2;
+    }
+    PCB **bigger = new PCB*[new_capacity];
+    for (int i = 0; i < count; i++) {
+        bigger[i] = heap[i];
+    }
+    delete[] heap;
+    heap = bigger;
+    capacity = new_capacity;
+}
+
+/**
+ * @brief Move the PCB at index i up until its parent has a priority no lower than its own.
+ * @param i: the heap index of the PCB to move up
+ */
+void ReadyQueue::siftUp(int i) {
+    PCB *moving = heap[i];
+    // Shift lower priority parents down instead of swapping at every level
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (heap[parent]->priority >= moving->priority) {
+            break;
+        }
+        heap[i] = heap[parent];
+        heap[i]->heap_index = i;
+        i = parent;
+    }
+    heap[i] = moving;
+    moving->heap_index = i;
+}
+
+/**
+ * @brief Move the PCB at index i down until neither child has a higher priority.
+ * @param i: the heap index of the PCB to move down
+ */
+void ReadyQueue::siftDown(int i) {
+    PCB *moving = heap[i];
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= count) {
+            break;
+        }
+        // Pick the higher priority child
+        if (child + 1 < count && heap[child + 1]->priority > heap[child]->priority) {
+            child++;
+        }
+        if (heap[child]->priority <= moving->priority) {
+            break;
+        }
+        heap[i] = heap[child];
+        heap[i]->heap_index = i;
+        i = child;
+    }
+    heap[i] = moving;
+    moving->heap_index = i;
 }
 
 /**
@@ -27,8 +99,16 @@ ReadyQueue::~ReadyQueue() {
  * @param pcbPtr: the pointer to the PCB to be added
  */
 void ReadyQueue::addPCB(PCB *pcbPtr) {
-    //TODO: add your code here
     // When adding a PCB to the queue, you must change its state to READY.
+    pcbPtr->setState(ProcState::READY);
+    // A PCB already in the queue is not added twice
+    if (contains(pcbPtr)) {
+        return;
+    }
+    reserve(count + 1);
+    heap[count] = pcbPtr;
+    siftUp(count);
+    count++;
 }
 
 /**
@@ -37,8 +117,65 @@ void ReadyQueue::addPCB(PCB *pcbPtr) {
  * @return PCB*: the pointer to the PCB with the highest priority
  */
 PCB* ReadyQueue::removePCB() {
-    //TODO: add your code here
+    if (count == 0) {
+        return nullptr;
+    }
+    PCB *top = heap[0];
+    // Move the last PCB to the root and restore the heap order
+    count--;
+    if (count > 0) {
+        heap[0] = heap[count];
+        siftDown(0);
+    }
+    top->heap_index = -1;
     // When removing a PCB from the queue, you must change its state to RUNNING.
+    top->setState(ProcState::RUNNING);
+    return top;
+}
+
+/**
+ * @brief Remove a specific PCB from the queue in O(log n), e.g. when the process is blocked or killed.
+ * The state of the removed PCB is left for the caller to set.
+ *
+ * @param pcbPtr: the pointer to the PCB to be removed
+ * @return true if the PCB was in the queue and has been removed, false otherwise
+ */
+bool ReadyQueue::removePCB(PCB *pcbPtr) {
+    if (pcbPtr == nullptr || !contains(pcbPtr)) {
+        return false;
+    }
+    int i = pcbPtr->heap_index;
+    count--;
+    // Fill the hole with the last PCB, which may have to move either up or down
+    if (i < count) {
+        PCB *moved = heap[count];
+        heap[i] = moved;
+        siftUp(i);
+        siftDown(moved->heap_index);
+    }
+    pcbPtr->heap_index = -1;
+    return true;
+}
+
+/**
+ * @brief Change the priority of a PCB, restoring the heap order in O(log n) if the PCB is queued.
+ * If the PCB is not in the queue, only its priority is changed.
+ *
+ * @param pcbPtr: the pointer to the PCB to reprioritise
+ * @param priority: the new priority of the PCB
+ */
+void ReadyQueue::updatePriority(PCB *pcbPtr, unsigned int priority) {
+    unsigned int old_priority = pcbPtr->getPriority();
+    pcbPtr->setPriority(priority);
+    if (!contains(pcbPtr)) {
+        return;
+    }
+    // A raised priority can only move the PCB up, a lowered one only down
+    if (priority > old_priority) {
+        siftUp(pcbPtr->heap_index);
+    } else if (priority < old_priority) {
+        siftDown(pcbPtr->heap_index);
+    }
 }
 
 /**
@@ -47,12 +184,86 @@ PCB* ReadyQueue::removePCB() {
  * @return int: the number of PCBs in the queue
  */
 int ReadyQueue::size() {
-    //TODO: add your code here
+    return count;
 }
 
 /**
  * @brief Display the PCBs in the queue.
  */
 void ReadyQueue::displayAll() {
-    //TODO: add your code here
-}
\ No newline at end of file
+    cout << "Display Processes in ReadyQueue:" << endl;
+    for (int i = 0; i < count; i++) {
+        cout << "\t";
+        heap[i]->display();
+    }
+}
+
+/**
+ * @brief Add a batch of PCBs into the ready queue.
+ * A large batch is appended and the whole heap is rebuilt bottom-up (Floyd's method) in O(size + n)
+ * instead of sifting up every PCB in O(n log size). PCBs already in the queue are skipped.
+ *
+ * @param pcbs: array of pointers to the PCBs to be added
+ * @param n: the number of PCBs in the array
+ */
+void ReadyQueue::addBatch(PCB **pcbs, int n) {
+    if (pcbs == nullptr || n <= 0) {
+        return;
+    }
+    reserve(count + n);
+    int old_count = count;
+    // Append the batch without restoring the heap order yet
+    for (int i = 0; i < n; i++) {
+        PCB *pcb = pcbs[i];
+        // When adding a PCB to the queue, you must change its state to READY.
+        pcb->setState(ProcState::READY);
+        if (contains(pcb)) {
+            continue;
+        }
+        heap[count] = pcb;
+        pcb->heap_index = count;
+        count++;
+    }
+    int added = count - old_count;
+    // Sifting up costs about log2(count) steps per added PCB; rebuilding costs about 2 steps per PCB
+    int depth = 0;
+    for (int c = count; c > 1; c >>= 1) {
+        depth++;
+    }
+    if ((long long)added * depth > 2LL * count) {
+        for (int i = count / 2 - 1; i >= 0; i--) {
+            siftDown(i);
+        }
+    } else {
+        for (int i = old_count; i < count; i++) {
+            siftUp(i);
+        }
+    }
+}
+
+/**
+ * @brief Remove the k PCBs with the highest priorities from the queue.
+ * They are stored in out in decreasing order of priority, and their state is changed to RUNNING.
+ *
+ * @param k: the number of PCBs to remove
+ * @param out: array of at least k slots that receives the removed PCBs
+ * @return int: the number of PCBs removed, which is less than k if the queue runs out
+ */
+int ReadyQueue::removeTop(int k, PCB **out) {
+    if (out == nullptr || k <= 0) {
+        return 0;
+    }
+    int removed = k < count ? k : count;
+    for (int i = 0; i < removed; i++) {
+        PCB *top = heap[0];
+        count--;
+        if (count > 0) {
+            heap[0] = heap[count];
+            siftDown(0);
+        }
+        top->heap_index = -1;
+        top->setState(ProcState::RUNNING);
+        out[i] = top;
+    }
+    return removed;
+}
@@ -18,8 +18,41 @@
  */
 class ReadyQueue {
 private:
-    // TODO: add your private member variables here
-    // choose a data structure for the ReadyQueue. No STL class is allowed.
+    // The queue is a binary max-heap of PCB pointers stored in a dynamically allocated array.
+    // The PCB with the highest priority is at heap[0]; the children of heap[i] are heap[2i+1] and heap[2i+2].
+    // The heap is indexed: every queued PCB records its slot in PCB::heap_index.
+    PCB **heap;
+    // Number of PCBs currently in the queue
+    int count;
+    // Number of slots allocated for the heap array
+    int capacity;
+
+    /**
+     * @brief Grow the heap array, doubling its capacity until it holds at least min_capacity PCBs.
+     * @param min_capacity: the number of PCBs the heap array must be able to hold
+     */
+    void reserve(int min_capacity);
+
+    /**
+     * @brief Move the PCB at index i up until its parent has a priority no lower than its own.
+     * @param i: the heap index of the PCB to move up
+     */
+    void siftUp(int i);
+
+    /**
+     * @brief Move the PCB at index i down until neither child has a higher priority.
+     * @param i: the heap index of the PCB to move down
+     */
+    void siftDown(int i);
+
+    /**
+     * @brief Check whether a PCB is currently stored in this queue.
+     * @param pcbPtr: the pointer to the PCB
+     * @return true if the PCB is in the queue, false otherwise
+     */
+    bool contains(PCB *pcbPtr) {
+        return pcbPtr->heap_index >= 0 && pcbPtr->heap_index < count && heap[pcbPtr->heap_index] == pcbPtr;
+    }
 
 public:
     /**
@@ -61,4 +94,42 @@ public:
       */
 	void displayAll();
 
+    /**
+     * @brief Change the priority of a PCB, restoring the heap order in O(log n) if the PCB is queued.
+     * If the PCB is not in the queue, only its priority is changed.
+     *
+     * @param pcbPtr: the pointer to the PCB to reprioritise
+     * @param priority: the new priority of the PCB
+     */
+    void updatePriority(PCB* pcbPtr, unsigned int priority);
+
+    /**
+     * @brief Remove a specific PCB from the queue in O(log n), e.g. when the process is blocked or killed.
+     * The state of the removed PCB is left for the caller to set.
+     *
+     * @param pcbPtr: the pointer to the PCB to be removed
+     * @return true if the PCB was in the queue and has been removed, false otherwise
+     */
+    bool removePCB(PCB* pcbPtr);
+
+    /**
+     * @brief Add a batch of PCBs into the ready queue.
+     * A large batch is appended and the whole heap is rebuilt bottom-up (Floyd's method) in O(size + n)
+     * instead of sifting up every PCB in O(n log size). PCBs already in the queue are skipped.
+     *
+     * @param pcbs: array of pointers to the PCBs to be added
+     * @param n: the number of PCBs in the array
+     */
+    void addBatch(PCB** pcbs, int n);
+
+    /**
+     * @brief Remove the k PCBs with the highest priorities from the queue.
+     * They are stored in out in decreasing order of priority, and their state is changed to RUNNING.
+     *
+     * @param k: the number of PCBs to remove
+     * @param out: array of at least k slots that receives the removed PCBs
+     * @return int: the number of PCBs removed, which is less than k if the queue runs out
+     */
+    int removeTop(int k, PCB** out);
+
 };
\ No newline at end of file
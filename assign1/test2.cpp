@@ -10,44 +10,55 @@
 #include <iostream>
 #include <random>
 #include "readyqueue.h"
+#include "bucketreadyqueue.h"
 #include "pcbtable.h"
 
 using namespace std;
 
-int main(int argc, char *argv[]) {
-    std::cout << "CS 433 Programming assignment 1" << std::endl;
-    std::cout << "Course: CS433 (Operating Systems)" << std::endl;
-    std::cout << "Description : Program to implement a priority ready queue of processes" << std::endl;
-    std::cout << "************Performing Test 2********************" << std::endl;
-    std::cout << "=================================" << std::endl;
-
+/**
+ * @brief Run the random add/remove test against a ready queue.
+ * The random sequence is re-seeded on every call, so each queue implementation sees the same workload.
+ * The PCBs are created in the table on the first call and reset to their initial priority and state afterwards.
+ *
+ * @param q: the (empty) ready queue to test
+ * @param table: the PCBTable holding the PCBs
+ * @param size: the number of PCBs in the table
+ * @param remove_count: output, the number of removes performed
+ * @param insert_count: output, the number of inserts performed
+ * @return double: the time taken by the add/remove loop in seconds
+ */
+template <class Queue>
+double runTest(Queue &q, PCBTable &table, int size, int &remove_count, int &insert_count) {
     // random seed. 
     srand(1);
-    int size = 500;
 
-    ReadyQueue q2;    // Ready Queue
-    PCBTable table(size);  // PCBTable of given size
-
-    // Create initial 500 PCBs with random priorities, add them to the PCB table
+    // Create initial PCBs with random priorities, add them to the PCB table
     // Randomly choose to add half of the processes into the ready queue
     for (int i = 0; i < size; i++) {
         int priority = rand() % 50 + 1;
-        PCB *pcbPtr = new PCB(i + 1, priority);
-        table.addPCB(pcbPtr, i);
-        if (rand() % 2 == 0) q2.addPCB(pcbPtr);
+        PCB *pcbPtr = table.getPCB(i);
+        if (pcbPtr == NULL) {
+            // The table creates the PCB in its contiguous arena
+            table.addNewPCB(i + 1, priority, i);
+            pcbPtr = table.getPCB(i);
+        } else {
+            pcbPtr->setPriority(priority);
+            pcbPtr->setState(ProcState::NEW);
+        }
+        if (rand() % 2 == 0) q.addPCB(pcbPtr);
     }
-    cout << "Initial ReadyQueue size = " << q2.size() << endl;
-    //q2.display();
+    cout << "Initial ReadyQueue size = " << q.size() << endl;
+    //q.display();
     auto t1 = std::chrono::high_resolution_clock::now();
     int idx = 0;
-    int remove_count = 0;
-    int insert_count = 0;
+    remove_count = 0;
+    insert_count = 0;
     for (int i = 0; i < 1000000; i++) {
         int x = rand();
         if (x % 2 == 0) {
             // Remove a proc from ReadyQueue
-            if (q2.size() > 0) {
-                q2.removePCB();
+            if (q.size() > 0) {
+                q.removePCB();
                 remove_count ++;
             }
         } else {
@@ -57,15 +68,46 @@ int main(int argc, char *argv[]) {
                 ProcState::READY) { // if the PCB is not in READY state, add it into ReadyQueue
                 int priority = rand() % 50 + 1;  
                 table.getPCB(idx)->setPriority(priority);  // change its priority to a random value
-                q2.addPCB(table.getPCB(idx));
+                q.addPCB(table.getPCB(idx));
                 insert_count ++;
             }
         }
     }
     auto t2 = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> runtime = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-    std::cout << "Time taken: " << runtime.count() << " seconds" << std::endl;
+    return runtime.count();
+}
+
+int main(int argc, char *argv[]) {
+    std::cout << "CS 433 Programming assignment 1" << std::endl;
+    std::cout << "Course: CS433 (Operating Systems)" << std::endl;
+    std::cout << "Description : Program to implement a priority ready queue of processes" << std::endl;
+    std::cout << "************Performing Test 2********************" << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    int size = 500;
+    int remove_count = 0;
+    int insert_count = 0;
+
+    ReadyQueue q2;    // Ready Queue
+    PCBTable table(size);  // PCBTable of given size
+
+    double heap_time = runTest(q2, table, size, remove_count, insert_count);
+    std::cout << "Time taken: " << heap_time << " seconds" << std::endl;
+    cout << "# of PCB allocations = " << table.poolAllocations() << " for " << table.pooledPCBs() << " PCBs" << endl;
     cout << "Final ReadyQueue size = " << q2.size() << endl;
     cout << "# of removes = " << remove_count << ", # of inserts = " << insert_count << endl;
     q2.displayAll();
-}
+
+    // Repeat the same workload with the bucket queue and compare against the binary heap
+    std::cout << "=================================" << std::endl;
+    std::cout << "Repeat Test 2 with BucketReadyQueue" << std::endl;
+    BucketReadyQueue q3;
+    double bucket_time = runTest(q3, table, size, remove_count, insert_count);
+    std::cout << "Time taken: " << bucket_time << " seconds" << std::endl;
+    cout << "Final ReadyQueue size = " << q3.size() << endl;
+    cout << "# of removes = " << remove_count << ", # of inserts = " << insert_count << endl;
+    if (bucket_time > 0) {
+        cout << "Speedup of BucketReadyQueue over binary heap ReadyQueue = " << heap_time / bucket_time << "x" << endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+/**
+ * Assignment 1: priority queue of processes
+ * @file test3.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief This file measures the multi-threaded throughput of the ConcurrentReadyQueue.
+ * It runs the random add/remove workload of test2 on 1, 2, 4 and 8 threads and reports the operations per second,
+ * next to a single BucketReadyQueue protected by one global lock.
+ */
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "concurrentreadyqueue.h"
+#include "bucketreadyqueue.h"
+#include "pcbtable.h"
+
+using namespace std;
+
+// Number of add/remove operations performed by every thread
+const int OPS_PER_THREAD = 1000000;
+// Number of PCBs in the table
+const int TABLE_SIZE = 5000;
+
+/**
+ * @brief A BucketReadyQueue behind one global lock, the baseline the ConcurrentReadyQueue is compared to.
+ */
+class LockedReadyQueue {
+private:
+    // The global lock
+    mutex lock;
+    // The protected queue
+    BucketReadyQueue queue;
+public:
+    // The thread count is unused; it matches the constructor of the ConcurrentReadyQueue
+    LockedReadyQueue(int num_threads = 1) {}
+    void addPCB(PCB *pcbPtr) {
+        lock_guard<mutex> guard(lock);
+        queue.addPCB(pcbPtr);
+    }
+    PCB *removePCB() {
+        lock_guard<mutex> guard(lock);
+        return queue.removePCB();
+    }
+    int size() {
+        lock_guard<mutex> guard(lock);
+        return queue.size();
+    }
+};
+
+/**
+ * @brief The work of one benchmark thread.
+ * Every PCB is either in the queue or owned by exactly one thread, so the threads never race on a PCB:
+ * a remove hands the PCB to the removing thread, and an add gives one of the thread's PCBs back to the queue.
+ *
+ * @param q: the shared ready queue
+ * @param own: the PCBs owned by this thread, used as a stack
+ * @param seed: the seed of the thread's random number generator
+ */
+template <class Queue>
+void worker(Queue &q, vector<PCB *> &own, unsigned int seed) {
+    minstd_rand rng(seed);
+    for (int i = 0; i < OPS_PER_THREAD; i++) {
+        if (rng() % 2 == 0) {
+            // Remove a proc from the ReadyQueue and keep it
+            PCB *pcb = q.removePCB();
+            if (pcb != nullptr) {
+                own.push_back(pcb);
+            }
+        } else if (!own.empty()) {
+            // Give one of the owned PCBs back with a random priority
+            PCB *pcb = own.back();
+            own.pop_back();
+            pcb->setPriority(rng() % 50 + 1);
+            q.addPCB(pcb);
+        }
+    }
+}
+
+/**
+ * @brief Run the workload on a number of threads and report the throughput.
+ *
+ * @param name: the name of the queue printed in the report
+ * @param table: the PCBTable holding the PCBs
+ * @param num_threads: the number of worker threads
+ * @return double: the number of operations per second
+ */
+template <class Queue>
+double runTest(const char *name, PCBTable &table, int num_threads) {
+    Queue q(num_threads);
+    vector<vector<PCB *>> own(num_threads);
+    // Put half of the PCBs in the queue and deal the rest out to the threads
+    minstd_rand rng(1);
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        PCB *pcb = table.getPCB(i);
+        pcb->setPriority(rng() % 50 + 1);
+        pcb->setState(ProcState::NEW);
+        if (rng() % 2 == 0) {
+            q.addPCB(pcb);
+        } else {
+            own[i % num_threads].push_back(pcb);
+        }
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    vector<thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.push_back(thread(worker<Queue>, ref(q), ref(own[t]), t + 1));
+    }
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> runtime = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
+
+    double ops_per_sec = (double)OPS_PER_THREAD * num_threads / runtime.count();
+    cout << name << " with " << num_threads << " thread(s): " << runtime.count() << " seconds, "
+         << ops_per_sec << " ops/sec, final size = " << q.size() << endl;
+    // Drain the queue so the next run starts from a clean table
+    while (q.removePCB() != nullptr) {
+    }
+    return ops_per_sec;
+}
+
+int main(int argc, char *argv[]) {
+    std::cout << "CS 433 Programming assignment 1" << std::endl;
+    std::cout << "Course: CS433 (Operating Systems)" << std::endl;
+    std::cout << "Description : Program to implement a priority ready queue of processes" << std::endl;
+    std::cout << "************Performing Test 3********************" << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    PCBTable table(TABLE_SIZE);
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        table.addNewPCB(i + 1, 1, i);
+    }
+    cout << "Hardware threads: " << thread::hardware_concurrency() << endl;
+
+    const int thread_counts[] = {1, 2, 4, 8};
+    for (int n : thread_counts) {
+        double locked = runTest<LockedReadyQueue>("Global lock queue     ", table, n);
+        double multi = runTest<ConcurrentReadyQueue>("ConcurrentReadyQueue  ", table, n);
+        cout << "Speedup of ConcurrentReadyQueue at " << n << " thread(s) = " << multi / locked << "x" << endl;
+    }
+    return 0;
+}
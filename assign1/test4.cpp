@@ -0,0 +1,153 @@
+/**
+ * Assignment 1: priority queue of processes
+ * @file test4.cpp
+ * @author
+ * @brief This file tests the operations of the ReadyQueue beyond the basic interface: changing the priority of a
+ *        queued PCB, removing a PCB from the middle of the queue, and adding and removing PCBs in batches
+ */
+
+#include <iostream>
+#include "readyqueue.h"
+#include "pcbtable.h"
+
+using namespace std;
+
+/**
+ * @brief Drain a queue, displaying every PCB, and check that they come out in decreasing order of priority.
+ *
+ * @param q: the queue to drain
+ * @param last: receives the last PCB removed, if not NULL
+ * @return true if the priorities never increased
+ */
+bool drainInOrder(ReadyQueue &q, PCB** last = NULL) {
+    bool ordered = true;
+    unsigned int previous = MAX_PRIORITY;
+    while (q.size() > 0) {
+        PCB* p = q.removePCB();
+        p->display();
+        if (p->getPriority() > previous) {
+            ordered = false;
+        }
+        previous = p->getPriority();
+        if (last != NULL) {
+            *last = p;
+        }
+    }
+    return ordered;
+}
+
+/**
+ * @brief Print the result of a check, and remember a failure.
+ *
+ * @param what: what was checked
+ * @param ok: whether the check passed
+ * @param failures: incremented if the check failed
+ */
+void check(const char* what, bool ok, int &failures) {
+    cout << (ok ? "PASS: " : "FAIL: ") << what << endl;
+    if (!ok) {
+        failures++;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "CS 433 Programming assignment 1" << std::endl;
+    std::cout << "Course: CS433 (Operating Systems)" << std::endl;
+    std::cout << "Description : Program to implement a priority ready queue of processes" << std::endl;
+    std::cout << "************Performing Test 4********************" << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    PCBTable table;
+    int failures = 0;
+
+    for (int i = 1; i <= 50; i++) {
+        // Add a new PCB with id = i, priority = i to the table at index i
+        table.addNewPCB(i, i, i);
+    }
+
+    std::cout << "Add processes 10, 20, 30, 40 and 45 to q1. Display the content of q1" << std::endl;
+    ReadyQueue q1;
+    int ids1[] = {10, 20, 30, 40, 45};
+    for (int id : ids1) {
+        q1.addPCB(table.getPCB(id));
+    }
+    q1.displayAll();
+
+    std::cout << "Raise the priority of process 10 to 50 and display q1" << std::endl;
+    q1.updatePriority(table.getPCB(10), 50);
+    q1.displayAll();
+    check("the raised process is removed first", q1.removePCB() == table.getPCB(10), failures);
+
+    std::cout << "Lower the priority of process 45 to 5 and display q1" << std::endl;
+    q1.updatePriority(table.getPCB(45), 5);
+    q1.displayAll();
+    std::cout << "One by one remove the process with the highest priority from the queue q1" << std::endl;
+    PCB* last = NULL;
+    check("the queue stays ordered after the priority changes", drainInOrder(q1, &last), failures);
+    check("the lowered process is removed last", last == table.getPCB(45), failures);
+
+    std::cout << "Add processes 5, 15, 25, 35 and 49 to q2, then remove process 25 from the middle of q2" << std::endl;
+    ReadyQueue q2;
+    int ids2[] = {5, 15, 25, 35, 49};
+    for (int id : ids2) {
+        q2.addPCB(table.getPCB(id));
+    }
+    check("process 25 is found and removed", q2.removePCB(table.getPCB(25)), failures);
+    check("process 25 cannot be removed twice", !q2.removePCB(table.getPCB(25)), failures);
+    check("4 processes are left", q2.size() == 4, failures);
+    q2.displayAll();
+    std::cout << "One by one remove the process with the highest priority from the queue q2" << std::endl;
+    check("the queue stays ordered after the removal", drainInOrder(q2), failures);
+
+    std::cout << "Add processes 7, 12 and 33 to q3, then add processes 14 to 43 to q3 in one batch, in a shuffled "
+                 "order that repeats 33" << std::endl;
+    ReadyQueue q3;
+    q3.addPCB(table.getPCB(7));
+    q3.addPCB(table.getPCB(12));
+    q3.addPCB(table.getPCB(33));
+    PCB* batch[31];
+    for (int i = 0; i < 30; i++) {
+        // 14 + (i * 7) % 30 visits every id from 14 to 43 once, since 7 and 30 are coprime
+        batch[i] = table.getPCB(14 + (i * 7) % 30);
+    }
+    batch[30] = table.getPCB(33);
+    q3.addBatch(batch, 31);
+    check("the batch adds 29 new processes and skips the queued ones", q3.size() == 32, failures);
+    std::cout << "Add processes 2 and 48 to q3 in a small batch" << std::endl;
+    PCB* small[] = {table.getPCB(2), table.getPCB(48)};
+    q3.addBatch(small, 2);
+    check("34 processes are queued", q3.size() == 34, failures);
+
+    std::cout << "Remove the top 5 processes of q3 at once and display them" << std::endl;
+    PCB* top[5];
+    int removed = q3.removeTop(5, top);
+    check("removeTop returns 5 processes", removed == 5, failures);
+    unsigned int expected[] = {48, 43, 42, 41, 40};
+    bool highest = true;
+    for (int i = 0; i < removed; i++) {
+        top[i]->display();
+        highest = highest && top[i]->getPriority() == expected[i] && top[i]->getState() == ProcState::RUNNING;
+    }
+    check("they are the 5 highest, in decreasing order of priority", highest, failures);
+    check("29 processes are left", q3.size() == 29, failures);
+    std::cout << "Remove the top 5 processes of q3 one by one" << std::endl;
+    bool rest = true;
+    unsigned int next_expected[] = {39, 38, 37, 36, 35};
+    for (int i = 0; i < 5; i++) {
+        PCB* p = q3.removePCB();
+        p->display();
+        rest = rest && p->getPriority() == next_expected[i];
+    }
+    check("the rest of the queue is intact and ordered", rest, failures);
+    std::cout << "Remove up to 30 processes from the 24 left in q3" << std::endl;
+    PCB* all[30];
+    removed = q3.removeTop(30, all);
+    bool drained = removed == 24 && q3.size() == 0 && all[0]->getPriority() == 34 && all[23]->getPriority() == 2;
+    for (int i = 1; i < removed; i++) {
+        drained = drained && all[i]->getPriority() < all[i - 1]->getPriority();
+    }
+    check("removeTop stops when the queue runs out, still in order", drained, failures);
+
+    std::cout << (failures == 0 ? "All checks passed" : "Some checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
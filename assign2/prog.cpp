@@ -14,231 +14,708 @@
 #include <cstring>
 #include <sys/wait.h>
 #include <vector>
+#include <errno.h>
+#include <spawn.h>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <sys/stat.h>
+#include <map>
+#include <signal.h>
 
 using namespace std;
 
-#define MAX_LINE 80 // Maximum command length
+//environment passed to spawned commands
+extern char **environ;
 
-//history to store executed commands
-vector<string> history;
+//number of commands kept in the history, older ones are overwritten so memory stays fixed over long scripts
+const size_t HISTORY_SIZE = 1000;
+//history to store the most recent executed commands, a ring of HISTORY_SIZE entries
+vector<string> history(HISTORY_SIZE);
+//number of commands ever entered, the newest is at history[(history_total - 1) % HISTORY_SIZE]
+size_t history_total = 0;
 
-//function to parse command and arguments
-int ParseCommand(char command[], char *args[]){
-    int i = 0;
+//size of each read of the command input
+const size_t READ_CHUNK = 64 * 1024;
+//reads lines of any length from a file descriptor, a large chunk at a time
+struct LineReader {
+    int fd;                 //where the commands come from
+    vector<char> buffer;    //the last chunk read
+    size_t start;           //first byte of the chunk not yet returned
+    size_t end;             //one past the last byte of the chunk
+};
+
+//how commands are started: posix_spawn avoids copying the shell's page tables, fork+exec is the classic path
+enum LaunchMode { LAUNCH_SPAWN, LAUNCH_FORK };
+LaunchMode launch_mode = LAUNCH_SPAWN;
+
+//cache of the full paths of commands found in PATH, so a command is only searched for once
+struct CachedPath {
+    string path;    //where the command was found
+    int hits;       //how many times it was looked up
+};
+unordered_map<string, CachedPath> path_cache;
+//the PATH the cache was built from
+string cached_path_env;
+
+//one process of a job, as last reported by waitpid
+struct JobProcess {
+    pid_t pid;
+    bool done;      //exited or killed, and reaped
+    bool stopped;   //stopped by a signal such as Ctrl-Z
+};
+enum JobState { JOB_RUNNING, JOB_STOPPED, JOB_DONE };
+//a command line the shell launched: a single command or a whole pipeline
+struct Job {
+    int id;                         //the number shown by jobs and taken by fg and bg
+    pid_t pgid;                     //the job's process group, 0 when job control is off and it shares the shell's
+    string command;                 //the command line as entered
+    vector<JobProcess> processes;   //one per stage
+};
+//the job table, by job number, holding every job that has not finished or has not been reported yet
+map<int, Job> jobs;
+//set by the SIGCHLD handler, so the shell only calls waitpid when a child has changed state
+volatile sig_atomic_t child_changed = 0;
+//true when the shell reads from a terminal: each job gets its own process group and the terminal while in the foreground
+bool job_control = false;
+//the shell's own process group, given the terminal back when a foreground job finishes or stops
+pid_t shell_pgid = 0;
+//the signals an interactive shell ignores, set back to their defaults in every command it launches
+sigset_t job_signals;
+
+//function to parse command and arguments, as many as the line holds
+int ParseCommand(char command[], vector<char*>& args){
+    args.clear();
     //splits command into tokens
-    char *token = strtok(command, " \n"); 
+    char *token = strtok(command, " \t\n"); 
     while(token != nullptr){
     //stores the token in args
-        args[i++] = token; 
-        token = strtok(nullptr, " \n");
+        args.push_back(token); 
+        token = strtok(nullptr, " \t\n");
     }
     //null terminates args
-    args[i] = nullptr; 
+    args.push_back(nullptr); 
     //returns the number of arguments
-    return i; 
+    return args.size() - 1; 
+}
+//function to add a command to the history, overwriting the oldest one once the ring is full
+void AddHistory(const string& line){
+    //assign reuses the old entry's storage, so a full ring stops allocating
+    history[history_total % HISTORY_SIZE].assign(line);
+    history_total++;
+}
+//function to get a command from the history, 1 being the most recent; back must not exceed the number kept
+const string& RecentHistory(size_t back){
+    return history[(history_total - back) % HISTORY_SIZE];
+}
+//function to read the next line, without its newline, into line
+//returns false at the end of the input
+bool ReadLine(LineReader& reader, string& line){
+    line.clear();
+    while(true){
+        //returns the line if its newline is already in the chunk
+        const char *begin = reader.buffer.data() + reader.start;
+        const char *newline = (const char*)memchr(begin, '\n', reader.end - reader.start);
+        if(newline != nullptr){
+            line.append(begin, newline - begin);
+            reader.start = newline - reader.buffer.data() + 1;
+            return true;
+        }
+        //keeps the start of the line and reads the next chunk
+        line.append(begin, reader.end - reader.start);
+        ssize_t n = read(reader.fd, reader.buffer.data(), reader.buffer.size());
+        if(n < 0 && errno == EINTR) continue;
+        reader.start = 0;
+        reader.end = n > 0 ? n : 0;
+        //a last line without a newline is still returned
+        if(n <= 0) return !line.empty();
+    }
+}
+//function to find a command in PATH, the way execvp would, remembering the answer
+//names with a '/' are used as they are. the cache is cleared whenever PATH has changed since the last lookup.
+//returns the full path of the command, or an empty string if it is not found
+string ResolveCommand(const char *name){
+    if(strchr(name, '/') != nullptr) return name;
+    const char *path_env = getenv("PATH");
+    //uses the same default as execvp when PATH is unset
+    string path = path_env != nullptr ? path_env : "/bin:/usr/bin";
+    if(path != cached_path_env){
+        path_cache.clear();
+        cached_path_env = path;
+    }
+    unordered_map<string, CachedPath>::iterator found = path_cache.find(name);
+    if(found != path_cache.end()){
+        found->second.hits++;
+        return found->second.path;
+    }
+    //walks the directories of PATH in order, an empty entry meaning the current directory
+    size_t start = 0;
+    while(start <= path.size()){
+        size_t end = path.find(':', start);
+        if(end == string::npos) end = path.size();
+        string candidate = end > start ? path.substr(start, end - start) + "/" + name : string("./") + name;
+        struct stat info;
+        if(stat(candidate.c_str(), &info) == 0 && S_ISREG(info.st_mode) && access(candidate.c_str(), X_OK) == 0){
+            path_cache[name] = CachedPath{candidate, 1};
+            return candidate;
+        }
+        start = end + 1;
+    }
+    return "";
 }
-//function to execute a command
-void ExecuteCommand(char *args[], bool background){
+//function to forget the cached path of a command, after exec found nothing there
+void ForgetCommand(const char *name){
+    path_cache.erase(name);
+}
+//function for the hash builtin: "hash" lists the cached paths, "hash -r" clears them
+void HashBuiltin(char *args[], int num_args){
+    if(num_args > 1 && strcmp(args[1], "-r") == 0){
+        path_cache.clear();
+        return;
+    }
+    if(num_args > 1){
+        cerr << "Usage: hash [-r]" << endl;
+        return;
+    }
+    if(path_cache.empty()){
+        cout << "hash: hash table empty" << endl;
+        return;
+    }
+    cout << "hits\tcommand" << endl;
+    for(unordered_map<string, CachedPath>::iterator it = path_cache.begin(); it != path_cache.end(); ++it){
+        cout << it->second.hits << "\t" << it->second.path << endl;
+    }
+}
+//function called on SIGCHLD, only recording that a child changed state; the shell reaps it between commands
+void OnChildChanged(int){
+    child_changed = 1;
+}
+//function to record a change of state reported by waitpid for one process of a job
+void UpdateProcess(JobProcess& process, int status){
+    if(WIFSTOPPED(status)) process.stopped = true;
+    else if(WIFCONTINUED(status)) process.stopped = false;
+    else process.done = true;
+}
+//function to get the state of a job from the states of its processes
+JobState StateOf(const Job& job){
+    JobState state = JOB_DONE;
+    for(size_t i = 0; i < job.processes.size(); i++){
+        if(job.processes[i].done) continue;
+        if(job.processes[i].stopped) return JOB_STOPPED;
+        state = JOB_RUNNING;
+    }
+    return state;
+}
+//function to print a job the way the jobs builtin lists it
+void PrintJob(const Job& job){
+    const char *names[] = {"Running", "Stopped", "Done"};
+    cout << "[" << job.id << "]  " << names[StateOf(job)] << "\t" << job.command << endl;
+}
+//function to collect every child that has exited, stopped or continued, without blocking
+//done background jobs are reported when the shell is interactive, and removed from the table
+void ReapChildren(){
+    int status;
+    pid_t pid;
+    while((pid = waitpid(-1, &status, WNOHANG | WUNTRACED | WCONTINUED)) > 0){
+        for(map<int, Job>::iterator it = jobs.begin(); it != jobs.end(); ++it){
+            vector<JobProcess>& processes = it->second.processes;
+            for(size_t i = 0; i < processes.size(); i++){
+                if(processes[i].pid == pid) UpdateProcess(processes[i], status);
+            }
+        }
+    }
+    for(map<int, Job>::iterator it = jobs.begin(); it != jobs.end();){
+        if(StateOf(it->second) != JOB_DONE){
+            ++it;
+            continue;
+        }
+        if(job_control) PrintJob(it->second);
+        jobs.erase(it++);
+    }
+}
+//function to wait for a job in the foreground, waiting on each of its processes by pid
+//the terminal is given to the job while it runs. a job that stops stays in the table, a finished one is removed.
+void WaitForJob(Job& job){
+    if(job_control) tcsetpgrp(STDIN_FILENO, job.pgid);
+    for(size_t i = 0; i < job.processes.size(); i++){
+        JobProcess& process = job.processes[i];
+        while(!process.done && !process.stopped){
+            int status;
+            if(waitpid(process.pid, &status, WUNTRACED) == process.pid) UpdateProcess(process, status);
+            //the process is gone, collected elsewhere
+            else if(errno != EINTR) process.done = true;
+        }
+        //Ctrl-Z stops the whole job, so there is no need to wait for the rest
+        if(process.stopped) break;
+    }
+    if(job_control) tcsetpgrp(STDIN_FILENO, shell_pgid);
+    if(StateOf(job) == JOB_STOPPED){
+        cout << endl;
+        PrintJob(job);
+    }else{
+        jobs.erase(job.id);
+    }
+}
+//function to add the processes just launched for a command to the job table, then wait for them unless in the background
+void RunJob(const vector<pid_t>& pids, const string& command, bool background){
+    if(pids.empty()) return;
+    int id = jobs.empty() ? 1 : jobs.rbegin()->first + 1;
+    Job& job = jobs[id];
+    job.id = id;
+    job.pgid = job_control ? pids[0] : 0;
+    job.command = command;
+    for(size_t i = 0; i < pids.size(); i++){
+        job.processes.push_back(JobProcess{pids[i], false, false});
+    }
+    if(!background){
+        WaitForJob(job);
+    }else if(job_control){
+        //reports the job number and the last process, as other shells do
+        cout << "[" << id << "] " << pids.back() << endl;
+    }
+}
+//function to send SIGCONT to every process of a job, to the process group when there is one
+void ContinueJob(Job& job){
+    for(size_t i = 0; i < job.processes.size(); i++){
+        job.processes[i].stopped = false;
+    }
+    if(job.pgid > 0){
+        kill(-job.pgid, SIGCONT);
+        return;
+    }
+    for(size_t i = 0; i < job.processes.size(); i++){
+        if(!job.processes[i].done) kill(job.processes[i].pid, SIGCONT);
+    }
+}
+//function to find the job named by a builtin's argument, "%n" or "n", or the most recent job when there is none
+//returns nullptr, after printing why, if there is no such job
+Job* FindJob(char *args[], int num_args){
+    map<int, Job>::iterator it;
+    if(num_args < 2){
+        it = jobs.empty() ? jobs.end() : --jobs.end();
+    }else{
+        const char *spec = args[1][0] == '%' ? args[1] + 1 : args[1];
+        it = jobs.find(atoi(spec));
+    }
+    if(it == jobs.end()){
+        cerr << args[0] << ": no such job" << endl;
+        return nullptr;
+    }
+    return &it->second;
+}
+//function for the jobs builtin: lists the jobs that are running or stopped
+void JobsBuiltin(){
+    ReapChildren();
+    for(map<int, Job>::iterator it = jobs.begin(); it != jobs.end(); ++it){
+        PrintJob(it->second);
+    }
+}
+//function for the fg builtin: continues a job in the foreground and waits for it
+void ForegroundBuiltin(char *args[], int num_args){
+    Job *job = FindJob(args, num_args);
+    if(job == nullptr) return;
+    cout << job->command << endl;
+    //gives the job the terminal before it continues, so it does not stop again reading from it
+    if(job_control) tcsetpgrp(STDIN_FILENO, job->pgid);
+    ContinueJob(*job);
+    WaitForJob(*job);
+}
+//function for the bg builtin: continues a stopped job in the background
+void BackgroundBuiltin(char *args[], int num_args){
+    Job *job = FindJob(args, num_args);
+    if(job == nullptr) return;
+    ContinueJob(*job);
+    cout << "[" << job->id << "] " << job->command << endl;
+}
+//function to find the input/output redirection of a command, ending args before each operator
+//in_file and out_file are left as they are when the command does not redirect that side
+//returns false if an operator has no file name
+bool ParseRedirection(char *args[], int num_args, const char **in_file, const char **out_file){
+    for(int i = 0; i < num_args; i++){
+        bool is_output = strcmp(args[i], ">") == 0;
+        if(!is_output && strcmp(args[i], "<") != 0) continue;
+        //terminates args before redirection
+        args[i] = nullptr; 
+        if(i + 1 >= num_args){
+            cerr << "Missing file name for " << (is_output ? "output" : "input") << " redirection" << endl;
+            return false;
+        }
+        //records the file and skips its name, so the other operator may follow
+        if(is_output) *out_file = args[i + 1];
+        else *in_file = args[i + 1];
+        i++; 
+    }
+    return true;
+}
+//function to handle input/output redirection, called in a forked child before exec so the shell keeps its own stdin and stdout
+//returns false if a file cannot be opened
+bool HandleRedirection(const char *in_file, const char *out_file){
+    if(out_file != nullptr){
+        //open file for writing
+        int fd = open(out_file, O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
+        if(fd < 0){
+            //handles file open error
+            perror("Error opening file for output redirection"); 
+            return false;
+        }
+        //redirect stdout to file
+        dup2(fd, STDOUT_FILENO); 
+        close(fd);
+    }
+    if(in_file != nullptr){
+        //open file for reading
+        int fd = open(in_file, O_RDONLY);
+        if (fd < 0) {
+            //handles file open error
+            perror("Error opening file for input redirection"); 
+            return false;
+        }
+        //redirect stdin to file
+        dup2(fd, STDIN_FILENO); 
+        close(fd);
+    }
+    return true;
+}
+//function to launch one command without waiting for it
+//in_fd and out_fd replace its stdin and stdout unless they are -1, and the file redirection of the command comes after them.
+//pipe_fds are pipe ends closed in the child. group is the process group to join: 0 starts a new one and -1 stays in the shell's.
+//a foreground command under job control takes the terminal itself, before exec, so it cannot read from it too early.
+//returns the pid of the child, or -1 if it could not be started
+pid_t LaunchCommand(char *args[], int num_args, int in_fd, int out_fd, const vector<int>& pipe_fds, pid_t group, bool foreground){
+    bool take_terminal = job_control && foreground && group != -1;
+    const char *in_file = nullptr;
+    const char *out_file = nullptr;
+    if(!ParseRedirection(args, num_args, &in_file, &out_file)) return -1;
+    //writes out what the shell printed so far, so it comes before the command's output when stdout is not a terminal
+    fflush(stdout);
+    //finds the command once, in the shell, so neither path searches PATH on every launch
+    string path = ResolveCommand(args[0]);
+    if(path.empty()){
+        cerr << args[0] << ": command not found" << endl;
+        return -1;
+    }
+
+    if(launch_mode == LAUNCH_SPAWN){
+        //the child is created without copying the shell's page tables, and runs these actions in order before exec
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        if(in_fd != -1) posix_spawn_file_actions_adddup2(&actions, in_fd, STDIN_FILENO);
+        if(out_fd != -1) posix_spawn_file_actions_adddup2(&actions, out_fd, STDOUT_FILENO);
+        for(size_t j = 0; j < pipe_fds.size(); j++) posix_spawn_file_actions_addclose(&actions, pipe_fds[j]);
+        if(out_file != nullptr) posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, out_file, O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
+        if(in_file != nullptr) posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, in_file, O_RDONLY, 0);
+        if(take_terminal) posix_spawn_file_actions_addtcsetpgrp_np(&actions, STDIN_FILENO);
+        posix_spawnattr_t attr;
+        posix_spawnattr_init(&attr);
+        short flags = 0;
+        if(group != -1){
+            flags |= POSIX_SPAWN_SETPGROUP;
+            posix_spawnattr_setpgroup(&attr, group);
+        }
+        if(job_control){
+            //restores the signals the interactive shell ignores, which exec would otherwise leave ignored
+            flags |= POSIX_SPAWN_SETSIGDEF;
+            posix_spawnattr_setsigdefault(&attr, &job_signals);
+        }
+        posix_spawnattr_setflags(&attr, flags);
+        pid_t pid;
+        int err = posix_spawn(&pid, path.c_str(), &actions, &attr, args, environ);
+        if(err == ENOENT && access(path.c_str(), F_OK) != 0){
+            //the command moved since it was cached, so searches PATH again and retries once
+            ForgetCommand(args[0]);
+            path = ResolveCommand(args[0]);
+            if(!path.empty()) err = posix_spawn(&pid, path.c_str(), &actions, &attr, args, environ);
+        }
+        posix_spawn_file_actions_destroy(&actions);
+        posix_spawnattr_destroy(&attr);
+        if(err != 0){
+            //handles a failed redirection or exec, reported by posix_spawn to the shell
+            cerr << args[0] << ": " << strerror(err) << endl;
+            return -1;
+        }
+        return pid;
+    }
+
     //creates a new child process
     pid_t pid = fork(); 
     if(pid < 0){
         //handles fork error
         perror("Fork failed"); 
-        return;
+        return -1;
     }
     if(pid == 0){
+        //child process
+        if(group != -1) setpgid(0, group);
+        if(take_terminal) tcsetpgrp(STDIN_FILENO, getpgrp());
+        if(job_control){
+            //restores the signals the interactive shell ignores, which exec would otherwise leave ignored
+            for(int sig = 1; sig < NSIG; sig++){
+                if(sigismember(&job_signals, sig) == 1) signal(sig, SIG_DFL);
+            }
+        }
+        //reads from the previous stage and writes to the next one
+        if(in_fd != -1) dup2(in_fd, STDIN_FILENO);
+        if(out_fd != -1) dup2(out_fd, STDOUT_FILENO);
+        //closes every pipe end after redirecting, so each reader sees end of file once its writer exits
+        for(size_t j = 0; j < pipe_fds.size(); j++) close(pipe_fds[j]);
+        //redirects the child's input or output if asked
+        if(!HandleRedirection(in_file, out_file)) exit(1);
         //executes command in child process
-        execvp(args[0], args); 
+        execv(path.c_str(), args); 
+        //the cached path may be stale, a search of PATH still finds the command if it moved
+        if(errno == ENOENT) execvp(args[0], args);
         //handles  execvp failure
         perror("Command not found"); 
          //exits child process on failure
         exit(1); 
-    }else{
-        //now in parent process, waits for child if not running in the background
-        if(!background) wait(nullptr); 
     }
+    //sets the group in the parent as well, so it is in place whichever of parent and child runs first
+    if(group != -1) setpgid(pid, group == 0 ? pid : group);
+    return pid;
 }
-//function to execute commands with pipes
-void ExecuteWithPipes(char *args[], int pipeIndex){
-    //file descriptors for pipe
-    int pipefd[2]; 
-    if(pipe(pipefd) == -1){
-        //handles pipe errors
-        perror("Pipe failed"); 
-        return;
-    }
-
-    //forks first child
-    pid_t pid1 = fork(); 
-    if(pid1 == -1){
-        perror("Fork failed");
-        return;
+//function to execute a command as a job of its own
+void ExecuteCommand(char *args[], int num_args, bool background, const string& command){
+    pid_t pid = LaunchCommand(args, num_args, -1, -1, vector<int>(), job_control ? 0 : -1, !background);
+    //waits for this child if not running in the background
+    if(pid > 0) RunJob(vector<pid_t>(1, pid), command, background); 
+}
+//function to execute a pipeline of any number of commands separated by '|'
+//every stage is launched up front and connected to the next one by a pipe, so the whole pipeline runs concurrently.
+//the first stage may redirect its input and the last stage its output.
+void ExecuteWithPipes(char *args[], int num_args, bool background, const string& command){
+    //splits args into stages, each '|' ends the stage before it
+    vector<char**> stages;
+    vector<int> stage_args;
+    stages.push_back(args);
+    int start = 0;
+    for(int i = 0; i < num_args; i++){
+        if(strcmp(args[i], "|") == 0){
+            //ends the stage before the pipe
+            args[i] = nullptr;
+            stage_args.push_back(i - start);
+            start = i + 1;
+            stages.push_back(&args[start]);
+        }
     }
-
-    if(pid1 == 0){
-        //first child process
-        //ends the first command before the pipe
-        args[pipeIndex] = nullptr;
-        //redirects stdout to pipe write end
-        dup2(pipefd[1], STDOUT_FILENO);
-        //close unused read end
-        close(pipefd[0]);
-        //close write end after redirecting
-        close(pipefd[1]); 
-        //execute first command
-        execvp(args[0], args); 
-        //handles exec failure
-        perror("Command not found"); 
-        exit(1);
+    stage_args.push_back(num_args - start);
+    int num_stages = stages.size();
+    for(int i = 0; i < num_stages; i++){
+        if(stage_args[i] == 0){
+            //handles an empty stage, as in "ls | | wc" or a trailing '|'
+            cerr << "Missing command in pipeline" << endl;
+            return;
+        }
     }
 
-    //forks second child 
-    pid_t pid2 = fork(); 
-    if(pid2 == -1){
-        perror("Fork failed");
-        return;
+    //creates the N-1 pipes before launching, pipes[2i] is read by stage i + 1 and pipes[2i + 1] written by stage i
+    vector<int> pipes(2 * (num_stages - 1));
+    for(int i = 0; i < num_stages - 1; i++){
+        if(pipe(&pipes[2 * i]) == -1){
+            //handles pipe errors, closing the pipes already created
+            perror("Pipe failed"); 
+            for(int j = 0; j < 2 * i; j++) close(pipes[j]);
+            return;
+        }
     }
 
-    if(pid2 == 0){
-        //second child process
-        //redirects stdin to pipe read end
-        dup2(pipefd[0], STDIN_FILENO); 
-        //close unsued write end
-        close(pipefd[1]); 
-        //close read end after redirecting
-        close(pipefd[0]); 
-        //executes second command
-        execvp(args[pipeIndex + 1], &args[pipeIndex + 1]);
-        //handles exec failure
-        perror("Command not found"); 
-        exit(1);
+    //launches every stage, under job control into one process group led by the first stage, so signals reach the whole job
+    pid_t group = job_control ? 0 : -1;
+    vector<pid_t> pids;
+    for(int i = 0; i < num_stages; i++){
+        int in_fd = i > 0 ? pipes[2 * (i - 1)] : -1;
+        int out_fd = i < num_stages - 1 ? pipes[2 * i + 1] : -1;
+        pid_t pid = LaunchCommand(stages[i], stage_args[i], in_fd, out_fd, pipes, group, !background);
+        if(pid == -1) break;
+        if(group == 0) group = pid;
+        pids.push_back(pid);
     }
 
     //parent process
-    //close pipe ends in parent
-    close(pipefd[0]); 
-    close(pipefd[1]);
-    //waits for first child to finish
-    waitpid(pid1, nullptr, 0); 
-    //waits for second child to finish
-    waitpid(pid2, nullptr, 0); 
-}
-//function to handle input/output redirection
-void HandleRedirection(char *args[], int num_args){
-    for(int i = 0; i < num_args; i++){
-        //output redirection
-        if(strcmp(args[i], ">") == 0){
-            //terminates args before redirection
-            args[i] = nullptr; 
-            //open file for writing
-            int fd = open(args[i + 1], O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
-            if(fd < 0){
-                //handles file open error
-                perror("Error opening file for output redirection"); 
-                return;
-            }
-            //redirect stdout to file
-            dup2(fd, STDOUT_FILENO); 
-            close(fd);
-            //break after redirection
-            break; 
-        }
-        //input redirection
-        else if(strcmp(args[i], "<") == 0){
-            //terminate args before redirection
-            args[i] = nullptr; 
-            //open file for reading
-            int fd = open(args[i + 1], O_RDONLY);
-            if (fd < 0) {
-                //handles file open error
-                perror("Error opening file for input redirection"); 
-                return;
-            }
-            //redirect stdin to file
-            dup2(fd, STDIN_FILENO); 
-            close(fd);
-            //break after redirection
-            break; 
+    //close all pipe ends in parent
+    for(size_t j = 0; j < pipes.size(); j++) close(pipes[j]);
+    //all stages are already running, so waiting on them one by one still lets the pipeline stream
+    RunJob(pids, command, background);
+}
+//function to time the launch of a trivial command with each launch path, printing the mean latency of each
+//resident_mb is allocated and touched first, to show how fork slows down as the shell grows
+void BenchmarkLaunch(int count, int resident_mb){
+    vector<char> resident((size_t)resident_mb << 20);
+    for(size_t i = 0; i < resident.size(); i += 4096) resident[i] = 1;
+    char name[] = "true";
+    char *args[] = {name, nullptr};
+    const LaunchMode modes[] = {LAUNCH_FORK, LAUNCH_SPAWN};
+    const char *labels[] = {"fork+exec", "posix_spawn"};
+    cout << "Launching '" << name << "' " << count << " times with " << resident_mb << " MB resident" << endl;
+    for(int m = 0; m < 2; m++){
+        launch_mode = modes[m];
+        auto begin = chrono::steady_clock::now();
+        for(int i = 0; i < count; i++){
+            ExecuteCommand(args, 1, false, name);
         }
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count();
+        printf("%-12s %10.1f us per launch\n", labels[m], us / count);
     }
 }
 
 //main function of a simple UNIX Shell
 int main(int argc, char *argv[]){
     //command entered by user
-    char command[MAX_LINE];       /
+    string command;
+    //copy of the previous command, parsed when "!!" repeats it
+    string previous;
     //holds parsed command line arguments
-    char *args[MAX_LINE / 2 + 1]; 
+    vector<char*> args;
     //flag that determines when to exit the program
     int should_run = 1;           
 
+    //reads the options: -f file runs a script, -F launches with fork+exec, -b count [-m MB] benchmarks both launch paths
+    const char *script = nullptr;
+    int bench_count = 0;
+    int resident_mb = 0;
+    int opt;
+    while((opt = getopt(argc, argv, "f:Fb:m:")) != -1){
+        if(opt == 'f') script = optarg;
+        else if(opt == 'F') launch_mode = LAUNCH_FORK;
+        else if(opt == 'b') bench_count = atoi(optarg);
+        else if(opt == 'm') resident_mb = atoi(optarg);
+        else{
+            cerr << "Usage: " << argv[0] << " [-f script] [-F] [-b count [-m resident_MB]]" << endl;
+            return 1;
+        }
+    }
+    if(bench_count > 0){
+        BenchmarkLaunch(bench_count, resident_mb);
+        return 0;
+    }
+
+    //reads commands from the script, closed on exec so commands still get the shell's stdin, or else from stdin
+    LineReader reader;
+    reader.fd = STDIN_FILENO;
+    if(script != nullptr){
+        reader.fd = open(script, O_RDONLY | O_CLOEXEC);
+        if(reader.fd < 0){
+            perror(script);
+            return 1;
+        }
+    }
+    reader.buffer.resize(READ_CHUNK);
+    reader.start = reader.end = 0;
+    //prompts only when a user is typing, a script runs without a prompt or a flush per line
+    bool interactive = script == nullptr && isatty(STDIN_FILENO);
+
+    //reaps children as they change state instead of leaving zombies
+    struct sigaction child_action;
+    memset(&child_action, 0, sizeof(child_action));
+    child_action.sa_handler = OnChildChanged;
+    child_action.sa_flags = SA_RESTART;
+    sigaction(SIGCHLD, &child_action, nullptr);
+    //an interactive shell runs each job in its own process group and leaves Ctrl-C and Ctrl-Z to the foreground job
+    job_control = interactive;
+    sigemptyset(&job_signals);
+    if(job_control){
+        const int ignored[] = {SIGINT, SIGQUIT, SIGTSTP, SIGTTIN, SIGTTOU};
+        for(size_t i = 0; i < sizeof(ignored) / sizeof(ignored[0]); i++){
+            signal(ignored[i], SIG_IGN);
+            sigaddset(&job_signals, ignored[i]);
+        }
+        shell_pgid = getpgrp();
+        tcsetpgrp(STDIN_FILENO, shell_pgid);
+    }
+
     while(should_run){
-        //prompt for user input
-        printf("osh> "); 
-        fflush(stdout);
+        if(child_changed){
+            //collects the children that exited since the last command
+            child_changed = 0;
+            ReapChildren();
+        }
+        if(interactive){
+            //prompt for user input
+            printf("osh> "); 
+            fflush(stdout);
+        }
         //exit on EOF
-        if(fgets(command, MAX_LINE, stdin) == nullptr) break; 
+        if(!ReadLine(reader, command)) break; 
+        //skips blank lines and comments
+        size_t first = command.find_first_not_of(" \t");
+        if(first == string::npos || command[first] == '#') continue;
 
         //stores command in history
-        history.push_back(string(command)); 
+        AddHistory(command); 
+        //the command line as entered, kept for the job table before parsing splits it up
+        const string *line = &RecentHistory(1);
         //parse input command
-        int num_args = ParseCommand(command, args); 
+        int num_args = ParseCommand(&command[0], args); 
 
-        if(strcmp(args[0], "exit") == 0){
-            //exits the shell
-            should_run = 0; 
-        } 
-        else if(strcmp(args[0], "!!") == 0){
+        if(strcmp(args[0], "!!") == 0){
             //executes previous command if history is not empty
-            if(history.size() > 1){
-                //prints previous command
-                cout << history[history.size() - 2]; 
-                ParseCommand((char*)history[history.size() - 2].c_str(), args);
-                //executes without background
-                ExecuteCommand(args, false); 
-            }else{
+            if(history_total < 2){
                 //no history found
                 cout << "No command history found." << endl; 
+                continue;
             }
+            //prints previous command, then parses a copy of it so the history is left intact
+            previous = RecentHistory(2);
+            cout << previous << endl; 
+            line = &RecentHistory(2);
+            num_args = ParseCommand(&previous[0], args);
+        }
+
+        if(strcmp(args[0], "exit") == 0){
+            //exits the shell
+            should_run = 0; 
         } 
+        else if(strcmp(args[0], "hash") == 0){
+            //lists or clears the cached command paths
+            HashBuiltin(args.data(), num_args);
+        }
+        else if(strcmp(args[0], "jobs") == 0){
+            //lists the background and stopped jobs
+            JobsBuiltin();
+        }
+        else if(strcmp(args[0], "fg") == 0){
+            //brings a job to the foreground
+            ForegroundBuiltin(args.data(), num_args);
+        }
+        else if(strcmp(args[0], "bg") == 0){
+            //continues a stopped job in the background
+            BackgroundBuiltin(args.data(), num_args);
+        }
         else{
             //flag for background execution
             bool background = false;
-            if(num_args > 0 && strcmp(args[num_args - 1], "&") == 0){
+            if(strcmp(args[num_args - 1], "&") == 0){
                 //properly remove '&' from args
-                args[num_args - 1] = nullptr; 
+                args[--num_args] = nullptr; 
                 //sets background flag
                 background = true; 
             }
-            //index of the pipe if present
-            int pipeIndex = -1; 
+            //checks for a pipe
+            bool has_pipe = false; 
             for(int i = 0; i < num_args; i++){
                 if(strcmp(args[i], "|") == 0){
-                    //records the position of the pipe
-                    pipeIndex = i; 
+                    has_pipe = true; 
                     break;
                 }
             }
-            if(pipeIndex != -1){
-                //if pipe is found, execute with pipe
-                ExecuteWithPipes(args, pipeIndex);
+            if(num_args == 0){
+                //nothing left to run after removing '&'
+            }else if(has_pipe){
+                //if a pipe is found, execute the whole pipeline
+                ExecuteWithPipes(args.data(), num_args, background, *line);
             }else{
-                //handles redirection
-                HandleRedirection(args, num_args); 
-                //execute command
-                ExecuteCommand(args, background);
+                //execute command, the child handles any redirection
+                ExecuteCommand(args.data(), num_args, background, *line);
            }
         }
     }
-    //prints command history
+    //prints command history, the most recent HISTORY_SIZE commands
     cout << "Command history:" << endl; 
-    //print each command from history
-    for (size_t i = 0; i < history.size(); i++) {
+    size_t kept = history_total < HISTORY_SIZE ? history_total : HISTORY_SIZE;
+    for (size_t back = kept; back > 0; back--) {
         //print each command followed by a newline
-        cout << history[i] << endl; 
+        cout << RecentHistory(back) << endl; 
     }
 
     //returns exit status
     return 0; 
 }
-
@@ -0,0 +1,352 @@
+/**
+ * Driver (main) program that compares several scheduling algorithms on the same workload.
+ * The input file is loaded once and every selected policy (and every RR time quantum and core count) is simulated
+ * against the same read-only process list, optionally in parallel threads. The average turn-around and waiting
+ * times and the number of context switches of all runs are printed as one comparison table, with the core
+ * utilisation and migrations of SMP runs.
+ * A time quantum can be a range "first-last" or "first-last:step", to sweep the quantum of the round robin
+ * policies; the best quantum of every swept policy is then reported after the table.
+ *
+ * Usage: ./compare <input_file> [-p fcfs,sjf,srtf,priority,ppriority,rr,priority_rr,mlfq]
+ *                  [-q quantum|first-last[:step],...] [-c cores,...] [-b none|steal|push|steal+push] [-m push period] [-j threads]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "scheduler_fcfs.h"
+#include "scheduler_sjf.h"
+#include "scheduler_priority.h"
+#include "scheduler_rr.h"
+#include "scheduler_priority_rr.h"
+#include "scheduler_mlfq.h"
+#include "workload.h"
+
+using namespace std;
+
+/**
+ * @brief One simulation to run: a policy and, for the round robin policies, a time quantum.
+ */
+struct Run {
+    // Name of the policy
+    string policy;
+    // Time quantum, or 0 for the policies without one
+    int quantum;
+    // Number of simulated cores
+    int cores;
+    // Results, filled in when the run is done
+    double avg_turnaround;
+    double avg_waiting;
+    double utilisation;
+    unsigned long long migrations;
+    unsigned long long context_switches;
+};
+
+// The largest number of time quanta a range can expand to
+const long long MAX_RANGE_QUANTA = 10000;
+
+/**
+ * @brief Parse a positive int at the start of a string.
+ * @param text The string; it is moved past the number.
+ * @param value Receives the number.
+ * @return false if the string does not start with a number from 1 to INT_MAX.
+ */
+bool parse_positive(const char *&text, int &value) {
+    char *end;
+    errno = 0;
+    long number = strtol(text, &end, 10);
+    if (end == text || errno == ERANGE || number <= 0 || number > INT_MAX) {
+        return false;
+    }
+    value = (int)number;
+    text = end;
+    return true;
+}
+
+/**
+ * @brief Parse a time quantum, or a range of time quanta "first-last" or "first-last:step".
+ * @param item The quantum or the range.
+ * @param quanta Receives the quanta.
+ * @return false if the item is not a valid quantum or range, or if the range has more than MAX_RANGE_QUANTA quanta.
+ */
+bool parse_quanta(const string &item, vector<int> &quanta) {
+    const char *text = item.c_str();
+    int first, last, step = 1;
+    if (!parse_positive(text, first)) {
+        return false;
+    }
+    if (*text == '\0') {
+        quanta.push_back(first);
+        return true;
+    }
+    if (*text++ != '-' || !parse_positive(text, last) || last < first) {
+        return false;
+    }
+    if (*text == ':' && !parse_positive(++text, step)) {
+        return false;
+    }
+    if (*text != '\0' || ((long long)last - first) / step + 1 > MAX_RANGE_QUANTA) {
+        return false;
+    }
+    // A 64-bit counter, so the step past a last quantum near INT_MAX does not overflow
+    for (long long q = first; q <= last; q += step) {
+        quanta.push_back((int)q);
+    }
+    return true;
+}
+
+/**
+ * @brief Parse the name of a load balancer.
+ * @param name The name: none, steal, push or steal+push.
+ * @return The Scheduler::Balancer flags, or -1 if the name is unknown.
+ */
+int parse_balancer(const string &name) {
+    if (name == "none") return Scheduler::BALANCE_NONE;
+    if (name == "steal") return Scheduler::BALANCE_STEAL;
+    if (name == "push") return Scheduler::BALANCE_PUSH;
+    if (name == "steal+push") return Scheduler::BALANCE_STEAL | Scheduler::BALANCE_PUSH;
+    return -1;
+}
+
+/**
+ * @brief Create a scheduler object for a policy.
+ * @param policy The name of the policy.
+ * @param quantum The time quantum for the round robin policies.
+ * @return The scheduler, or nullptr if the policy is unknown.
+ */
+Scheduler *make_scheduler(const string &policy, int quantum) {
+    if (policy == "fcfs") return new SchedulerFCFS();
+    if (policy == "sjf") return new SchedulerSJF();
+    if (policy == "srtf") return new SchedulerSJF(true);
+    if (policy == "priority") return new SchedulerPriority();
+    if (policy == "ppriority") return new SchedulerPriority(true);
+    if (policy == "rr") return new SchedulerRR(quantum);
+    if (policy == "priority_rr") return new SchedulerPriorityRR(quantum);
+    if (policy == "mlfq") {
+        // Three levels with the quantum doubling per level, the last one unlimited, and a boost every 50 quanta,
+        // both capped to UINT_MAX for the largest quanta
+        vector<unsigned int> quanta;
+        quanta.push_back(quantum);
+        quanta.push_back((unsigned int)min(2ULL * quantum, (unsigned long long)UINT_MAX));
+        quanta.push_back(0);
+        return new SchedulerMLFQ(quanta, (unsigned int)min(50ULL * quantum, (unsigned long long)UINT_MAX));
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Check whether a policy uses a time quantum.
+ * @param policy The name of the policy.
+ * @return true for the round robin policies.
+ */
+bool uses_quantum(const string &policy) {
+    return policy == "rr" || policy == "priority_rr" || policy == "mlfq";
+}
+
+/**
+ * @brief Split a comma-separated list.
+ * @param list The list.
+ * @return The items of the list.
+ */
+vector<string> split(const string &list) {
+    vector<string> items;
+    stringstream ss(list);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * @brief Simulate one run quietly and record its averages.
+ * @param run The run to simulate.
+ * @param process_table The shared, read-only process table.
+ * @param balancer The load balancers of the SMP runs.
+ * @param period The period of the push migration.
+ */
+void simulate_run(Run &run, const ProcessTable &process_table, int balancer, unsigned int period) {
+    unique_ptr<Scheduler> scheduler(make_scheduler(run.policy, run.quantum));
+    scheduler->set_verbose(false);
+    scheduler->set_cores(run.cores, balancer, period);
+    scheduler->init(process_table);
+    scheduler->simulate();
+    run.avg_turnaround = scheduler->average_turnaround();
+    run.avg_waiting = scheduler->average_waiting();
+    run.utilisation = scheduler->average_utilisation();
+    run.migrations = scheduler->migrations();
+    run.context_switches = scheduler->context_switches();
+}
+
+int main(int argc, char *argv[]) {
+    std::cout << "CS 433 Programming assignment 3" << std::endl;
+    std::cout << "Author: xxxxxx and xxxxxxx" << std::endl;     // TODO: add your name
+    std::cout << "Date: xx/xx/20xx" << std::endl;               // TODO: add date
+    std::cout << "Course: CS433 (Operating Systems)" << std::endl;
+    std::cout << "Description : compare scheduling algorithms " << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    // Make sure the user has provided the input file name
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <input_file> [-p fcfs,sjf,srtf,priority,ppriority,rr,priority_rr,mlfq]"
+             << " [-q quantum|first-last[:step],...] [-c cores,...] [-b none|steal|push|steal+push] [-m push period] [-j threads]"
+             << endl;
+        exit(1);
+    }
+    const char *input_file = argv[1];
+
+    // Parse the options after the input file
+    vector<string> policies = split("fcfs,sjf,srtf,priority,ppriority,rr,priority_rr,mlfq");
+    vector<int> quanta;
+    vector<int> core_counts;
+    int balancer = Scheduler::BALANCE_STEAL;
+    unsigned int period = 100;
+    // By default, one thread per hardware thread
+    int num_threads = max(1u, thread::hardware_concurrency());
+    optind = 2;
+    int opt;
+    while ((opt = getopt(argc, argv, "p:q:c:b:m:j:")) != -1) {
+        switch (opt) {
+            case 'p':
+                policies = split(optarg);
+                break;
+            case 'q':
+                for (const string &q : split(optarg)) {
+                    if (!parse_quanta(q, quanta)) {
+                        cerr << "Error: invalid time quantum " << q << " (quanta are from 1 to " << INT_MAX
+                             << ", and a range has at most " << MAX_RANGE_QUANTA << ")" << endl;
+                        exit(1);
+                    }
+                }
+                break;
+            case 'c':
+                for (const string &c : split(optarg)) {
+                    if (atoi(c.c_str()) <= 0) {
+                        cerr << "Error: invalid number of cores " << c << endl;
+                        exit(1);
+                    }
+                    core_counts.push_back(atoi(c.c_str()));
+                }
+                break;
+            case 'b':
+                balancer = parse_balancer(optarg);
+                if (balancer < 0) {
+                    cerr << "Error: unknown balancer " << optarg << endl;
+                    exit(1);
+                }
+                break;
+            case 'm':
+                if (atoi(optarg) <= 0) {
+                    cerr << "Error: the push period must be positive" << endl;
+                    exit(1);
+                }
+                period = atoi(optarg);
+                break;
+            case 'j':
+                num_threads = atoi(optarg);
+                if (num_threads <= 0) {
+                    cerr << "Error: the number of threads must be positive" << endl;
+                    exit(1);
+                }
+                break;
+            default:
+                exit(1);
+        }
+    }
+    if (quanta.empty()) {
+        quanta.push_back(10);
+    }
+    if (core_counts.empty()) {
+        core_counts.push_back(1);
+    }
+
+    // Expand the policies and the time quanta into the list of runs
+    vector<Run> runs;
+    for (const string &policy : policies) {
+        unique_ptr<Scheduler> check(make_scheduler(policy, 1));
+        if (!check) {
+            cerr << "Error: unknown policy " << policy << endl;
+            exit(1);
+        }
+        for (int cores : core_counts) {
+            if (uses_quantum(policy)) {
+                for (int q : quanta) {
+                    runs.push_back(Run{policy, q, cores, 0, 0, 0, 0, 0});
+                }
+            } else {
+                runs.push_back(Run{policy, 0, cores, 0, 0, 0, 0, 0});
+            }
+        }
+    }
+
+    // Load the workload once for all runs
+    ProcessTable process_table;
+    string error;
+    if (!load_workload(input_file, process_table, error)) {
+        cerr << "Error: " << error << endl;
+        exit(1);
+    }
+    cout << "Loaded " << process_table.size() << " processes from " << input_file << endl;
+
+    // Run the simulations; the threads take the next run from a shared counter
+    atomic<size_t> next_run(0);
+    auto worker = [&]() {
+        for (size_t i = next_run++; i < runs.size(); i = next_run++) {
+            simulate_run(runs[i], process_table, balancer, period);
+        }
+    };
+    vector<thread> threads;
+    for (size_t t = 1; t < (size_t)num_threads && t < runs.size(); t++) {
+        threads.push_back(thread(worker));
+    }
+    worker();
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+
+    // Print the comparison table
+    cout << fixed << setprecision(3);
+    cout << left << setw(14) << "Policy" << setw(10) << "Quantum" << setw(8) << "Cores" << setw(20)
+         << "Avg turn-around" << setw(20) << "Avg waiting" << setw(12) << "Switches" << setw(14) << "Utilisation"
+         << "Migrations" << '\n';
+    for (const Run &run : runs) {
+        cout << left << setw(14) << run.policy << setw(10) << (run.quantum > 0 ? to_string(run.quantum) : "-")
+             << setw(8) << run.cores << setw(20) << run.avg_turnaround << setw(20) << run.avg_waiting << setw(12)
+             << run.context_switches << setw(14) << 100 * run.utilisation << run.migrations << '\n';
+    }
+
+    // With a sweep, report the quantum with the lowest average waiting time of every policy and core count.
+    // The runs of one policy and core count are consecutive, in quantum order.
+    if (quanta.size() > 1) {
+        for (size_t i = 0; i < runs.size(); ) {
+            size_t j = i + 1;
+            size_t best = i;
+            while (j < runs.size() && runs[j].policy == runs[i].policy && runs[j].cores == runs[i].cores) {
+                if (runs[j].avg_waiting < runs[best].avg_waiting) {
+                    best = j;
+                }
+                j++;
+            }
+            if (runs[i].quantum > 0) {
+                cout << "Best quantum for " << runs[i].policy << " on " << runs[i].cores << " core(s) = "
+                     << runs[best].quantum << " (avg waiting " << runs[best].avg_waiting << ", avg turn-around "
+                     << runs[best].avg_turnaround << ", " << runs[best].context_switches << " switches)" << '\n';
+            }
+            i = j;
+        }
+    }
+    return 0;
+}
@@ -2,14 +2,19 @@
  * Driver (main) program for FCFS scheduling algorithm.
  * The input file is a text file containing the process information in the following format:
  * [name] [priority] [CPU burst]
+ * With the -c option, the processes run on that many simulated cores, and the utilisation and migrations of
+ * every core are printed with the results.
+ * With the -t option, the schedule is also written to a trace file, in binary or, for a .csv name, in CSV; the
+ * readtrace tool prints a binary trace.
  */
 
+#include <climits>
 #include <iostream>
-#include <fstream>
 #include <string>
 #include <vector>
-#include <sstream>
 #include "scheduler_fcfs.h"
+#include "trace.h"
+#include "workload.h"
 
 using namespace std;
 
@@ -21,47 +26,60 @@ int main(int argc, char *argv[]) {
     std::cout << "Description : test FCFS scheduling algorithm " << std::endl;
     std::cout << "=================================" << std::endl;
 
+    // Take the optional trace file out of the arguments
+    string trace_path;
+    if (!take_trace_option(argc, argv, trace_path)) {
+        cerr << "Error: -t needs a trace file name" << endl;
+        exit(1);
+    }
+    // Take the optional number of cores out of the arguments
+    int num_cores = 1;
+    if (!take_cores_option(argc, argv, num_cores)) {
+        cerr << "Error: -c needs a number of cores from 1 to " << INT_MAX << endl;
+        exit(1);
+    }
+
     // Make sure the user has provided the input file name
     if (argc < 2) {
-        cerr << "Usage: " << argv[0] << " <input_file>" << endl;
+        cerr << "Usage: " << argv[0] << " <input_file> [-c cores] [-t trace_file]" << endl;
         exit(1);
     }
 
-    // Read the input file
-    ifstream input_file(argv[1]);
-    // Make sure the file is open
-    if (!input_file.is_open()) {
-        cerr << "Error: Unable to open file " << argv[1] << endl;
+    // Load the processes from the input file
+    ProcessTable process_table;
+    string error;
+    if (!load_workload(argv[1], process_table, error)) {
+        cerr << "Error: " << error << endl;
         exit(1);
     }
-    string line;
-    vector<PCB> process_list;
-    int id = 0;
-    while(getline(input_file, line)) {
-        // Split the line into tokens
-        istringstream ss(line);
-        string name;
-        // parse out the name
-        getline(ss, name, ',');
-        // parse out the priority
-        string token;
-        getline(ss, token, ',');
-        unsigned int priority = stoi(token);
-        // parse out the burst time
-        getline(ss, token, ',');
-        unsigned int burst_time = stoi(token);
-
-        // Create a PCB object and add it to the process list
-        PCB pcb(name, id, priority, burst_time);
-        id++;
-        pcb.print();
-        process_list.push_back(pcb);
+    if (process_table.size() <= Scheduler::PRINT_LIMIT) {
+        for (size_t i = 0; i < process_table.size(); i++) {
+            process_table.print(i);
+        }
     }
 
     // Create a scheduler object
     SchedulerFCFS scheduler;
+    // Write the schedule to the trace file if requested: binary, or CSV for a .csv file
+    TraceWriter trace;
+    if (!trace_path.empty()) {
+        if (!trace.open(trace_path, TraceWriter::format_for(trace_path), error)) {
+            cerr << "Error: " << error << endl;
+            exit(1);
+        }
+        scheduler.set_trace(&trace);
+    }
+    // Simulate the cores, with the default work stealing when there are several
+    scheduler.set_cores(num_cores);
     // Run the scheduler
-    scheduler.init(process_list);
+    scheduler.init(process_table);
     scheduler.simulate();
+    if (!trace_path.empty()) {
+        if (!trace.close(error)) {
+            cerr << "Error: " << error << endl;
+            exit(1);
+        }
+        cout << "Wrote " << trace.records() << " runs to " << trace_path << endl;
+    }
     scheduler.print_results();
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+/**
+ * Driver (main) program for MLFQ scheduling algorithm.
+ * The input file is a text file containing the process information in the following format:
+ * [name] [priority] [CPU burst] [arrival time (optional)]
+ *
+ * Usage: ./mlfq <input_file> [quantum,quantum,...] [boost period] [-c cores] [-t trace_file]
+ * The quanta list the time quantum of each level from the highest priority one, and 0 means no limit.
+ * The defaults are three levels with quanta 8,16,0 and a boost every 100 time units; a boost period of 0 disables
+ * the boost.
+ * With the -c option, the processes run on that many simulated cores, and the utilisation and migrations of
+ * every core are printed with the results.
+ * With the -t option, the schedule is also written to a trace file, in binary or, for a .csv name, in CSV; the
+ * readtrace tool prints a binary trace.
+ */
+
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "scheduler_mlfq.h"
+#include "trace.h"
+#include "workload.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+    std::cout << "CS 433 Programming assignment 3" << std::endl;
+    std::cout << "Author: xxxxxx and xxxxxxx" << std::endl;     // TODO: add your name
+    std::cout << "Date: xx/xx/20xx" << std::endl;               // TODO: add date
+    std::cout << "Course: CS433 (Operating Systems)" << std::endl;
+    std::cout << "Description : test MLFQ scheduling algorithm " << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    // Take the optional trace file out of the arguments
+    string trace_path;
+    if (!take_trace_option(argc, argv, trace_path)) {
+        cerr << "Error: -t needs a trace file name" << endl;
+        exit(1);
+    }
+    // Take the optional number of cores out of the arguments
+    int num_cores = 1;
+    if (!take_cores_option(argc, argv, num_cores)) {
+        cerr << "Error: -c needs a number of cores from 1 to " << INT_MAX << endl;
+        exit(1);
+    }
+
+    // Make sure the user has provided the input file name
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <input_file> [quantum,quantum,...] [boost period] [-c cores] [-t trace_file]" << endl;
+        exit(1);
+    }
+
+    // Read the quanta of the levels and the boost period if provided
+    vector<unsigned int> quanta;
+    stringstream ss(argc > 2 ? argv[2] : "8,16,0");
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) {
+            quanta.push_back(strtoul(item.c_str(), nullptr, 10));
+        }
+    }
+    if (quanta.empty() || quanta.size() > SchedulerMLFQ::MAX_LEVELS) {
+        cerr << "Error: expected 1 to " << SchedulerMLFQ::MAX_LEVELS << " quanta" << endl;
+        exit(1);
+    }
+    unsigned int boost_period = argc > 3 ? strtoul(argv[3], nullptr, 10) : 100;
+
+    // Load the processes from the input file
+    ProcessTable process_table;
+    string error;
+    if (!load_workload(argv[1], process_table, error)) {
+        cerr << "Error: " << error << endl;
+        exit(1);
+    }
+    if (process_table.size() <= Scheduler::PRINT_LIMIT) {
+        for (size_t i = 0; i < process_table.size(); i++) {
+            process_table.print(i);
+        }
+    }
+
+    // Create a scheduler object
+    SchedulerMLFQ scheduler(quanta, boost_period);
+    // Write the schedule to the trace file if requested: binary, or CSV for a .csv file
+    TraceWriter trace;
+    if (!trace_path.empty()) {
+        if (!trace.open(trace_path, TraceWriter::format_for(trace_path), error)) {
+            cerr << "Error: " << error << endl;
+            exit(1);
+        }
+        scheduler.set_trace(&trace);
+    }
+    // Simulate the cores, with the default work stealing when there are several
+    scheduler.set_cores(num_cores);
+    // Run the scheduler
+    scheduler.init(process_table);
+    scheduler.simulate();
+    if (!trace_path.empty()) {
+        if (!trace.close(error)) {
+            cerr << "Error: " << error << endl;
+            exit(1);
+        }
+        cout << "Wrote " << trace.records() << " runs to " << trace_path << endl;
+    }
+    scheduler.print_results();
+}
@@ -9,8 +9,11 @@
 // Remember to addPCB sufficient comments to your code
 
 #pragma once
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <vector>
 using namespace std;
 
 /**
@@ -40,13 +43,15 @@ public:
      * @param id: each process has a unique ID
      * @param priority: the priority of the process in the range 1-50. Larger number represents higher priority
      * @param state the state of the process.
+     * @param arrival_time: the time at which the process enters the ready queue
      */
-    PCB(string name, unsigned int id = 0, unsigned int priority = 1, unsigned int burst_time = 0) {
+    PCB(string name, unsigned int id = 0, unsigned int priority = 1, unsigned int burst_time = 0,
+        unsigned int arrival_time = 0) {
         this->id = id;
         this->name = name;
         this->priority = priority;
         this->burst_time = burst_time;
-        this->arrival_time = 0;
+        this->arrival_time = arrival_time;
     }
 
     /**
@@ -60,6 +65,226 @@ public:
      */
     void print() {
         cout << "Process " << id << ": " << name << " has priority " << priority << " and burst time "
-             << burst_time << endl;
+             << burst_time;
+        if (arrival_time != 0) {
+            cout << " and arrival time " << arrival_time;
+        }
+        cout << endl;
     }
-};
\ No newline at end of file
+};
+
+/**
+ * @brief The compact record of a process used by the schedulers: the fields of a PCB without its name.
+ *        At 16 bytes, four records fit in a cache line, and copying one never touches the heap.
+ */
+struct ProcessRecord {
+    // The unique process ID
+    unsigned int id;
+    // The priority of a process. Larger number represents higher priority
+    unsigned int priority;
+    // The CPU burst time of the process
+    unsigned int burst_time;
+    // The arrival time of the process
+    unsigned int arrival_time;
+};
+
+/**
+ * @brief The place of a process name in the name arena of a ProcessTable.
+ */
+struct NameRef {
+    // The offset of the first character in the arena
+    uint32_t offset;
+    // The number of characters
+    uint32_t length;
+};
+
+/**
+ * @brief A list of processes stored as parallel arrays: the compact records, and the name of each process.
+ *        Process i is records[i], and its name is names[i], a slice of one contiguous arena of characters.
+ *        Names are interned: a name that was seen before refers to the characters of its first occurrence, so a
+ *        workload of a few distinct names repeated many times stores each only once. The arena holds at most 4 GiB
+ *        of distinct names.
+ *        The simulation hot loop only reads the records; the names are only read when printing.
+ */
+class ProcessTable {
+private:
+    // The compact record of each process
+    vector<ProcessRecord> records;
+    // The name of each process, indexed like records
+    vector<NameRef> names;
+    // The characters of the distinct names, one after the other
+    string chars;
+    // Hash table of the distinct names, by linear probing: one more than the index of a process with that name,
+    // or 0 for an empty slot. Its size is a power of two, at least twice the number of distinct names.
+    vector<uint32_t> name_slots;
+    // The number of distinct names
+    size_t distinct_names = 0;
+
+    /**
+     * @brief Hash a name with FNV-1a.
+     * @param name The characters of the name.
+     * @param length The number of characters.
+     * @return The hash.
+     */
+    static uint32_t hash_name(const char *name, size_t length) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; i++) {
+            hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Find the slot of a name in the hash table: the slot that holds it, or the empty slot where it goes.
+     * @param name The characters of the name.
+     * @param length The number of characters.
+     * @return The index of the slot.
+     */
+    size_t find_slot(const char *name, size_t length) const {
+        size_t mask = name_slots.size() - 1;
+        for (size_t slot = hash_name(name, length) & mask;; slot = (slot + 1) & mask) {
+            uint32_t entry = name_slots[slot];
+            if (entry == 0) {
+                return slot;
+            }
+            const NameRef &ref = names[entry - 1];
+            if (ref.length == length && memcmp(chars.data() + ref.offset, name, length) == 0) {
+                return slot;
+            }
+        }
+    }
+
+    /**
+     * @brief Double the hash table, placing every distinct name again.
+     */
+    void grow_slots() {
+        vector<uint32_t> old_slots(name_slots.size() < 16 ? 16 : name_slots.size() * 2, 0);
+        old_slots.swap(name_slots);
+        for (size_t i = 0; i < old_slots.size(); i++) {
+            if (old_slots[i] != 0) {
+                const NameRef &ref = names[old_slots[i] - 1];
+                name_slots[find_slot(chars.data() + ref.offset, ref.length)] = old_slots[i];
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Append a process to the table. Its ID is its index in the table.
+     * @param name The characters of the name of the process; they are copied into the arena unless the name was
+     *        seen before.
+     * @param length The number of characters of the name.
+     * @param priority The priority of the process.
+     * @param burst_time The CPU burst time of the process.
+     * @param arrival_time The arrival time of the process.
+     */
+    void add(const char *name, size_t length, unsigned int priority, unsigned int burst_time,
+             unsigned int arrival_time = 0) {
+        if (2 * (distinct_names + 1) > name_slots.size()) {
+            grow_slots();
+        }
+        size_t slot = find_slot(name, length);
+        NameRef ref;
+        if (name_slots[slot] != 0) {
+            ref = names[name_slots[slot] - 1];
+        } else {
+            ref.offset = chars.size();
+            ref.length = length;
+            chars.append(name, length);
+            name_slots[slot] = records.size() + 1;
+            distinct_names++;
+        }
+        ProcessRecord record;
+        record.id = records.size();
+        record.priority = priority;
+        record.burst_time = burst_time;
+        record.arrival_time = arrival_time;
+        records.push_back(record);
+        names.push_back(ref);
+    }
+
+    /**
+     * @brief Append a process to the table. Its ID is its index in the table.
+     * @param name The name of the process.
+     * @param priority The priority of the process.
+     * @param burst_time The CPU burst time of the process.
+     * @param arrival_time The arrival time of the process.
+     */
+    void add(const string &name, unsigned int priority, unsigned int burst_time, unsigned int arrival_time = 0) {
+        add(name.data(), name.size(), priority, burst_time, arrival_time);
+    }
+
+    /**
+     * @brief Reserve room for a number of processes.
+     * @param n The number of processes.
+     */
+    void reserve(size_t n) {
+        records.reserve(n);
+        names.reserve(n);
+    }
+
+    /**
+     * @brief Remove all processes.
+     */
+    void clear() {
+        records.clear();
+        names.clear();
+        chars.clear();
+        name_slots.clear();
+        distinct_names = 0;
+    }
+
+    /**
+     * @brief Get the number of processes.
+     * @return The number of processes.
+     */
+    size_t size() const { return records.size(); }
+
+    /**
+     * @brief Check whether the table is empty.
+     * @return true if there are no processes.
+     */
+    bool empty() const { return records.empty(); }
+
+    /**
+     * @brief Get the records of all processes, as a contiguous array of size() records.
+     * @return The records.
+     */
+    const ProcessRecord *data() const { return records.data(); }
+
+    /**
+     * @brief Get the record of a process.
+     * @param i The index of the process.
+     * @return The record.
+     */
+    const ProcessRecord &operator[](size_t i) const { return records[i]; }
+
+    /**
+     * @brief Get the name of a process.
+     * @param i The index of the process.
+     * @return A copy of the name.
+     */
+    string name(size_t i) const { return string(chars.data() + names[i].offset, names[i].length); }
+
+    /**
+     * @brief Get the number of distinct names, each stored once in the arena.
+     * @return The number of distinct names.
+     */
+    size_t distinct_name_count() const { return distinct_names; }
+
+    /**
+     * @brief Build the full PCB of a process.
+     * @param i The index of the process.
+     * @return The PCB.
+     */
+    PCB pcb(size_t i) const {
+        const ProcessRecord &record = records[i];
+        return PCB(name(i), record.id, record.priority, record.burst_time, record.arrival_time);
+    }
+
+    /**
+     * @brief Print a process in the same format as PCB::print.
+     * @param i The index of the process.
+     */
+    void print(size_t i) const { pcb(i).print(); }
+};
@@ -0,0 +1,82 @@
+/**
+ * Reader program for the binary schedule traces written with the -t option of the drivers.
+ * It prints the records as CSV lines "time,pid,duration,core", the same format as a .csv trace, or with -s, a
+ * summary of the number of runs and the busy time of every core. Traces of any other version are rejected.
+ *
+ * Usage: ./readtrace <trace_file> [-s]
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "trace.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <trace_file> [-s]" << endl;
+        exit(1);
+    }
+    bool summary = argc > 2 && string(argv[2]) == "-s";
+
+    FILE *file = fopen(argv[1], "rb");
+    if (file == nullptr) {
+        cerr << "Error: unable to open file " << argv[1] << ": " << strerror(errno) << endl;
+        exit(1);
+    }
+    TraceHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+        cerr << "Error: " << argv[1] << " is not a binary schedule trace" << endl;
+        exit(1);
+    }
+    if (header.version != TRACE_VERSION || header.record_size != sizeof(TraceRecord)) {
+        cerr << "Error: unsupported trace version " << header.version << endl;
+        exit(1);
+    }
+
+    // Read the records in large blocks
+    vector<TraceRecord> block(4096);
+    unsigned long long runs = 0;
+    unsigned long long end_time = 0;
+    vector<unsigned long long> core_busy, core_runs;
+    if (!summary) {
+        printf("time,pid,duration,core\n");
+    }
+    size_t n;
+    while ((n = fread(block.data(), sizeof(TraceRecord), block.size(), file)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            const TraceRecord &record = block[i];
+            if (summary) {
+                if (record.core >= core_busy.size()) {
+                    core_busy.resize(record.core + 1, 0);
+                    core_runs.resize(record.core + 1, 0);
+                }
+                core_busy[record.core] += record.duration;
+                core_runs[record.core]++;
+                if (record.time + record.duration > end_time) {
+                    end_time = record.time + record.duration;
+                }
+            } else {
+                printf("%llu,%u,%u,%u\n", (unsigned long long)record.time, record.pid, record.duration, record.core);
+            }
+        }
+        runs += n;
+    }
+    fclose(file);
+
+    if (summary) {
+        cout << "Runs = " << runs << ", end time = " << end_time << endl;
+        for (size_t c = 0; c < core_busy.size(); c++) {
+            cout << "Core " << c << ": runs = " << core_runs[c] << ", busy time = " << core_busy[c];
+            if (end_time > 0) {
+                cout << ", utilisation = " << 100.0 * core_busy[c] / end_time << "%";
+            }
+            cout << endl;
+        }
+    }
+    return 0;
+}
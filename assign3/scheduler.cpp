@@ -0,0 +1,512 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file scheduler.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief This is the implementation of the discrete-event simulation engine of the base Scheduler class.
+ * @version 0.1
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include "scheduler.h"
+
+/**
+ * @brief Record that a process ran on a core, printing it or writing it to the trace.
+ *        The printed lines end with '\n' rather than endl, so they are not flushed one by one.
+ * @param proc The index of the process in the process list.
+ * @param start The time at which the run started.
+ * @param duration The length of the run.
+ * @param core The core.
+ */
+void Scheduler::record_run(int proc, uint64_t start, unsigned int duration, int core) {
+    cores[core].busy += duration;
+    if (trace != nullptr) {
+        trace->write(start, processes[proc].id, duration, core);
+    }
+    if (print_schedule) {
+        cout << "Running Process " << table->name(proc) << " for " << duration << " time units";
+        if (num_cores > 1) {
+            cout << " on core " << core;
+        }
+        cout << '\n';
+    }
+}
+
+/**
+ * @brief Set a timer that calls on_timer at the given time.
+ * @param time The time of the timer.
+ */
+void Scheduler::schedule_timer(uint64_t time) {
+    Event event;
+    event.time = time;
+    event.type = TIMER;
+    event.proc = -1;
+    event.core = -1;
+    event.seq = 0;
+    events.push(event);
+}
+
+/**
+ * @brief Choose the number of simulated CPU cores and their load balancers. It must be called before init.
+ * @param cores The number of cores, at least 1.
+ * @param balancer The load balancers, a combination of Balancer flags.
+ * @param period The period of the push migration, used with BALANCE_PUSH.
+ */
+void Scheduler::set_cores(int cores, int balancer, unsigned int period) {
+    num_cores = cores > 0 ? cores : 1;
+    this->balancer = balancer;
+    balance_period = period > 0 ? period : 100;
+}
+
+/**
+ * @brief This function is called once before the simulation starts.
+ *        It keeps a view of the process table, sorts the arrival stream and creates the ready queues of the cores.
+ * @param process_table The processes in the simulation.
+ */
+void Scheduler::init(const ProcessTable& process_table) {
+    table = &process_table;
+    processes = process_table.data();
+    num_processes = process_table.size();
+    remaining.assign(num_processes, 0);
+    completion_time.assign(num_processes, 0);
+    events = priority_queue<Event, vector<Event>, greater<Event>>();
+    arrival_order.resize(num_processes);
+    for (size_t i = 0; i < num_processes; i++) {
+        remaining[i] = processes[i].burst_time;
+        arrival_order[i] = i;
+    }
+    // Workloads are usually listed in arrival order, so only sort when needed
+    auto earlier = [this](int a, int b) { return processes[a].arrival_time < processes[b].arrival_time; };
+    if (!is_sorted(arrival_order.begin(), arrival_order.end(), earlier)) {
+        stable_sort(arrival_order.begin(), arrival_order.end(), earlier);
+    }
+    cores.assign(num_cores, Core());
+    makespan = 0;
+    print_schedule = verbose && num_processes <= PRINT_LIMIT;
+    balance_armed = false;
+    init_ready(num_cores);
+}
+
+/**
+ * @brief Add a process to the ready queue of a core.
+ * @param proc The index of the process in the process list.
+ * @param core The core.
+ */
+void Scheduler::enqueue(int proc, int core) {
+    add_ready(proc, core);
+    cores[core].queued++;
+}
+
+/**
+ * @brief Remove the next process from the ready queue of a core.
+ * @param core The core.
+ * @return The index of the process, or -1 if the ready queue is empty.
+ */
+int Scheduler::dequeue(int core) {
+    int proc = pick_next(core);
+    if (proc != -1) {
+        cores[core].queued--;
+    }
+    return proc;
+}
+
+/**
+ * @brief Move the next process of the ready queue of a core to the ready queue of another core.
+ * @param from The core that gives the process.
+ * @param to The core that receives the process.
+ * @return The index of the process, or -1 if the ready queue of the first core is empty.
+ */
+int Scheduler::migrate(int from, int to) {
+    int proc = dequeue(from);
+    if (proc != -1) {
+        cores[from].migrations_out++;
+        cores[to].migrations_in++;
+    }
+    return proc;
+}
+
+/**
+ * @brief Find the core that should receive an arriving process: the one with the fewest ready and running
+ *        processes, the lowest index first.
+ * @return The core.
+ */
+int Scheduler::least_loaded_core() const {
+    int best = 0;
+    size_t best_load = cores[0].queued + (cores[0].running != -1);
+    for (int c = 1; c < num_cores && best_load > 0; c++) {
+        size_t load = cores[c].queued + (cores[c].running != -1);
+        if (load < best_load) {
+            best = c;
+            best_load = load;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Find the core with the longest ready queue, the lowest index first.
+ * @return The core.
+ */
+int Scheduler::longest_queue_core() const {
+    int best = 0;
+    for (int c = 1; c < num_cores; c++) {
+        if (cores[c].queued > cores[best].queued) {
+            best = c;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Check whether the lengths of two ready queues differ by more than one.
+ * @return true if push migration would move a process.
+ */
+bool Scheduler::unbalanced() const {
+    size_t longest = cores[0].queued, shortest = cores[0].queued;
+    for (int c = 1; c < num_cores; c++) {
+        longest = max(longest, cores[c].queued);
+        shortest = min(shortest, cores[c].queued);
+    }
+    return longest > shortest + 1;
+}
+
+/**
+ * @brief Push processes from the longest ready queues to the shortest ones until their lengths differ by at most
+ *        one. The pushed process is the one the policy would run next on the longest queue.
+ * @param changed Set for the cores that received a process.
+ */
+void Scheduler::push_balance(vector<char> &changed) {
+    while (true) {
+        int longest = 0, shortest = 0;
+        for (int c = 1; c < num_cores; c++) {
+            if (cores[c].queued > cores[longest].queued) longest = c;
+            if (cores[c].queued < cores[shortest].queued) shortest = c;
+        }
+        if (cores[longest].queued <= cores[shortest].queued + 1) {
+            return;
+        }
+        enqueue(migrate(longest, shortest), shortest);
+        changed[shortest] = true;
+    }
+}
+
+/**
+ * @brief Run a process on an idle core for its time slice, which ends with a single COMPLETION or QUANTUM_EXPIRY
+ *        event in the future.
+ * @param proc The index of the process in the process list.
+ * @param core The core.
+ * @param now The current time.
+ * @param seq The sequence number of the dispatch.
+ */
+void Scheduler::dispatch(int proc, int core, uint64_t now, unsigned long long seq) {
+    Core &cpu = cores[core];
+    unsigned int slice = time_slice(proc, core);
+    if (slice == 0 || slice > remaining[proc]) {
+        slice = remaining[proc];
+    }
+    if (cpu.last != -1 && cpu.last != proc) {
+        cpu.context_switches++;
+    }
+    cpu.last = proc;
+    cpu.running = proc;
+    cpu.slice = slice;
+    cpu.start = now;
+    cpu.dispatch = seq;
+    Event event;
+    event.time = now + slice;
+    event.type = slice == remaining[proc] ? COMPLETION : QUANTUM_EXPIRY;
+    event.proc = proc;
+    event.core = core;
+    event.seq = seq;
+    events.push(event);
+}
+
+/**
+ * @brief This function simulates the scheduling of processes in the ready queues.
+ *        Each step advances to the earliest of the next arrival and the next event. It adds the processes arriving
+ *        at that time to the ready queue of the least loaded core, handles the events of that time, lets the policy
+ *        preempt the running processes, and then dispatches the next process chosen by the policy on every idle
+ *        core. With work stealing, a core that is still idle then takes a process from the longest ready queue.
+ *        It stops when all processes are finished.
+ */
+void Scheduler::simulate() {
+    // Sequence number of the last dispatch, over all cores
+    unsigned long long dispatches = 0;
+    // Position of the next arrival in the arrival stream
+    size_t next_arrival = 0;
+    // Number of processes that have completed
+    size_t finished = 0;
+    // Cores whose ready queue received processes in the current step
+    vector<char> changed(num_cores);
+    // Whether push migration is on
+    bool push = num_cores > 1 && (balancer & BALANCE_PUSH);
+    if (verbose && !print_schedule) {
+        cout << "(schedule of the " << num_processes << " processes not printed, use a trace file to save it)" << '\n';
+    }
+
+    while (finished < num_processes && (next_arrival < arrival_order.size() || !events.empty())) {
+        uint64_t now;
+        if (events.empty() || (next_arrival < arrival_order.size() &&
+                               processes[arrival_order[next_arrival]].arrival_time <= events.top().time)) {
+            now = processes[arrival_order[next_arrival]].arrival_time;
+        } else {
+            now = events.top().time;
+        }
+        fill(changed.begin(), changed.end(), false);
+
+        // Merge the arrivals of the current time into the ready queues
+        while (next_arrival < arrival_order.size() && processes[arrival_order[next_arrival]].arrival_time == now) {
+            int core = num_cores == 1 ? 0 : least_loaded_core();
+            enqueue(arrival_order[next_arrival], core);
+            next_arrival++;
+            changed[core] = true;
+        }
+
+        // Handle the end of the time slices of the running processes, then the timers and the push migration
+        while (!events.empty() && events.top().time == now) {
+            Event event = events.top();
+            events.pop();
+            if (event.type == TIMER) {
+                on_timer(now);
+                fill(changed.begin(), changed.end(), true);
+                continue;
+            }
+            if (event.type == BALANCE) {
+                balance_armed = false;  // push migration runs below, after the other events of the time
+                continue;
+            }
+            Core &cpu = cores[event.core];
+            if (event.seq != cpu.dispatch || event.proc != cpu.running) {
+                continue;   // stale event of a preempted dispatch
+            }
+            record_run(event.proc, cpu.start, cpu.slice, event.core);
+            cpu.running = -1;
+            if (event.type == COMPLETION) {
+                remaining[event.proc] = 0;
+                completion_time[event.proc] = now;
+                makespan = now;
+                finished++;
+            } else {
+                remaining[event.proc] -= cpu.slice;
+                on_quantum_expiry(event.proc, now);
+                enqueue(event.proc, event.core);
+            }
+        }
+
+        // Push migration runs at the multiples of its period, whether or not this step was armed for it
+        if (push && now > 0 && now % balance_period == 0) {
+            push_balance(changed);
+        }
+
+        for (int c = 0; c < num_cores; c++) {
+            Core &cpu = cores[c];
+            // Newly queued processes or a timer may preempt the running process
+            if (cpu.running != -1 && changed[c]) {
+                unsigned int ran = (unsigned int)(now - cpu.start);  // At most the slice
+                if (should_preempt(cpu.running, remaining[cpu.running] - ran, c)) {
+                    if (ran > 0) {
+                        record_run(cpu.running, cpu.start, ran, c);
+                    }
+                    remaining[cpu.running] -= ran;
+                    enqueue(cpu.running, c);
+                    cpu.running = -1;
+                } else {
+                    // A shorter slice ends with a new event of the same dispatch; the old one then finds the core
+                    // idle or running another dispatch, and is skipped as stale
+                    unsigned int slice = revise_slice(cpu.running, ran, c);
+                    if (slice > ran && slice < cpu.slice) {
+                        cpu.slice = slice;
+                        Event event;
+                        event.time = cpu.start + slice;
+                        event.type = QUANTUM_EXPIRY;
+                        event.proc = cpu.running;
+                        event.core = c;
+                        event.seq = cpu.dispatch;
+                        events.push(event);
+                    }
+                }
+            }
+            // Dispatch the next process if the core is idle
+            if (cpu.running == -1) {
+                int proc = dequeue(c);
+                if (proc != -1) {
+                    dispatch(proc, c, now, ++dispatches);
+                }
+            }
+        }
+
+        // Idle cores steal from the longest ready queue
+        if (num_cores > 1 && (balancer & BALANCE_STEAL)) {
+            for (int c = 0; c < num_cores; c++) {
+                if (cores[c].running != -1) {
+                    continue;
+                }
+                int victim = longest_queue_core();
+                if (cores[victim].queued == 0) {
+                    break;
+                }
+                dispatch(migrate(victim, c), c, now, ++dispatches);
+            }
+        }
+
+        // Only unbalanced ready queues need a step at the next multiple of the period, so balanced or idle cores cost
+        // no events however long the bursts are
+        if (push && !balance_armed && finished < num_processes && unbalanced()) {
+            Event event;
+            event.time = (now / balance_period + 1) * balance_period;
+            event.type = BALANCE;
+            event.proc = -1;
+            event.core = -1;
+            event.seq = 0;
+            events.push(event);
+            balance_armed = true;
+        }
+    }
+    cout.flush();
+}
+
+/**
+ * @brief This function is called once after the simulation ends.
+ *        It prints the turn-around and waiting time of every process, up to PRINT_LIMIT processes, and their
+ *        averages, and with several cores, the utilisation and migrations of every core.
+ */
+void Scheduler::print_results() {
+    double total_turnaround = 0;
+    double total_waiting = 0;
+    bool print_all = num_processes <= PRINT_LIMIT;
+    for (size_t i = 0; i < num_processes; i++) {
+        // Turn-around time is from arrival to completion; waiting time is the part of it not spent running
+        uint64_t turnaround = completion_time[i] - processes[i].arrival_time;
+        uint64_t waiting = turnaround - processes[i].burst_time;
+        if (print_all) {
+            cout << table->name(i) << " turn-around time = " << turnaround << ", waiting time = " << waiting << '\n';
+        }
+        total_turnaround += turnaround;
+        total_waiting += waiting;
+    }
+    if (!print_all) {
+        cout << "(results of the " << num_processes << " processes not printed, only their averages)" << '\n';
+    }
+    if (num_processes != 0) {
+        cout << "Average turn-around time = " << total_turnaround / num_processes
+             << ", Average waiting time = " << total_waiting / num_processes << endl;
+    }
+    if (num_cores > 1) {
+        for (int c = 0; c < num_cores; c++) {
+            cout << "Core " << c << " utilisation = " << 100 * utilisation(c) << "%, migrations in = "
+                 << cores[c].migrations_in << ", migrations out = " << cores[c].migrations_out << '\n';
+        }
+        cout << "Average utilisation = " << 100 * average_utilisation() << "%, Total migrations = " << migrations()
+             << endl;
+    }
+}
+
+/**
+ * @brief Get the utilisation of a core, valid after simulate.
+ * @param core The core.
+ * @return The fraction of the time, until the last process finished, that the core spent running processes.
+ */
+double Scheduler::utilisation(int core) const {
+    return makespan > 0 ? (double)cores[core].busy / makespan : 0;
+}
+
+/**
+ * @brief Get the average utilisation of the cores, valid after simulate.
+ * @return The average utilisation.
+ */
+double Scheduler::average_utilisation() const {
+    double total = 0;
+    for (int c = 0; c < num_cores; c++) {
+        total += utilisation(c);
+    }
+    return total / num_cores;
+}
+
+/**
+ * @brief Get the total number of migrations, valid after simulate.
+ * @return The number of processes moved from one core to another.
+ */
+unsigned long long Scheduler::migrations() const {
+    unsigned long long total = 0;
+    for (int c = 0; c < num_cores; c++) {
+        total += cores[c].migrations_out;
+    }
+    return total;
+}
+
+/**
+ * @brief Get the average turn-around time of the processes, valid after simulate.
+ * @return The average turn-around time, or 0 if there are no processes.
+ */
+double Scheduler::average_turnaround() const {
+    if (num_processes == 0) {
+        return 0;
+    }
+    double total = 0;
+    for (size_t i = 0; i < num_processes; i++) {
+        total += completion_time[i] - processes[i].arrival_time;
+    }
+    return total / num_processes;
+}
+
+/**
+ * @brief Get the average waiting time of the processes, valid after simulate.
+ * @return The average waiting time, or 0 if there are no processes.
+ */
+double Scheduler::average_waiting() const {
+    if (num_processes == 0) {
+        return 0;
+    }
+    double total = 0;
+    for (size_t i = 0; i < num_processes; i++) {
+        total += completion_time[i] - processes[i].arrival_time - processes[i].burst_time;
+    }
+    return total / num_processes;
+}
+
+/**
+ * @brief Get the total number of context switches, valid after simulate.
+ * @return The number of times a core started running a different process than the one it ran before.
+ */
+unsigned long long Scheduler::context_switches() const {
+    unsigned long long total = 0;
+    for (int c = 0; c < num_cores; c++) {
+        total += cores[c].context_switches;
+    }
+    return total;
+}
+
+/**
+ * @brief Remove a "-c <cores>" option from the command line, so the drivers can keep parsing their positional
+ *        arguments unchanged.
+ * @param argc The number of arguments; it is reduced when the option is found.
+ * @param argv The arguments; the option is removed from them.
+ * @param cores Receives the number of cores, or is left unchanged when there is no such option.
+ * @return false if -c is the last argument or its value is not a number from 1 to INT_MAX.
+ */
+bool take_cores_option(int &argc, char *argv[], int &cores) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-c") != 0) {
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        char *end;
+        errno = 0;
+        long value = strtol(argv[i + 1], &end, 10);
+        if (end == argv[i + 1] || *end != '\0' || errno == ERANGE || value <= 0 || value > INT_MAX) {
+            return false;
+        }
+        cores = (int)value;
+        for (int j = i; j + 2 <= argc; j++) {
+            argv[j] = argv[j + 2];
+        }
+        argc -= 2;
+        return true;
+    }
+    return true;
+}
@@ -10,15 +10,284 @@
 // Remember to add sufficient and clear comments to your code
 #pragma once
 
+#include <cstdint>
+#include <queue>
 #include <vector>
 #include "pcb.h"
+#include "trace.h"
 
 using namespace std;
 /**
  * @brief This is the base class for the scheduler.
+ * It contains a discrete-event simulation engine shared by all scheduling policies. Process arrivals come from a
+ * stream of the processes pre-sorted by arrival time, and the other events (burst completion, quantum expiry and
+ * policy timers) are kept in a min-heap. The engine jumps from one event to the next, so the cost of a simulation grows with the number
+ * of events, at O(log n) each, rather than with the simulated time.
+ * A specific scheduler only implements the ready queue of its policy through init_ready, add_ready, pick_next,
+ * time_slice and, for preemptive policies, should_preempt or revise_slice. Policies that adapt over time can also use
+ * on_quantum_expiry and timers.
+ * Simulated time is 64-bit, so a workload whose bursts add up past 2^32 time units does not wrap. Bursts, arrival
+ * times and time slices stay 32-bit: the loader rejects values that do not fit, and a slice never exceeds a burst.
+ * The engine can also simulate several CPU cores (SMP). Each core has its own ready queue of the policy, an arriving
+ * process goes to the least loaded core, and a process stays on its core unless a balancer migrates it.
  */
 class Scheduler {
 public:
+    /**
+     * @brief The load balancers of the SMP mode. They can be combined with a bitwise or.
+     */
+    enum Balancer {
+        // Processes never migrate
+        BALANCE_NONE = 0,
+        // An idle core with an empty ready queue takes the next process of the core with the longest ready queue
+        BALANCE_STEAL = 1,
+        // At the multiples of a period, processes are pushed from the longest ready queues to the shortest ones until
+        // their lengths differ by at most one. Only unbalanced queues cost an event.
+        BALANCE_PUSH = 2
+    };
+
+protected:
+    /**
+     * @brief The kinds of events kept in the event heap. At equal times, they are handled in this order,
+     *        after the arrivals of that time, so a process arriving at the moment another one is preempted is queued
+     *        first.
+     */
+    enum EventType { COMPLETION = 0, QUANTUM_EXPIRY = 1, TIMER = 2, BALANCE = 3 };
+
+    /**
+     * @brief A simulation event: the end of the time slice of a dispatched process, a policy timer, or a push
+     *        migration at a multiple of its period.
+     */
+    struct Event {
+        // Simulated time of the event
+        uint64_t time;
+        // Kind of event
+        EventType type;
+        // Index of the process in the process list, or -1 for a timer
+        int proc;
+        // The core that runs the process
+        int core;
+        // Sequence number of the dispatch that scheduled the event. An event whose dispatch was cut short by a
+        // preemption is stale and is skipped.
+        unsigned long long seq;
+
+        // Ordering for the min-heap: earliest time, then event type, then dispatch order
+        bool operator>(const Event &other) const {
+            if (time != other.time) return time > other.time;
+            if (type != other.type) return type > other.type;
+            return seq > other.seq;
+        }
+    };
+
+    // The process table of the simulation, owned by the caller of init
+    const ProcessTable *table = nullptr;
+    // The compact records of the processes in the table: the only process data read by the hot loop
+    const ProcessRecord *processes = nullptr;
+    // The number of processes in the simulation
+    size_t num_processes = 0;
+    // Remaining CPU burst of each process, at most its 32-bit burst time
+    vector<unsigned int> remaining;
+    // Time at which each process finished, valid once it has completed
+    vector<uint64_t> completion_time;
+    // Indexes of the processes sorted by arrival time (ties in list order): the arrival stream
+    vector<int> arrival_order;
+    // Whether simulate prints a line for every dispatch
+    bool verbose = true;
+    // The trace that receives every run of a process, or nullptr
+    TraceWriter *trace = nullptr;
+    // The number of simulated CPU cores
+    int num_cores = 1;
+    // The load balancers of the SMP mode, a combination of Balancer flags
+    int balancer = BALANCE_NONE;
+    // The period of the push migration
+    unsigned int balance_period = 0;
+
+    /**
+     * @brief Create the empty ready queues of the policy, one per core. It is called at the end of init, when the
+     *        processes are known.
+     * @param cores The number of cores.
+     */
+    virtual void init_ready(int cores) = 0;
+
+    /**
+     * @brief Add a process to the ready queue of the policy on a core. It is called when a process arrives, when
+     *        its time slice expires before its burst is finished, and when it migrates.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
+     */
+    virtual void add_ready(int proc, int core) = 0;
+
+    /**
+     * @brief Remove the next process to run from the ready queue of the policy on a core.
+     * @param core The core.
+     * @return The index of the process in the process list, or -1 if the ready queue is empty.
+     */
+    virtual int pick_next(int core) = 0;
+
+    /**
+     * @brief The length of the time slice to give to a process that has just been picked.
+     *        The default lets the process run until its burst is finished.
+     * @param proc The index of the process in the process list.
+     * @param core The core that runs the process.
+     * @return The time slice; it is capped to the remaining burst of the process.
+     */
+    virtual unsigned int time_slice(int proc, int core) { return remaining[proc]; }
+
+    /**
+     * @brief Decide whether newly queued processes preempt the running process of a core. It is called after the
+     *        arrivals and migrations of a time step have been added to the ready queue of the core. The default never
+     *        preempts.
+     * @param running The index of the running process.
+     * @param running_left The remaining burst of the running process at the current time.
+     * @param core The core.
+     * @return true to put the running process back into the ready queue and dispatch again.
+     */
+    virtual bool should_preempt(int running, unsigned int running_left, int core) { return false; }
+
+    /**
+     * @brief Let the policy shorten the time slice of the running process of a core. It is called after
+     *        should_preempt, when newly queued processes did not preempt the running process. The default keeps the
+     *        slice.
+     * @param running The index of the running process.
+     * @param ran How long the running process has run in its current slice.
+     * @param core The core.
+     * @return The new length of the slice from its start, or 0 to keep it. It only applies if it is longer than ran
+     *         and shorter than the current slice.
+     */
+    virtual unsigned int revise_slice(int running, unsigned int ran, int core) { return 0; }
+
+    /**
+     * @brief Notify the policy that a process used up its whole time slice. It is called just before the process is
+     *        put back into the ready queue with add_ready. The default does nothing.
+     * @param proc The index of the process in the process list.
+     * @param now The current time.
+     */
+    virtual void on_quantum_expiry(int proc, uint64_t now) {}
+
+    /**
+     * @brief Handle a timer set with schedule_timer. It is called after the other events of the same time, and the
+     *        running processes may then be preempted through should_preempt. The default does nothing.
+     * @param now The current time.
+     */
+    virtual void on_timer(uint64_t now) {}
+
+    /**
+     * @brief Set a timer that calls on_timer at the given time. Timers left when all processes have finished are
+     *        discarded. It can be called from init, after the base class init, from on_quantum_expiry and from
+     *        on_timer. A timer set for the current time from on_quantum_expiry fires in the same step.
+     * @param time The time of the timer.
+     */
+    void schedule_timer(uint64_t time);
+
+private:
+    /**
+     * @brief The state and statistics of a simulated core.
+     */
+    struct Core {
+        // Index of the process on the core, or -1 if the core is idle
+        int running = -1;
+        // Length of the time slice of the running process
+        unsigned int slice = 0;
+        // Time at which the running process was dispatched
+        uint64_t start = 0;
+        // Sequence number of the current dispatch
+        unsigned long long dispatch = 0;
+        // Number of processes in the ready queue of the core
+        size_t queued = 0;
+        // Total time spent running processes
+        unsigned long long busy = 0;
+        // Number of processes migrated to and from the core
+        unsigned long long migrations_in = 0;
+        unsigned long long migrations_out = 0;
+        // The last process dispatched on the core, or -1
+        int last = -1;
+        // Number of dispatches of a different process than the previous one
+        unsigned long long context_switches = 0;
+    };
+
+    // Pending events, earliest first
+    priority_queue<Event, vector<Event>, greater<Event>> events;
+    // The simulated cores
+    vector<Core> cores;
+    // Time at which the last process finished
+    uint64_t makespan = 0;
+    // Whether a BALANCE event is pending
+    bool balance_armed = false;
+
+    // Whether the schedule is printed: in verbose mode, for at most PRINT_LIMIT processes
+    bool print_schedule = true;
+
+    /**
+     * @brief Record that a process ran on a core, printing it or writing it to the trace.
+     * @param proc The index of the process in the process list.
+     * @param start The time at which the run started.
+     * @param duration The length of the run.
+     * @param core The core.
+     */
+    void record_run(int proc, uint64_t start, unsigned int duration, int core);
+
+    /**
+     * @brief Add a process to the ready queue of a core.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
+     */
+    void enqueue(int proc, int core);
+
+    /**
+     * @brief Remove the next process from the ready queue of a core.
+     * @param core The core.
+     * @return The index of the process, or -1 if the ready queue is empty.
+     */
+    int dequeue(int core);
+
+    /**
+     * @brief Move the next process of the ready queue of a core to the ready queue of another core.
+     * @param from The core that gives the process.
+     * @param to The core that receives the process.
+     * @return The index of the process, or -1 if the ready queue of the first core is empty.
+     */
+    int migrate(int from, int to);
+
+    /**
+     * @brief Find the core that should receive an arriving process: the one with the fewest ready and running
+     *        processes, the lowest index first.
+     * @return The core.
+     */
+    int least_loaded_core() const;
+
+    /**
+     * @brief Find the core with the longest ready queue, the lowest index first.
+     * @return The core.
+     */
+    int longest_queue_core() const;
+
+    /**
+     * @brief Check whether the lengths of two ready queues differ by more than one.
+     * @return true if push migration would move a process.
+     */
+    bool unbalanced() const;
+
+    /**
+     * @brief Push processes from the longest ready queues to the shortest ones until their lengths differ by at most
+     *        one.
+     * @param changed Set for the cores that received a process.
+     */
+    void push_balance(vector<char> &changed);
+
+    /**
+     * @brief Run a process on an idle core for its time slice.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
+     * @param now The current time.
+     * @param seq The sequence number of the dispatch.
+     */
+    void dispatch(int proc, int core, uint64_t now, unsigned long long seq);
+
+public:
+    // The largest number of processes for which the schedule and the results of every process are printed.
+    // Larger runs only print the averages; their schedule can be written to a trace instead.
+    static const size_t PRINT_LIMIT = 1000;
+
     /**
      * @brief Construct a new Scheduler object
      */
@@ -29,21 +298,90 @@ public:
     virtual ~Scheduler() {}
     /**
      * @brief This function is called once before the simulation starts.
-     *        It is used to initialize the scheduler.
-     * @param process_list The list of processes in the simulation.
+     *        It is used to initialize the scheduler. The scheduler keeps a view of the table rather than a copy, so
+     *        several schedulers can simulate the same table; it must outlive the calls to simulate and print_results.
+     * @param process_table The processes in the simulation.
      */
-    virtual void init(std::vector<PCB>& process_list) = 0;
+    virtual void init(const ProcessTable& process_table);
 
     /**
      * @brief This function is called once after the simulation ends.
      *        It is used to print out the results of the simulation.
      */
-    virtual void print_results() = 0;
+    virtual void print_results();
 
 
     /**
      * @brief This function simulates the scheduling of processes in the ready queue.
      *        It stops when all processes are finished.
      */
-    virtual void simulate() = 0;
-};
\ No newline at end of file
+    virtual void simulate();
+
+    /**
+     * @brief Choose the number of simulated CPU cores and their load balancers. It must be called before init.
+     *        One core, the default, is the classic single CPU simulation.
+     * @param cores The number of cores, at least 1.
+     * @param balancer The load balancers, a combination of Balancer flags.
+     * @param period The period of the push migration, used with BALANCE_PUSH.
+     */
+    void set_cores(int cores, int balancer = BALANCE_STEAL, unsigned int period = 100);
+
+    /**
+     * @brief Get the utilisation of a core, valid after simulate.
+     * @param core The core.
+     * @return The fraction of the time, until the last process finished, that the core spent running processes.
+     */
+    double utilisation(int core) const;
+
+    /**
+     * @brief Get the average utilisation of the cores, valid after simulate.
+     * @return The average utilisation.
+     */
+    double average_utilisation() const;
+
+    /**
+     * @brief Get the total number of migrations, valid after simulate.
+     * @return The number of processes moved from one core to another.
+     */
+    unsigned long long migrations() const;
+
+    /**
+     * @brief Get the total number of context switches, valid after simulate.
+     * @return The number of times a core started running a different process than the one it ran before.
+     */
+    unsigned long long context_switches() const;
+
+    /**
+     * @brief Choose whether simulate prints a line for every process dispatch.
+     * @param verbose true to print the schedule, false to run quietly, e.g. when comparing many policies.
+     */
+    void set_verbose(bool verbose) { this->verbose = verbose; }
+
+    /**
+     * @brief Write every run of a process to a trace during simulate.
+     * @param trace The open trace, which must outlive simulate, or nullptr to stop tracing.
+     */
+    void set_trace(TraceWriter *trace) { this->trace = trace; }
+
+    /**
+     * @brief Get the average turn-around time of the processes, valid after simulate.
+     * @return The average turn-around time, or 0 if there are no processes.
+     */
+    double average_turnaround() const;
+
+    /**
+     * @brief Get the average waiting time of the processes, valid after simulate.
+     * @return The average waiting time, or 0 if there are no processes.
+     */
+    double average_waiting() const;
+};
+
+/**
+ * @brief Remove a "-c <cores>" option from the command line, so the drivers can keep parsing their positional
+ *        arguments unchanged.
+ * @param argc The number of arguments; it is reduced when the option is found.
+ * @param argv The arguments; the option is removed from them.
+ * @param cores Receives the number of cores, or is left unchanged when there is no such option.
+ * @return false if -c is the last argument or its value is not a number from 1 to INT_MAX.
+ */
+bool take_cores_option(int &argc, char *argv[], int &cores);
@@ -10,5 +10,43 @@
 
 #include "scheduler_fcfs.h"
 
-// TODO: add implementation of SchedulerFCFS constructor, destrcutor and 
-// member functions init, print_results, and simulate here
+/**
+ * @brief Construct a new SchedulerFCFS object
+ */
+SchedulerFCFS::SchedulerFCFS() {}
+
+/**
+ * @brief Destroy the SchedulerFCFS object
+ */
+SchedulerFCFS::~SchedulerFCFS() {}
+
+/**
+ * @brief Create an empty ready queue for each core.
+ * @param cores The number of cores.
+ */
+void SchedulerFCFS::init_ready(int cores) {
+    ready_queues.assign(cores, queue<int>());
+}
+
+/**
+ * @brief Add a process to the back of the FIFO ready queue.
+ * @param proc The index of the process in the process list.
+ * @param core The core.
+ */
+void SchedulerFCFS::add_ready(int proc, int core) {
+    ready_queues[core].push(proc);
+}
+
+/**
+ * @brief Remove the process that has been waiting the longest.
+ * @param core The core.
+ * @return The index of the process, or -1 if the ready queue is empty.
+ */
+int SchedulerFCFS::pick_next(int core) {
+    if (ready_queues[core].empty()) {
+        return -1;
+    }
+    int proc = ready_queues[core].front();
+    ready_queues[core].pop();
+    return proc;
+}
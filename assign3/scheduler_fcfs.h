@@ -17,35 +17,38 @@
  */
 class SchedulerFCFS : public Scheduler {
 private:
-    // TODO: add necessary member variables here for your implementation
+    // Processes ready to run on each core, in order of arrival
+    vector<queue<int>> ready_queues;
 
-public:
+protected:
     /**
-     * @brief Construct a new SchedulerFCFS object
+     * @brief Create an empty ready queue for each core.
+     * @param cores The number of cores.
      */
-    SchedulerFCFS();
+    void init_ready(int cores) override;
+
     /**
-     * @brief Destroy the SchedulerFCFS object
+     * @brief Add a process to the back of the FIFO ready queue.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
      */
-    ~SchedulerFCFS() override;
+    void add_ready(int proc, int core) override;
 
     /**
-     * @brief This function is called once before the simulation starts.
-     *        It is used to initialize the scheduler.
-     * @param process_list The list of processes in the simulation.
+     * @brief Remove the process that has been waiting the longest.
+     * @param core The core.
+     * @return The index of the process, or -1 if the ready queue is empty.
      */
-    void init(std::vector<PCB>& process_list) override;
+    int pick_next(int core) override;
 
+public:
     /**
-     * @brief This function is called once after the simulation ends.
-     *        It is used to print out the results of the simulation.
+     * @brief Construct a new SchedulerFCFS object
      */
-    void print_results() override;
-
+    SchedulerFCFS();
     /**
-     * @brief This function simulates the scheduling of processes in the ready queue.
-     *        It stops when all processes are finished.
+     * @brief Destroy the SchedulerFCFS object
      */
-    void simulate() override;
+    ~SchedulerFCFS() override;
 };
 #endif //ASSIGN3_SCHEDULER_FCFS_H
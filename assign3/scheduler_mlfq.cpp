@@ -0,0 +1,163 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file scheduler_mlfq.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief This Scheduler class implements the multi-level feedback queue (MLFQ) scheduling algorithm.
+ * @version 0.1
+ */
+
+#include "scheduler_mlfq.h"
+
+/**
+ * @brief Construct a new SchedulerMLFQ object
+ * @param quanta The time quantum of each level, from the highest priority level; 0 means no limit. Levels beyond
+ *        MAX_LEVELS are ignored, and an empty list gives a single level without a quantum.
+ * @param boost_period The period of the priority boost; 0 disables it.
+ */
+SchedulerMLFQ::SchedulerMLFQ(const vector<unsigned int> &quanta, unsigned int boost_period)
+    : quanta(quanta), boost_period(boost_period) {
+    if (this->quanta.empty()) {
+        this->quanta.push_back(0);
+    }
+    if (this->quanta.size() > MAX_LEVELS) {
+        this->quanta.resize(MAX_LEVELS);
+    }
+}
+
+/**
+ * @brief Destroy the SchedulerMLFQ object
+ */
+SchedulerMLFQ::~SchedulerMLFQ() {}
+
+/**
+ * @brief This function is called once before the simulation starts.
+ *        The base class init discards the timers left by a previous simulation, so no boost is set.
+ * @param process_table The processes in the simulation.
+ */
+void SchedulerMLFQ::init(const ProcessTable& process_table) {
+    Scheduler::init(process_table);
+    boost_armed = false;
+}
+
+/**
+ * @brief Create the empty levels of each core. All processes start at level 0.
+ * @param cores The number of cores.
+ */
+void SchedulerMLFQ::init_ready(int cores) {
+    head.assign(cores * quanta.size(), -1);
+    tail.assign(cores * quanta.size(), -1);
+    next.assign(num_processes, -1);
+    occupied.assign(cores, 0);
+    level.assign(num_processes, 0);
+    level_epoch.assign(num_processes, 0);
+    epoch = 0;
+}
+
+/**
+ * @brief Add a process to the back of the queue of its current level.
+ * @param proc The index of the process in the process list.
+ * @param core The core.
+ */
+void SchedulerMLFQ::add_ready(int proc, int core) {
+    int lvl = level_of(proc);
+    size_t q = core * quanta.size() + lvl;
+    next[proc] = -1;
+    if (tail[q] == -1) {
+        head[q] = proc;
+        occupied[core] |= uint64_t(1) << lvl;
+    } else {
+        next[tail[q]] = proc;
+    }
+    tail[q] = proc;
+}
+
+/**
+ * @brief Remove the front process of the highest non-empty level.
+ * @param core The core.
+ * @return The index of the process, or -1 if all levels are empty.
+ */
+int SchedulerMLFQ::pick_next(int core) {
+    if (occupied[core] == 0) {
+        return -1;
+    }
+    // The highest priority non-empty level is the lowest set bit
+    int lvl = __builtin_ctzll(occupied[core]);
+    size_t q = core * quanta.size() + lvl;
+    int proc = head[q];
+    head[q] = next[proc];
+    if (head[q] == -1) {
+        tail[q] = -1;
+        occupied[core] &= ~(uint64_t(1) << lvl);
+    }
+    return proc;
+}
+
+/**
+ * @brief A process runs for at most the quantum of its level.
+ * @param proc The index of the process in the process list.
+ * @param core The core that runs the process.
+ * @return The quantum of the level of the process.
+ */
+unsigned int SchedulerMLFQ::time_slice(int proc, int core) {
+    return quanta[level_of(proc)];
+}
+
+/**
+ * @brief Preempt the running process when a process is ready at a higher level.
+ * @param running The index of the running process.
+ * @param running_left The remaining burst of the running process at the current time.
+ * @param core The core.
+ * @return true if the running process must be preempted.
+ */
+bool SchedulerMLFQ::should_preempt(int running, unsigned int running_left, int core) {
+    return occupied[core] != 0 && __builtin_ctzll(occupied[core]) < level_of(running);
+}
+
+/**
+ * @brief Move a process that used up its quantum down one level.
+ *        Boosts happen at the multiples of the boost period, but while every process is at level 0 a boost changes
+ *        nothing, so the timer is only set for the first multiple not before a process moves down.
+ * @param proc The index of the process in the process list.
+ * @param now The current time.
+ */
+void SchedulerMLFQ::on_quantum_expiry(int proc, uint64_t now) {
+    int lvl = level_of(proc);
+    level[proc] = lvl + 1 < (int)quanta.size() ? lvl + 1 : lvl;
+    level_epoch[proc] = epoch;
+    if (boost_period > 0 && !boost_armed && level[proc] > 0) {
+        uint64_t boost = (now + boost_period - 1) / boost_period * boost_period;
+        schedule_timer(boost > 0 ? boost : boost_period);
+        boost_armed = true;
+    }
+}
+
+/**
+ * @brief Boost all processes back to level 0. The next boost is set when a process moves down again.
+ *        On each core, the lists of the lower levels are appended to level 0 in priority order, so the relative order
+ *        of the ready processes is kept, and the new epoch resets the level of every process, including the running
+ *        ones.
+ * @param now The current time.
+ */
+void SchedulerMLFQ::on_timer(uint64_t now) {
+    size_t num_levels = quanta.size();
+    for (size_t core = 0; core < occupied.size(); core++) {
+        size_t first = core * num_levels;
+        int last = tail[first];
+        for (size_t q = first + 1; q < first + num_levels; q++) {
+            if (head[q] == -1) {
+                continue;
+            }
+            if (last == -1) {
+                head[first] = head[q];
+            } else {
+                next[last] = head[q];
+            }
+            last = tail[q];
+            head[q] = tail[q] = -1;
+        }
+        tail[first] = last;
+        occupied[core] = last == -1 ? 0 : 1;
+    }
+    epoch++;
+    boost_armed = false;
+}
@@ -0,0 +1,136 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file scheduler_mlfq.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief This Scheduler class implements the multi-level feedback queue (MLFQ) scheduling algorithm.
+ * @version 0.1
+ */
+
+#ifndef ASSIGN3_SCHEDULER_MLFQ_H
+#define ASSIGN3_SCHEDULER_MLFQ_H
+
+#include <cstdint>
+#include "scheduler.h"
+
+/**
+ * @brief A multi-level feedback queue. Level 0 has the highest priority.
+ *        - A new process enters level 0.
+ *        - A process that uses up the quantum of its level moves down one level. A quantum of 0 lets a process run
+ *          until its burst is finished, which is usual for the last level.
+ *        - A process that arrives at a higher level than the running process preempts it. The preempted process
+ *          stays at its level.
+ *        - Every boost period, all processes move back to level 0, so long-running processes do not starve. The
+ *          boost timer is only set while a process is below level 0, so a long burst costs no boost events.
+ *        With several cores, each core has its own levels.
+ *        Each level is a FIFO list linked through a per-process next array, and an occupancy bitmap has one bit per
+ *        non-empty level, so picking the next process is a count-trailing-zeros and a pop, in constant time at any
+ *        queue depth. A boost is constant time too: it splices the lists of all levels onto level 0, and it bumps an
+ *        epoch number so that every level recorded before the boost reads as 0.
+ */
+class SchedulerMLFQ : public Scheduler {
+public:
+    // The largest supported number of levels: one bit of the occupancy bitmap per level
+    static const size_t MAX_LEVELS = 64;
+
+private:
+    // The time quantum of each level; 0 means no limit
+    vector<unsigned int> quanta;
+    // The period of the priority boost; 0 disables it
+    unsigned int boost_period;
+    // The first and last ready process of each level of each core, at core * levels + level, or -1 when the level
+    // is empty
+    vector<int> head, tail;
+    // The next ready process in the same level, or -1 at the end of the level
+    vector<int> next;
+    // For each core, bit i is set when level i has ready processes
+    vector<uint64_t> occupied;
+    // The level of each process, valid when its level_epoch is the current epoch; otherwise the level is 0
+    vector<int> level;
+    // The epoch in which the level of each process was set
+    vector<unsigned int> level_epoch;
+    // The number of boosts so far
+    unsigned int epoch = 0;
+    // Whether the next boost is set
+    bool boost_armed = false;
+
+    /**
+     * @brief Get the current level of a process.
+     * @param proc The index of the process in the process list.
+     * @return The level; processes whose level was set before the last boost are at level 0.
+     */
+    int level_of(int proc) const { return level_epoch[proc] == epoch ? level[proc] : 0; }
+
+protected:
+    /**
+     * @brief Create the empty levels of each core. All processes start at level 0.
+     * @param cores The number of cores.
+     */
+    void init_ready(int cores) override;
+
+    /**
+     * @brief Add a process to the back of the queue of its current level.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
+     */
+    void add_ready(int proc, int core) override;
+
+    /**
+     * @brief Remove the front process of the highest non-empty level.
+     * @param core The core.
+     * @return The index of the process, or -1 if all levels are empty.
+     */
+    int pick_next(int core) override;
+
+    /**
+     * @brief A process runs for at most the quantum of its level.
+     * @param proc The index of the process in the process list.
+     * @param core The core that runs the process.
+     * @return The quantum of the level of the process.
+     */
+    unsigned int time_slice(int proc, int core) override;
+
+    /**
+     * @brief Preempt the running process when a process is ready at a higher level.
+     * @param running The index of the running process.
+     * @param running_left The remaining burst of the running process at the current time.
+     * @param core The core.
+     * @return true if the running process must be preempted.
+     */
+    bool should_preempt(int running, unsigned int running_left, int core) override;
+
+    /**
+     * @brief Move a process that used up its quantum down one level, and set the next boost if it is not set.
+     * @param proc The index of the process in the process list.
+     * @param now The current time.
+     */
+    void on_quantum_expiry(int proc, uint64_t now) override;
+
+    /**
+     * @brief Boost all processes back to level 0.
+     * @param now The current time.
+     */
+    void on_timer(uint64_t now) override;
+
+public:
+    /**
+     * @brief Construct a new SchedulerMLFQ object
+     * @param quanta The time quantum of each level, from the highest priority level; 0 means no limit. There must
+     *        be between 1 and MAX_LEVELS levels.
+     * @param boost_period The period of the priority boost; 0 disables it.
+     */
+    SchedulerMLFQ(const vector<unsigned int> &quanta, unsigned int boost_period = 0);
+
+    /**
+     * @brief Destroy the SchedulerMLFQ object
+     */
+    ~SchedulerMLFQ() override;
+
+    /**
+     * @brief This function is called once before the simulation starts.
+     *        No boost is set until a process moves below level 0.
+     * @param process_table The processes in the simulation.
+     */
+    void init(const ProcessTable& process_table) override;
+};
+
+#endif //ASSIGN3_SCHEDULER_MLFQ_H
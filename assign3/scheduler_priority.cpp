@@ -11,5 +11,56 @@
 
 #include "scheduler_priority.h"
 
-// TODO: add implementation of SchedulerPriority constructor, destrcutor and 
-// member functions init, print_results, and simulate here
\ No newline at end of file
+/**
+ * @brief Construct a new SchedulerPriority object
+ * @param preemptive Whether a newly arrived process may preempt the running one.
+ */
+SchedulerPriority::SchedulerPriority(bool preemptive) : preemptive(preemptive) {}
+
+/**
+ * @brief Destroy the SchedulerPriority object
+ */
+SchedulerPriority::~SchedulerPriority() {}
+
+/**
+ * @brief Create an empty ready queue for each core.
+ * @param cores The number of cores.
+ */
+void SchedulerPriority::init_ready(int cores) {
+    ready_queues.assign(cores, ReadyQueue());
+}
+
+/**
+ * @brief Add a process to the ready queue, keyed by its priority.
+ * @param proc The index of the process in the process list.
+ * @param core The core.
+ */
+void SchedulerPriority::add_ready(int proc, int core) {
+    ready_queues[core].push(make_pair(-(long long)processes[proc].priority, proc));
+}
+
+/**
+ * @brief Remove the ready process with the highest priority.
+ * @param core The core.
+ * @return The index of the process, or -1 if the ready queue is empty.
+ */
+int SchedulerPriority::pick_next(int core) {
+    if (ready_queues[core].empty()) {
+        return -1;
+    }
+    int proc = ready_queues[core].top().second;
+    ready_queues[core].pop();
+    return proc;
+}
+
+/**
+ * @brief In preemptive mode, preempt the running process when a newly arrived process has a higher priority than the
+ *        running one.
+ * @param running The index of the running process.
+ * @param running_left The remaining burst of the running process at the current time.
+ * @param core The core.
+ * @return true if the running process must be preempted.
+ */
+bool SchedulerPriority::should_preempt(int running, unsigned int running_left, int core) {
+    return preemptive && !ready_queues[core].empty() && -ready_queues[core].top().first > (long long)processes[running].priority;
+}
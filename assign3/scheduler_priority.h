@@ -16,38 +16,56 @@
 
 class SchedulerPriority : public Scheduler {
 private:
-    // TODO: add necessary member variables here for your implementation
+    // Whether arrivals preempt the running process
+    bool preemptive;
+    // A ready queue ordered by highest priority first (ties by arrival order).
+    // The key is (-priority, index) so that the min-heap gives the highest priority.
+    typedef priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<pair<long long, int>>>
+        ReadyQueue;
+    // Processes ready to run on each core
+    vector<ReadyQueue> ready_queues;
 
-public:
+protected:
     /**
-     * @brief Construct a new SchedulerPriority object
+     * @brief Create an empty ready queue for each core.
+     * @param cores The number of cores.
      */
-    SchedulerPriority();
+    void init_ready(int cores) override;
 
     /**
-     * @brief Destroy the SchedulerPriority object
+     * @brief Add a process to the ready queue, keyed by its priority.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
      */
-    ~SchedulerPriority() override;
+    void add_ready(int proc, int core) override;
 
     /**
-     * @brief This function is called once before the simulation starts.
-     *        It is used to initialize the scheduler.
-     * @param process_list The list of processes in the simulation.
+     * @brief Remove the ready process with the highest priority.
+     * @param core The core.
+     * @return The index of the process, or -1 if the ready queue is empty.
      */
-    void init(std::vector<PCB>& process_list) override;
+    int pick_next(int core) override;
 
     /**
-     * @brief This function is called once after the simulation ends.
-     *        It is used to print out the results of the simulation.
+     * @brief In preemptive mode, preempt the running process when a newly arrived process has a higher priority than the running one.
+     * @param running The index of the running process.
+     * @param running_left The remaining burst of the running process at the current time.
+     * @param core The core.
+     * @return true if the running process must be preempted.
      */
-    void print_results() override;
+    bool should_preempt(int running, unsigned int running_left, int core) override;
 
+public:
     /**
-     * @brief This function simulates the scheduling of processes in the ready queue.
-     *        It stops when all processes are finished.
+     * @brief Construct a new SchedulerPriority object
+     * @param preemptive Whether a newly arrived process may preempt the running one.
      */
-    void simulate() override;
+    explicit SchedulerPriority(bool preemptive = false);
 
+    /**
+     * @brief Destroy the SchedulerPriority object
+     */
+    ~SchedulerPriority() override;
 };
 
 
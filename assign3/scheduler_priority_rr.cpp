@@ -10,5 +10,91 @@
 
 #include "scheduler_priority_rr.h"
 
-// TODO: add implementation of SchedulerPriorityRR constructor, destrcutor and 
-// member functions init, print_results, and simulate here
+/**
+ * @brief Construct a new SchedulerPriorityRR object
+ * @param time_quantum The time quantum of the round robin; a non-positive value defaults to 10.
+ */
+SchedulerPriorityRR::SchedulerPriorityRR(int time_quantum) {
+    this->time_quantum = time_quantum > 0 ? time_quantum : 10;
+    insert_count = 0;
+}
+
+/**
+ * @brief Destroy the SchedulerPriorityRR object
+ */
+SchedulerPriorityRR::~SchedulerPriorityRR() {}
+
+/**
+ * @brief Create an empty ready queue for each core.
+ * @param cores The number of cores.
+ */
+void SchedulerPriorityRR::init_ready(int cores) {
+    ready_queues.assign(cores, ReadyQueue());
+}
+
+/**
+ * @brief Add a process to the back of the round robin of its priority.
+ * The processes of a priority are ordered by their insertion sequence number, so a process whose quantum
+ * expired goes behind the others of its priority.
+ * @param proc The index of the process in the process list.
+ * @param core The core.
+ */
+void SchedulerPriorityRR::add_ready(int proc, int core) {
+    ready_queues[core].push(make_tuple(-(long long)processes[proc].priority, insert_count, proc));
+    insert_count++;
+}
+
+/**
+ * @brief Remove the next process of the highest priority.
+ * @param core The core.
+ * @return The index of the process, or -1 if the ready queue is empty.
+ */
+int SchedulerPriorityRR::pick_next(int core) {
+    if (ready_queues[core].empty()) {
+        return -1;
+    }
+    int proc = get<2>(ready_queues[core].top());
+    ready_queues[core].pop();
+    return proc;
+}
+
+/**
+ * @brief A process runs for one time quantum when another process of its priority is ready, like in RR, and
+ *        otherwise for its whole burst.
+ * @param proc The index of the process in the process list.
+ * @param core The core that runs the process.
+ * @return The time slice.
+ */
+unsigned int SchedulerPriorityRR::time_slice(int proc, int core) {
+    if (equal_priority_ready(proc, core)) {
+        return time_quantum;
+    }
+    return remaining[proc];
+}
+
+/**
+ * @brief When a process of the same priority is queued while a process runs its whole burst, cut the run at the
+ *        end of its current quantum, so the round robin starts from there.
+ * @param running The index of the running process.
+ * @param ran How long the running process has run in its current slice.
+ * @param core The core.
+ * @return The end of the current quantum, or 0 to keep the slice.
+ */
+unsigned int SchedulerPriorityRR::revise_slice(int running, unsigned int ran, int core) {
+    if (!equal_priority_ready(running, core)) {
+        return 0;
+    }
+    return (ran / time_quantum + 1) * time_quantum;
+}
+
+/**
+ * @brief Check whether the next process of a ready queue has the same priority as a process.
+ * The ready queue gives the highest priority first, so no process of that priority is ready otherwise.
+ * @param proc The index of the process in the process list.
+ * @param core The core.
+ * @return true if a process of the same priority is ready.
+ */
+bool SchedulerPriorityRR::equal_priority_ready(int proc, int core) const {
+    return !ready_queues[core].empty() &&
+           processes[get<2>(ready_queues[core].top())].priority == processes[proc].priority;
+}
@@ -11,42 +11,81 @@
 #ifndef ASSIGN3_SCHEDULER_PRIORITY_RR_H
 #define ASSIGN3_SCHEDULER_PRIORITY_RR_H
 
+#include <tuple>
 #include "scheduler.h"
 
 class SchedulerPriorityRR : public Scheduler {
 private:
-    // TODO: add necessary member variables here for your implementation
+    // The time quantum of the round robin among processes of equal priority
+    unsigned int time_quantum;
+    // A ready queue ordered by highest priority first and in round robin order within a priority.
+    // The entries are (-priority, sequence number of the insertion, index) so that the min-heap gives the highest
+    // priority, and the longest waiting process among equal priorities.
+    typedef priority_queue<tuple<long long, long long, int>, vector<tuple<long long, long long, int>>,
+                           greater<tuple<long long, long long, int>>> ReadyQueue;
+    // Processes ready to run on each core
+    vector<ReadyQueue> ready_queues;
+    // Number of insertions into the ready queue, used as the round robin sequence number
+    long long insert_count;
 
-public:
     /**
-     * @brief Construct a new SchedulerPriority object
+     * @brief Check whether the next process of a ready queue has the same priority as a process.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
+     * @return true if a process of the same priority is ready.
      */
-    SchedulerPriorityRR(int time_quantum = 10);
+    bool equal_priority_ready(int proc, int core) const;
 
+protected:
     /**
-     * @brief Destroy the SchedulerPriority object
+     * @brief Create an empty ready queue for each core.
+     * @param cores The number of cores.
      */
-    ~SchedulerPriorityRR() override;
+    void init_ready(int cores) override;
+
+    /**
+     * @brief Add a process to the back of the round robin of its priority.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
+     */
+    void add_ready(int proc, int core) override;
+
+    /**
+     * @brief Remove the next process of the highest priority.
+     * @param core The core.
+     * @return The index of the process, or -1 if the ready queue is empty.
+     */
+    int pick_next(int core) override;
 
     /**
-     * @brief This function is called once before the simulation starts.
-     *        It is used to initialize the scheduler.
-     * @param process_list The list of processes in the simulation.
+     * @brief A process runs for one time quantum when another process of its priority is ready, like in RR, and
+     *        otherwise for its whole burst.
+     * @param proc The index of the process in the process list.
+     * @param core The core that runs the process.
+     * @return The time slice.
      */
-    void init(std::vector<PCB>& process_list) override;
+    unsigned int time_slice(int proc, int core) override;
 
     /**
-     * @brief This function is called once after the simulation ends.
-     *        It is used to print out the results of the simulation.
+     * @brief Cut the whole-burst run of a process at the end of its current quantum when a process of the same
+     *        priority is queued.
+     * @param running The index of the running process.
+     * @param ran How long the running process has run in its current slice.
+     * @param core The core.
+     * @return The end of the current quantum, or 0 to keep the slice.
      */
-    void print_results() override;
+    unsigned int revise_slice(int running, unsigned int ran, int core) override;
 
+public:
     /**
-     * @brief This function simulates the scheduling of processes in the ready queue.
-     *        It stops when all processes are finished.
+     * @brief Construct a new SchedulerPriority object
      */
-    void simulate() override;
+    SchedulerPriorityRR(int time_quantum = 10);
 
+    /**
+     * @brief Destroy the SchedulerPriority object
+     */
+    ~SchedulerPriorityRR() override;
 };
 
 
@@ -11,5 +11,56 @@
 
 #include "scheduler_rr.h"
 
-// TODO: add implementation of SchedulerRR constructor, destrcutor and 
-// member functions init, print_results, and simulate here
\ No newline at end of file
+/**
+ * @brief Construct a new SchedulerRR object
+ * @param time_quantum The time quantum of the round robin; a non-positive value defaults to 10.
+ */
+SchedulerRR::SchedulerRR(int time_quantum) {
+    this->time_quantum = time_quantum > 0 ? time_quantum : 10;
+}
+
+/**
+ * @brief Destroy the SchedulerRR object
+ */
+SchedulerRR::~SchedulerRR() {}
+
+/**
+ * @brief Create an empty ready queue for each core.
+ * @param cores The number of cores.
+ */
+void SchedulerRR::init_ready(int cores) {
+    ready_queues.assign(cores, queue<int>());
+}
+
+/**
+ * @brief Add a process to the back of the round robin queue.
+ * @param proc The index of the process in the process list.
+ * @param core The core.
+ */
+void SchedulerRR::add_ready(int proc, int core) {
+    ready_queues[core].push(proc);
+}
+
+/**
+ * @brief Remove the process at the front of the round robin queue.
+ * @param core The core.
+ * @return The index of the process, or -1 if the ready queue is empty.
+ */
+int SchedulerRR::pick_next(int core) {
+    if (ready_queues[core].empty()) {
+        return -1;
+    }
+    int proc = ready_queues[core].front();
+    ready_queues[core].pop();
+    return proc;
+}
+
+/**
+ * @brief Every process runs for at most one time quantum at a time.
+ * @param proc The index of the process in the process list.
+ * @param core The core that runs the process.
+ * @return The time quantum.
+ */
+unsigned int SchedulerRR::time_slice(int proc, int core) {
+    return time_quantum;
+}
@@ -15,37 +15,50 @@
 
 class SchedulerRR : public Scheduler {
 private:
-    // TODO: add necessary member variables here for your implementation
+    // The time quantum of the round robin
+    unsigned int time_quantum;
+    // Processes ready to run on each core, in round robin order
+    vector<queue<int>> ready_queues;
 
-public:
+protected:
     /**
-     * @brief Construct a new SchedulerRR object
+     * @brief Create an empty ready queue for each core.
+     * @param cores The number of cores.
      */
-    SchedulerRR(int time_quantum = 10);
+    void init_ready(int cores) override;
 
     /**
-     * @brief Destroy the SchedulerRR object
+     * @brief Add a process to the back of the round robin queue.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
      */
-    ~SchedulerRR() override;
+    void add_ready(int proc, int core) override;
 
     /**
-     * @brief This function is called once before the simulation starts.
-     *        It is used to initialize the scheduler.
-     * @param process_list The list of processes in the simulation.
+     * @brief Remove the process at the front of the round robin queue.
+     * @param core The core.
+     * @return The index of the process, or -1 if the ready queue is empty.
      */
-    void init(std::vector<PCB>& process_list) override;
+    int pick_next(int core) override;
 
     /**
-     * @brief This function is called once after the simulation ends.
-     *        It is used to print out the results of the simulation.
+     * @brief Every process runs for at most one time quantum at a time.
+     * @param proc The index of the process in the process list.
+     * @param core The core that runs the process.
+     * @return The time quantum.
      */
-    void print_results() override;
+    unsigned int time_slice(int proc, int core) override;
 
+public:
     /**
-     * @brief This function simulates the scheduling of processes in the ready queue.
-     *        It stops when all processes are finished.
+     * @brief Construct a new SchedulerRR object
      */
-    void simulate() override;
+    SchedulerRR(int time_quantum = 10);
+
+    /**
+     * @brief Destroy the SchedulerRR object
+     */
+    ~SchedulerRR() override;
 };
 
 
@@ -10,5 +10,56 @@
 
 #include "scheduler_sjf.h"
 
-// TODO: add implementation of SchedulerSJF constructor, destrcutor and 
-// member functions init, print_results, and simulate here
+/**
+ * @brief Construct a new SchedulerSJF object
+ * @param preemptive Whether a newly arrived process may preempt the running one.
+ */
+SchedulerSJF::SchedulerSJF(bool preemptive) : preemptive(preemptive) {}
+
+/**
+ * @brief Destroy the SchedulerSJF object
+ */
+SchedulerSJF::~SchedulerSJF() {}
+
+/**
+ * @brief Create an empty ready queue for each core.
+ * @param cores The number of cores.
+ */
+void SchedulerSJF::init_ready(int cores) {
+    ready_queues.assign(cores, ReadyQueue());
+}
+
+/**
+ * @brief Add a process to the ready queue, keyed by its remaining CPU burst.
+ * @param proc The index of the process in the process list.
+ * @param core The core.
+ */
+void SchedulerSJF::add_ready(int proc, int core) {
+    ready_queues[core].push(make_pair(remaining[proc], proc));
+}
+
+/**
+ * @brief Remove the ready process with the shortest remaining CPU burst.
+ * @param core The core.
+ * @return The index of the process, or -1 if the ready queue is empty.
+ */
+int SchedulerSJF::pick_next(int core) {
+    if (ready_queues[core].empty()) {
+        return -1;
+    }
+    int proc = ready_queues[core].top().second;
+    ready_queues[core].pop();
+    return proc;
+}
+
+/**
+ * @brief In preemptive mode, preempt the running process when a newly arrived process has a shorter remaining burst
+ *        than the running one (SRTF).
+ * @param running The index of the running process.
+ * @param running_left The remaining burst of the running process at the current time.
+ * @param core The core.
+ * @return true if the running process must be preempted.
+ */
+bool SchedulerSJF::should_preempt(int running, unsigned int running_left, int core) {
+    return preemptive && !ready_queues[core].empty() && ready_queues[core].top().first < running_left;
+}
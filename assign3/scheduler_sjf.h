@@ -15,33 +15,54 @@
 
 class SchedulerSJF : public Scheduler {
 private:
-    // TODO: add necessary member variables here for your implementation
+    // Whether arrivals preempt the running process
+    bool preemptive;
+    // A ready queue ordered by shortest remaining CPU burst first (ties by list order).
+    // Without preemption the remaining burst of a ready process is its whole CPU burst.
+    typedef priority_queue<pair<unsigned int, int>, vector<pair<unsigned int, int>>, greater<pair<unsigned int, int>>>
+        ReadyQueue;
+    // Processes ready to run on each core
+    vector<ReadyQueue> ready_queues;
 
-public:
+protected:
     /**
-     * @brief Construct a new SchedulerSJF object
+     * @brief Create an empty ready queue for each core.
+     * @param cores The number of cores.
      */
-    SchedulerSJF();
+    void init_ready(int cores) override;
+
     /**
-     * @brief Destroy the SchedulerSJF object
+     * @brief Add a process to the ready queue, keyed by its remaining CPU burst.
+     * @param proc The index of the process in the process list.
+     * @param core The core.
      */
-    ~SchedulerSJF() override;
+    void add_ready(int proc, int core) override;
+
     /**
-     * @brief This function is called once before the simulation starts.
-     *        It is used to initialize the scheduler.
-     * @param process_list The list of processes in the simulation.
+     * @brief Remove the ready process with the shortest remaining CPU burst.
+     * @param core The core.
+     * @return The index of the process, or -1 if the ready queue is empty.
      */
-    void init(std::vector<PCB>& process_list) override;
+    int pick_next(int core) override;
+
     /**
-     * @brief This function is called once after the simulation ends.
-     *        It is used to print out the results of the simulation.
+     * @brief In preemptive mode, preempt the running process when a newly arrived process has a shorter remaining burst than the running one (SRTF).
+     * @param running The index of the running process.
+     * @param running_left The remaining burst of the running process at the current time.
+     * @param core The core.
+     * @return true if the running process must be preempted.
      */
-    void print_results() override;
+    bool should_preempt(int running, unsigned int running_left, int core) override;
 
+public:
+    /**
+     * @brief Construct a new SchedulerSJF object
+     * @param preemptive Whether a newly arrived process may preempt the running one.
+     */
+    explicit SchedulerSJF(bool preemptive = false);
     /**
-     * @brief This function simulates the scheduling of processes in the ready queue.
-     *        It stops when all processes are finished.
+     * @brief Destroy the SchedulerSJF object
      */
-    void simulate() override;
+    ~SchedulerSJF() override;
 };
 #endif //ASSIGN3_SCHEDULER_SJF_H
@@ -0,0 +1,187 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file trace.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Implementation of the buffered schedule trace writer.
+ * @version 0.1
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "trace.h"
+
+/**
+ * @brief Construct a TraceWriter that is not open.
+ */
+TraceWriter::TraceWriter() : fd(-1), format(BINARY), buffer(nullptr), used(0), count(0), write_errno(0) {}
+
+/**
+ * @brief Destroy the TraceWriter, flushing and closing the file if it is open.
+ */
+TraceWriter::~TraceWriter() {
+    std::string error;
+    close(error);
+}
+
+/**
+ * @brief Choose the format from a file name: CSV for a name ending in ".csv", binary otherwise.
+ * @param path The path of the file.
+ * @return The format.
+ */
+TraceWriter::Format TraceWriter::format_for(const std::string &path) {
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0) {
+        return CSV;
+    }
+    return BINARY;
+}
+
+/**
+ * @brief Create a trace file and write its header.
+ * @param path The path of the file.
+ * @param format The format of the file.
+ * @param error Receives a description of the problem if the file cannot be created.
+ * @return true if the file is open.
+ */
+bool TraceWriter::open(const std::string &path, Format format, std::string &error) {
+    close(error);
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        error = "Unable to create trace file " + path + ": " + strerror(errno);
+        return false;
+    }
+    this->format = format;
+    buffer = new char[BUFFER_SIZE];
+    used = 0;
+    count = 0;
+    write_errno = 0;
+    if (format == BINARY) {
+        TraceHeader header;
+        memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+        header.version = TRACE_VERSION;
+        header.record_size = sizeof(TraceRecord);
+        memcpy(buffer, &header, sizeof(header));
+        used = sizeof(header);
+    } else {
+        static const char columns[] = "time,pid,duration,core\n";
+        memcpy(buffer, columns, sizeof(columns) - 1);
+        used = sizeof(columns) - 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Append an unsigned integer in decimal to the buffer, which must have room for it.
+ * @param value The integer.
+ */
+void TraceWriter::append_uint(uint64_t value) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value != 0);
+    while (n > 0) {
+        buffer[used++] = digits[--n];
+    }
+}
+
+/**
+ * @brief Append the record of a run.
+ * @param time The time at which the run started.
+ * @param pid The ID of the process.
+ * @param duration The length of the run.
+ * @param core The core that ran the process.
+ */
+void TraceWriter::write(uint64_t time, uint32_t pid, uint32_t duration, uint32_t core) {
+    if (fd < 0) {
+        return;
+    }
+    // A CSV line is at most a number of 20 digits, 3 numbers of 10 digits and 4 separators
+    if (BUFFER_SIZE - used < 54) {
+        flush();
+    }
+    if (format == BINARY) {
+        TraceRecord record = {time, pid, duration, core, 0};
+        memcpy(buffer + used, &record, sizeof(record));
+        used += sizeof(record);
+    } else {
+        append_uint(time);
+        buffer[used++] = ',';
+        append_uint(pid);
+        buffer[used++] = ',';
+        append_uint(duration);
+        buffer[used++] = ',';
+        append_uint(core);
+        buffer[used++] = '\n';
+    }
+    count++;
+}
+
+/**
+ * @brief Write the buffered bytes to the file.
+ */
+void TraceWriter::flush() {
+    size_t done = 0;
+    while (done < used && write_errno == 0) {
+        ssize_t n = ::write(fd, buffer + done, used - done);
+        if (n < 0) {
+            if (errno != EINTR) {
+                write_errno = errno;
+            }
+            continue;
+        }
+        done += n;
+    }
+    used = 0;
+}
+
+/**
+ * @brief Flush and close the file.
+ * @param error Receives a description of the problem if a write failed.
+ * @return true if the whole trace was written.
+ */
+bool TraceWriter::close(std::string &error) {
+    if (fd < 0) {
+        return true;
+    }
+    flush();
+    if (::close(fd) < 0 && write_errno == 0) {
+        write_errno = errno;
+    }
+    fd = -1;
+    delete[] buffer;
+    buffer = nullptr;
+    if (write_errno != 0) {
+        error = std::string("Unable to write the trace file: ") + strerror(write_errno);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Remove a "-t <trace file>" option from the command line, so the drivers can keep parsing their positional
+ *        arguments unchanged.
+ * @param argc The number of arguments; it is reduced when the option is found.
+ * @param argv The arguments; the option is removed from them.
+ * @param path Receives the path of the trace file, or is left empty when there is no such option.
+ * @return false if -t is the last argument and has no path.
+ */
+bool take_trace_option(int &argc, char *argv[], std::string &path) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") != 0) {
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        path = argv[i + 1];
+        for (int j = i; j + 2 <= argc; j++) {
+            argv[j] = argv[j + 2];
+        }
+        argc -= 2;
+        return true;
+    }
+    return true;
+}
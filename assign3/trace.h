@@ -0,0 +1,150 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file trace.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A compact, buffered trace of the schedule: one (time, pid, duration, core) record per run of a process.
+ * @version 0.1
+ */
+
+#ifndef ASSIGN3_TRACE_H
+#define ASSIGN3_TRACE_H
+
+#include <cstdint>
+#include <string>
+
+// The first bytes of a binary trace file
+const char TRACE_MAGIC[8] = {'S', 'C', 'H', 'E', 'D', 'T', 'R', 'C'};
+
+/**
+ * @brief The header of a binary trace file. It is followed by the records.
+ */
+struct TraceHeader {
+    // TRACE_MAGIC
+    char magic[8];
+    // The version of the format, TRACE_VERSION
+    uint32_t version;
+    // The size of a record, for readers of later versions
+    uint32_t record_size;
+};
+
+// The version of the binary traces written by TraceWriter
+const uint32_t TRACE_VERSION = 2;
+
+/**
+ * @brief One run of a process in a binary trace file, in native byte order.
+ */
+struct TraceRecord {
+    // The time at which the run started
+    uint64_t time;
+    // The ID of the process
+    uint32_t pid;
+    // The length of the run
+    uint32_t duration;
+    // The core that ran the process
+    uint32_t core;
+    // Zero, padding the record to a multiple of 8 bytes
+    uint32_t reserved;
+};
+
+/**
+ * @brief Writes the schedule of a simulation to a trace file, as binary records or as CSV lines
+ *        "time,pid,duration,core". The output goes through a large buffer with a hand-written integer formatter, so
+ *        a record costs a few stores rather than a formatted, flushed stream write.
+ */
+class TraceWriter {
+public:
+    /**
+     * @brief The formats of a trace file.
+     */
+    enum Format { BINARY, CSV };
+
+    /**
+     * @brief Construct a TraceWriter that is not open.
+     */
+    TraceWriter();
+
+    /**
+     * @brief Destroy the TraceWriter, flushing and closing the file if it is open.
+     */
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    /**
+     * @brief Create a trace file and write its header.
+     * @param path The path of the file.
+     * @param format The format of the file.
+     * @param error Receives a description of the problem if the file cannot be created.
+     * @return true if the file is open.
+     */
+    bool open(const std::string &path, Format format, std::string &error);
+
+    /**
+     * @brief Append the record of a run.
+     * @param time The time at which the run started.
+     * @param pid The ID of the process.
+     * @param duration The length of the run.
+     * @param core The core that ran the process.
+     */
+    void write(uint64_t time, uint32_t pid, uint32_t duration, uint32_t core);
+
+    /**
+     * @brief Flush and close the file.
+     * @param error Receives a description of the problem if a write failed.
+     * @return true if the whole trace was written.
+     */
+    bool close(std::string &error);
+
+    /**
+     * @brief Get the number of records written so far.
+     * @return The number of records.
+     */
+    unsigned long long records() const { return count; }
+
+    /**
+     * @brief Choose the format from a file name: CSV for a name ending in ".csv", binary otherwise.
+     * @param path The path of the file.
+     * @return The format.
+     */
+    static Format format_for(const std::string &path);
+
+private:
+    // The size of the output buffer
+    static const size_t BUFFER_SIZE = 1 << 16;
+
+    // The file descriptor, or -1 when the writer is not open
+    int fd;
+    // The format of the file
+    Format format;
+    // The output buffer and the number of bytes in it
+    char *buffer;
+    size_t used;
+    // The number of records written
+    unsigned long long count;
+    // The errno of the first failed write, or 0
+    int write_errno;
+
+    /**
+     * @brief Write the buffered bytes to the file.
+     */
+    void flush();
+
+    /**
+     * @brief Append an unsigned integer in decimal to the buffer, which must have room for it.
+     * @param value The integer.
+     */
+    void append_uint(uint64_t value);
+};
+
+/**
+ * @brief Remove a "-t <trace file>" option from the command line, so the drivers can keep parsing their positional
+ *        arguments unchanged.
+ * @param argc The number of arguments; it is reduced when the option is found.
+ * @param argv The arguments; the option is removed from them.
+ * @param path Receives the path of the trace file, or is left empty when there is no such option.
+ * @return false if -t is the last argument and has no path.
+ */
+bool take_trace_option(int &argc, char *argv[], std::string &path);
+
+#endif //ASSIGN3_TRACE_H
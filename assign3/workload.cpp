@@ -0,0 +1,158 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file workload.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Implementation of the fast workload file loader.
+ * @version 0.1
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "workload.h"
+
+/**
+ * @brief Check whether a character is a blank (space, tab or carriage return) within a line.
+ * @param c The character.
+ * @return true if the character is a blank.
+ */
+static inline bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief Parse an unsigned decimal integer, skipping the blanks around it.
+ * @param p The current position; it is advanced past the number and the blanks after it.
+ * @param end The end of the line.
+ * @param value Receives the parsed value.
+ * @return true if a number that fits in an unsigned int was found.
+ */
+static bool scan_uint(const char *&p, const char *end, unsigned int &value) {
+    while (p < end && is_blank(*p)) p++;
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+    unsigned long long v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        if (v > UINT_MAX) {
+            return false;
+        }
+        p++;
+    }
+    while (p < end && is_blank(*p)) p++;
+    value = (unsigned int)v;
+    return true;
+}
+
+/**
+ * @brief Parse one line "name, priority, burst[, arrival]" and append it to the process table.
+ *        The arrival time defaults to 0 when the column is absent.
+ * @param line The start of the line.
+ * @param end The end of the line, excluding the newline.
+ * @param process_table The process table.
+ * @return true if the line is well formed.
+ */
+static bool parse_line(const char *line, const char *end, ProcessTable &process_table) {
+    // The name runs up to the first comma, without the surrounding blanks
+    const char *comma = (const char *)memchr(line, ',', end - line);
+    if (comma == nullptr) {
+        return false;
+    }
+    const char *name_begin = line;
+    const char *name_end = comma;
+    while (name_begin < name_end && is_blank(*name_begin)) name_begin++;
+    while (name_end > name_begin && is_blank(name_end[-1])) name_end--;
+
+    const char *p = comma + 1;
+    unsigned int priority, burst_time;
+    if (!scan_uint(p, end, priority) || p == end || *p != ',') {
+        return false;
+    }
+    p++;
+    if (!scan_uint(p, end, burst_time)) {
+        return false;
+    }
+    unsigned int arrival_time = 0;
+    if (p != end) {
+        if (*p != ',') {
+            return false;
+        }
+        p++;
+        if (!scan_uint(p, end, arrival_time) || p != end) {
+            return false;
+        }
+    }
+    process_table.add(name_begin, name_end - name_begin, priority, burst_time, arrival_time);
+    return true;
+}
+
+/**
+ * @brief Load the processes of a workload file.
+ * @param path The path of the workload file.
+ * @param process_table The table that receives the processes. Its previous content is discarded.
+ * @param error Receives a description of the problem if the file cannot be read or a line is malformed.
+ * @return true if the whole file was loaded, false otherwise.
+ */
+bool load_workload(const char *path, ProcessTable &process_table, std::string &error) {
+    process_table.clear();
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        error = std::string("Unable to open file ") + path + ": " + strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        error = std::string("Unable to stat file ") + path + ": " + strerror(errno);
+        close(fd);
+        return false;
+    }
+    size_t size = st.st_size;
+    if (size > UINT32_MAX) {
+        // The names are interned with 32-bit offsets, and they may take up to the whole file
+        error = std::string("Workload file ") + path + " is larger than 4 GiB";
+        close(fd);
+        return false;
+    }
+    if (size == 0) {
+        // An empty workload has no processes; mmap does not accept a zero length
+        close(fd);
+        return true;
+    }
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        error = std::string("Unable to map file ") + path + ": " + strerror(errno);
+        return false;
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    const char *data = (const char *)map;
+    const char *data_end = data + size;
+
+    // One process per line: reserve the whole table before parsing
+    process_table.reserve(std::count(data, data_end, '\n') + 1);
+
+    bool ok = true;
+    size_t line_number = 0;
+    for (const char *line = data; line < data_end && ok; ) {
+        const char *newline = (const char *)memchr(line, '\n', data_end - line);
+        const char *end = newline != nullptr ? newline : data_end;
+        line_number++;
+        // Skip blank lines
+        const char *first = line;
+        while (first < end && is_blank(*first)) first++;
+        if (first < end && !parse_line(line, end, process_table)) {
+            error = std::string("Malformed line ") + std::to_string(line_number) + " in " + path +
+                    ", expected \"name, priority, burst[, arrival]\"";
+            ok = false;
+        }
+        line = end + 1;
+    }
+    munmap(map, size);
+    return ok;
+}
@@ -0,0 +1,30 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file workload.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A fast loader for scheduler workload files, shared by all driver programs.
+ * @version 0.1
+ */
+
+#ifndef ASSIGN3_WORKLOAD_H
+#define ASSIGN3_WORKLOAD_H
+
+#include <string>
+#include <vector>
+#include "pcb.h"
+
+/**
+ * @brief Load the processes of a workload file.
+ *        Each line of the file describes one process in the format "name, priority, burst[, arrival]",
+ *        where the optional arrival time defaults to 0.
+ *        Blank lines are skipped, and the process IDs are assigned in file order starting from 0.
+ *        The file is memory-mapped and parsed in place with a hand-written integer scanner, and the process table is
+ *        reserved up front from the number of lines, so loading a million-line workload is a single pass over memory.
+ * @param path The path of the workload file.
+ * @param process_table The table that receives the processes. Its previous content is discarded.
+ * @param error Receives a description of the problem if the file cannot be read or a line is malformed.
+ * @return true if the whole file was loaded, false otherwise.
+ */
+bool load_workload(const char *path, ProcessTable &process_table, std::string &error);
+
+#endif //ASSIGN3_WORKLOAD_H
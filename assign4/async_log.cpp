@@ -0,0 +1,126 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file async_log.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Implementation file for the asynchronous log of the producer and consumer threads
+ * @version 0.1
+ */
+#include "async_log.h"
+#include <chrono>   // For the pause of the logger when every ring is empty
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+/**
+ * @brief Constructor for the AsyncLog class, which also starts the logger thread
+ * @param writers The number of threads that log, each with a ring of its own
+ * @param ring_size The number of records in each ring, rounded up to a power of two
+ */
+AsyncLog::AsyncLog(int writers, size_t ring_size) : stopping(false) {
+    size_t capacity = 1;
+    while (capacity < ring_size) {
+        capacity <<= 1;
+    }
+    for (int i = 0; i < writers; i++) {
+        Ring* ring = new Ring();
+        ring->records.resize(capacity);
+        ring->mask = capacity - 1;
+        ring->tail.store(0, memory_order_relaxed);
+        ring->drops.store(0, memory_order_relaxed);
+        ring->head.store(0, memory_order_relaxed);
+        rings.push_back(ring);
+    }
+    logger = thread(&AsyncLog::run, this);
+}
+
+/**
+ * @brief Destructor for the AsyncLog class
+ */
+AsyncLog::~AsyncLog() {
+    stop();
+    for (size_t i = 0; i < rings.size(); i++) {
+        delete rings[i];
+    }
+}
+
+/**
+ * @brief Adds a record without waiting
+ * @param writer The index of the calling thread's ring
+ * @param record The record
+ * @return true if the record was queued, false if it was dropped because the ring is full
+ */
+bool AsyncLog::log(int writer, const LogRecord& record) {
+    Ring& ring = *rings[writer];
+    size_t t = ring.tail.load(memory_order_relaxed);
+    if (t - ring.head.load(memory_order_acquire) > ring.mask) {
+        ring.drops.store(ring.drops.load(memory_order_relaxed) + 1, memory_order_relaxed);  // Only this thread writes it
+        return false;
+    }
+    ring.records[t & ring.mask] = record;
+    ring.tail.store(t + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Formats and prints everything queued in the rings, with one write to stdout
+ * @return true if anything was printed
+ */
+bool AsyncLog::drain() {
+    string text;
+    for (size_t i = 0; i < rings.size(); i++) {
+        Ring& ring = *rings[i];
+        size_t h = ring.head.load(memory_order_relaxed);
+        size_t t = ring.tail.load(memory_order_acquire);
+        for (; h != t; h++) {
+            const LogRecord& record = ring.records[h & ring.mask];
+            if (record.kind == LogRecord::INSERTED) {
+                text += "Producer " + to_string(record.thread_id) + ": Inserted item " + to_string(record.item) + "\n";
+            } else {
+                text += "Consumer: Removed item " + to_string(record.item) + "\n";
+            }
+            int shown = record.count < LogRecord::SNAPSHOT_ITEMS ? record.count : (int)LogRecord::SNAPSHOT_ITEMS;
+            text += BoundedBuffer::format_items(record.items, shown, record.count) + "\n";
+        }
+        ring.head.store(h, memory_order_release);  // Hand the slots back to the writer
+    }
+    if (text.empty()) {
+        return false;
+    }
+    cout << text << flush;
+    return true;
+}
+
+/**
+ * @brief The logger thread: drains the rings, pausing briefly whenever they are all empty
+ */
+void AsyncLog::run() {
+    while (!stopping.load(memory_order_acquire)) {
+        if (!drain()) {
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    }
+    drain();  // The writers have stopped, so this empties the rings for good
+}
+
+/**
+ * @brief Prints every record still queued and joins the logger thread
+ */
+void AsyncLog::stop() {
+    if (logger.joinable()) {
+        stopping.store(true, memory_order_release);
+        logger.join();
+    }
+}
+
+/**
+ * @brief Gets the number of records dropped because a ring was full
+ * @return The number of dropped records
+ */
+uint64_t AsyncLog::dropped() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < rings.size(); i++) {
+        total += rings[i]->drops.load(memory_order_relaxed);
+    }
+    return total;
+}
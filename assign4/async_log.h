@@ -0,0 +1,105 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file async_log.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A log with one lock-free ring per thread, drained to stdout by a dedicated logger thread.
+ * @version 0.1
+ */
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+#include <atomic>   // For the positions of the rings and the stop flag
+#include <cstddef>  // For size_t
+#include <cstdint>  // For uint64_t
+#include <thread>   // For the logger thread
+#include <vector>
+#include "bounded_buffer.h"
+
+/**
+ * @brief One event of a producer or consumer, with a copy of the buffer taken right after the operation
+ */
+struct LogRecord {
+    static const int SNAPSHOT_ITEMS = 16;   // Items of the buffer kept in a record, the rest are shown as "..."
+
+    enum Kind { INSERTED, REMOVED };
+    Kind kind;                              // What the thread did
+    int thread_id;                          // The producer ID; unused for consumers
+    buffer_item item;                       // The inserted or removed item
+    int count;                              // Number of items in the buffer after the operation
+    buffer_item items[SNAPSHOT_ITEMS];      // The first of those items, oldest first
+};
+
+/**
+ * @brief An asynchronous log. Each producer and consumer thread owns a ring that only it writes and only the
+ *        logger thread reads, so logging takes no lock and never waits for stdout. A record that finds its
+ *        ring full is dropped and counted instead of blocking the thread.
+ */
+class AsyncLog {
+public:
+    /**
+     * @brief Construct a log and start its logger thread
+     * @param writers the number of threads that log, each with a ring of its own
+     * @param ring_size the number of records in each ring, rounded up to a power of two
+     */
+    AsyncLog(int writers, size_t ring_size = 256);
+
+    /**
+     * @brief Stop the log, printing what is left, if stop was not called
+     */
+    ~AsyncLog();
+
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+    /**
+     * @brief Add a record without waiting. Only the thread that owns the ring may call it.
+     * @param writer the index of the calling thread's ring
+     * @param record the record
+     * @return true if the record was queued, false if it was dropped because the ring is full
+     */
+    bool log(int writer, const LogRecord& record);
+
+    /**
+     * @brief Print every record still queued and join the logger thread. The writers must have stopped.
+     */
+    void stop();
+
+    /**
+     * @brief Get the number of records dropped because a ring was full
+     * @return the number of dropped records
+     */
+    uint64_t dropped() const;
+
+private:
+    /**
+     * @brief A single-producer single-consumer ring of records. The positions sit on separate cache lines, so
+     *        the writer and the logger do not invalidate each other's line on every record.
+     */
+    struct Ring {
+        std::vector<LogRecord> records;     // Slots, with a power-of-two size
+        size_t mask;                        // Number of slots minus one
+        char pad0[64];
+        std::atomic<size_t> tail;           // Records written, advanced by the writer
+        std::atomic<uint64_t> drops;        // Records dropped, counted by the writer
+        char pad1[64];
+        std::atomic<size_t> head;           // Records printed, advanced by the logger
+        char pad2[64];
+    };
+
+    std::vector<Ring*> rings;               // One ring per writer
+    std::atomic<bool> stopping;             // Set by stop, the logger then drains the rings one last time
+    std::thread logger;                     // The thread that formats and prints the records
+
+    /**
+     * @brief The logger thread: drain the rings until stopping is set, then drain them once more
+     */
+    void run();
+
+    /**
+     * @brief Format and print everything queued in the rings
+     * @return true if anything was printed
+     */
+    bool drain();
+};
+
+#endif // ASYNC_LOG_H
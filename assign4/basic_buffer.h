@@ -0,0 +1,718 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file basic_buffer.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A bounded buffer of any movable type, protected by a mutex and condition variables, with zero-copy
+ *        access to its slots.
+ * @version 0.1
+ */
+#ifndef BASIC_BUFFER_H
+#define BASIC_BUFFER_H
+
+#include <algorithm>           // For std::min and std::copy
+#include <atomic>              // For the hints read by spinning threads
+#include <chrono>              // For the timeouts of the timed operations
+#include <condition_variable>  // For waiting on a full or empty buffer
+#include <cstddef>             // For size_t
+#include <iterator>            // For std::advance
+#include <mutex>               // For the lock that protects the buffer
+#include <new>                 // For placement new in emplace
+#include <thread>              // For std::this_thread::yield while waiting
+#include <utility>             // For std::move and std::forward
+#include <vector>
+#include "buffer_stats.h"     // For the optional counters
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>         // For _mm_pause
+#endif
+
+/**
+ * @brief Tell the CPU that the thread is spinning, so it saves power and yields the core to a sibling hyperthread
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * @brief How a thread waits on a full or empty buffer: first spin, checking the buffer spins times with a pause
+ *        in between, then give up the CPU yields times, and only then park on the condition variable. The
+ *        default parks at once, which suits threads that share cores; threads on dedicated cores avoid the
+ *        system calls of parking and waking with a few thousand spins.
+ */
+struct WaitStrategy {
+    int spins;      // Checks with a pause instruction in between
+    int yields;     // Checks with a yield of the CPU in between
+
+    WaitStrategy(int spins = 0, int yields = 0) : spins(spins), yields(yields) {}
+};
+
+/**
+ * @brief A bounded buffer of items of type T.
+ *
+ * The slots are T objects that live as long as the buffer, so large records are filled and read in place and
+ * never allocated per item. Items go in by move (insert), by construction in the slot (emplace), or by
+ * reserving a slot, filling it and committing it (reserve_insert/commit_insert). The consumer side mirrors this:
+ * remove moves an item out, while reserve_remove/commit_remove read it in place.
+ *
+ * A slot moves through four positions, all counted from the start: reserved by a producer, published to the
+ * consumers, reserved by a consumer, and freed for the producers. Reservations may be committed in any order,
+ * but a slot is published or freed only once every slot before it is, so the items stay in FIFO order.
+ *
+ * A thread that finds the buffer full or empty waits according to its WaitStrategy. The spinning phases read
+ * lock-free hints of the free slots and published items, and only parked threads are notified, so a transition
+ * costs no system call while nobody is parked.
+ *
+ * With enable_stats, the buffer also counts waits, blocked time, lock hold time and occupancy. The counters are
+ * only updated by the thread holding the lock, so they add no contention of their own, and they sit on cache
+ * lines apart from the hints that spinning threads read.
+ *
+ * T must be default constructible and move assignable; copying is only needed by the operations that copy.
+ */
+template <class T>
+class BasicBuffer {
+private:
+    std::vector<T> slots;               // The slots, each holding a live T
+    std::vector<char> committed;        // Slots between published and reserved_w that their producer committed
+    std::vector<char> released;         // Slots between freed and reserved_r that their consumer committed
+    size_t capacity;                    // Number of slots
+    size_t reserved_w;                  // Slots handed to producers
+    size_t published;                   // Slots readable by consumers, at most reserved_w
+    size_t reserved_r;                  // Slots handed to consumers, at most published
+    size_t freed;                       // Slots writable again, at most reserved_r
+    mutable std::mutex mutex;           // Protects everything above except the contents of reserved slots
+    std::condition_variable space_cond; // Producers wait here while no slot is free
+    std::condition_variable items_cond; // Consumers wait here while no item is published
+    int space_parked;                   // Producers waiting on space_cond
+    int items_parked;                   // Consumers waiting on items_cond
+    std::atomic<size_t> space_hint;     // Free slots, updated under the lock and read by spinning producers
+    std::atomic<size_t> items_hint;     // Published items, updated under the lock and read by spinning consumers
+    WaitStrategy strategy;              // How threads wait, set before the threads start
+    char stats_pad[64];                 // Keeps the counters off the cache line of the hints
+    bool stats_enabled;                 // Whether the counters below are kept, set before the threads start
+    BufferStats counters;               // The counters, updated under the lock
+
+    typedef std::chrono::steady_clock::time_point Deadline;
+
+    /**
+     * @brief Time a critical section that moves items or slots, from its construction to its destruction. Declare
+     *        it after the lock, once any waiting is over, so it is destroyed before the lock is released.
+     */
+    class HoldTimer {
+    public:
+        explicit HoldTimer(BasicBuffer& buffer) : buffer(buffer) {
+            if (buffer.stats_enabled) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~HoldTimer() {
+            if (buffer.stats_enabled) {
+                buffer.counters.lock_holds++;
+                buffer.counters.lock_hold_ns += elapsed_ns(start);
+            }
+        }
+
+    private:
+        BasicBuffer& buffer;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @brief Get the time since a point, in nanoseconds
+     * @param start the point
+     * @return the nanoseconds since start
+     */
+    static uint64_t elapsed_ns(const std::chrono::steady_clock::time_point& start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * @brief Refresh the hints after the counters changed. The lock must be held.
+     */
+    void update_hints() {
+        space_hint.store(capacity - (reserved_w - freed), std::memory_order_relaxed);
+        items_hint.store(published - reserved_r, std::memory_order_relaxed);
+        if (stats_enabled) {
+            size_t in_use = reserved_w - freed;
+            counters.occupancy[in_use]++;
+            if (in_use > counters.high_water) {
+                counters.high_water = in_use;
+            }
+        }
+    }
+
+    /**
+     * @brief Check for a free slot. The lock must be held.
+     * @return true if a producer can reserve a slot
+     */
+    bool has_space() const { return reserved_w - freed < capacity; }
+
+    /**
+     * @brief Check for a published item. The lock must be held.
+     * @return true if a consumer can reserve an item
+     */
+    bool has_items() const { return reserved_r < published; }
+
+    /**
+     * @brief Publish the committed slots that follow the published ones and wake up a consumer. The lock must be held.
+     */
+    void advance_published() {
+        size_t before = published;
+        while (published < reserved_w && committed[published % capacity]) {
+            committed[published % capacity] = 0;
+            published++;
+        }
+        update_hints();
+        if (published != before && items_parked > 0) {
+            items_cond.notify_one();
+        }
+    }
+
+    /**
+     * @brief Free the released slots that follow the freed ones and wake up a producer. The lock must be held.
+     */
+    void advance_freed() {
+        size_t before = freed;
+        while (freed < reserved_r && released[freed % capacity]) {
+            released[freed % capacity] = 0;
+            freed++;
+        }
+        update_hints();
+        if (freed != before && space_parked > 0) {
+            space_cond.notify_one();
+        }
+    }
+
+    /**
+     * @brief Wake one more waiter on each side that can still make progress, after a thread that waited took its
+     *        turn: a batch wakes a single thread even when it makes room or items for several. The lock must be held.
+     */
+    void pass_on_wake_up() {
+        if (has_space() && space_parked > 0) {
+            space_cond.notify_one();
+        }
+        if (has_items() && items_parked > 0) {
+            items_cond.notify_one();
+        }
+    }
+
+    /**
+     * @brief Wait until a condition holds: spin and yield on its hint without the lock, then park. The lock must be held.
+     * @param lock the held lock
+     * @param ready the condition, has_space or has_items
+     * @param hint the lock-free hint of the condition, nonzero when it probably holds
+     * @param cond the condition variable to park on
+     * @param parked the count of threads parked on cond
+     * @param waits the counter of waits on the condition
+     * @param deadline the time to give up at, or nullptr to wait as long as needed
+     * @return true if the condition holds, false if the deadline passed
+     */
+    bool wait_ready(std::unique_lock<std::mutex>& lock, bool (BasicBuffer::*ready)() const,
+                    const std::atomic<size_t>& hint, std::condition_variable& cond, int& parked, uint64_t& waits,
+                    const Deadline* deadline) {
+        if ((this->*ready)()) {
+            return true;
+        }
+        std::chrono::steady_clock::time_point start;
+        if (stats_enabled) {
+            waits++;
+            start = std::chrono::steady_clock::now();
+        }
+        bool result = wait_not_ready(lock, ready, hint, cond, parked, deadline);
+        if (stats_enabled) {
+            counters.blocked_ns += elapsed_ns(start);  // The lock is held again
+        }
+        return result;
+    }
+
+    /**
+     * @brief The waiting of wait_ready, once the condition was found not to hold. The lock must be held.
+     * @param lock the held lock
+     * @param ready the condition, has_space or has_items
+     * @param hint the lock-free hint of the condition, nonzero when it probably holds
+     * @param cond the condition variable to park on
+     * @param parked the count of threads parked on cond
+     * @param deadline the time to give up at, or nullptr to wait as long as needed
+     * @return true if the condition holds, false if the deadline passed
+     */
+    bool wait_not_ready(std::unique_lock<std::mutex>& lock, bool (BasicBuffer::*ready)() const,
+                        const std::atomic<size_t>& hint, std::condition_variable& cond, int& parked,
+                        const Deadline* deadline) {
+        if (strategy.spins > 0 || strategy.yields > 0) {
+            lock.unlock();
+            for (int i = 0; i < strategy.spins && hint.load(std::memory_order_relaxed) == 0; i++) {
+                cpu_relax();
+            }
+            for (int i = 0; i < strategy.yields && hint.load(std::memory_order_relaxed) == 0; i++) {
+                if (deadline != nullptr && std::chrono::steady_clock::now() >= *deadline) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            lock.lock();
+        }
+        while (!(this->*ready)()) {
+            parked++;
+            bool timed_out = false;
+            if (deadline == nullptr) {
+                cond.wait(lock);
+            } else {
+                timed_out = cond.wait_until(lock, *deadline) == std::cv_status::timeout;
+            }
+            parked--;
+            if (timed_out) {
+                return (this->*ready)();
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wait for a free slot. The lock must be held.
+     * @param lock the held lock
+     * @param deadline the time to give up at, or nullptr to wait as long as needed
+     * @return true if a slot is free, false if the deadline passed
+     */
+    bool wait_for_space(std::unique_lock<std::mutex>& lock, const Deadline* deadline = nullptr) {
+        return wait_ready(lock, &BasicBuffer::has_space, space_hint, space_cond, space_parked,
+                          counters.full_waits, deadline);
+    }
+
+    /**
+     * @brief Wait for a published item. The lock must be held.
+     * @param lock the held lock
+     * @param deadline the time to give up at, or nullptr to wait as long as needed
+     * @return true if an item is published, false if the deadline passed
+     */
+    bool wait_for_items(std::unique_lock<std::mutex>& lock, const Deadline* deadline = nullptr) {
+        return wait_ready(lock, &BasicBuffer::has_items, items_hint, items_cond, items_parked,
+                          counters.empty_waits, deadline);
+    }
+
+    /**
+     * @brief Move an item into the next slot and publish it. The lock must be held and a slot be free.
+     * @param item the item
+     */
+    void push(T&& item) {
+        size_t slot = reserved_w++ % capacity;
+        slots[slot] = std::move(item);
+        committed[slot] = 1;
+        advance_published();
+    }
+
+    /**
+     * @brief Move the next published item out and free its slot. The lock must be held and an item be published.
+     * @param item receives the item
+     */
+    void pop(T& item) {
+        size_t slot = reserved_r++ % capacity;
+        item = std::move(slots[slot]);
+        released[slot] = 1;
+        advance_freed();
+    }
+
+    /**
+     * @brief Copy the published items, oldest first. The lock must be held.
+     * @param out receives up to max_n of the items
+     * @param max_n the largest number of items to copy
+     * @return the number of published items, which may be more than max_n
+     */
+    int copy_published(T* out, int max_n) const {
+        size_t count = published - reserved_r;
+        size_t copied = std::min(count, (size_t)(max_n > 0 ? max_n : 0));
+        size_t start = reserved_r % capacity;
+        size_t run = std::min(copied, capacity - start);
+        std::copy(slots.begin() + start, slots.begin() + start + run, out);
+        std::copy(slots.begin(), slots.begin() + (copied - run), out + run);
+        return count;
+    }
+
+    /**
+     * @brief Copy the published items into a fresh set of slots. The locks of both buffers must be held.
+     * @param other the buffer to copy
+     */
+    void copy_from(const BasicBuffer& other) {
+        capacity = other.capacity;
+        slots.assign(capacity, T());
+        committed.assign(capacity, 0);
+        released.assign(capacity, 0);
+        size_t count = other.published - other.reserved_r;
+        for (size_t i = 0; i < count; i++) {
+            slots[i] = other.slots[(other.reserved_r + i) % capacity];
+        }
+        reserved_w = published = count;
+        reserved_r = freed = 0;
+        counters = BufferStats(capacity);
+        update_hints();
+    }
+
+public:
+    /**
+     * @brief Construct an empty buffer
+     * @param size the number of slots, at least 1
+     * @param strategy how threads wait on a full or empty buffer
+     */
+    explicit BasicBuffer(int size = 5, const WaitStrategy& strategy = WaitStrategy())
+        : slots(size > 0 ? size : 1), committed(slots.size(), 0), released(slots.size(), 0), capacity(slots.size()),
+          reserved_w(0), published(0), reserved_r(0), freed(0), space_parked(0), items_parked(0), space_hint(capacity),
+          items_hint(0), strategy(strategy), stats_enabled(false), counters(capacity) {}
+
+    /**
+     * @brief Construct a buffer holding a copy of the published items of another one, oldest first
+     * @param other the buffer to copy
+     */
+    BasicBuffer(const BasicBuffer& other)
+        : space_parked(0), items_parked(0), strategy(other.strategy), stats_enabled(false) {
+        std::lock_guard<std::mutex> lock(other.mutex);
+        copy_from(other);
+    }
+
+    /**
+     * @brief Replace the items with a copy of the published items of another buffer
+     * @param other the buffer to copy
+     * @return this buffer
+     */
+    BasicBuffer& operator=(const BasicBuffer& other) {
+        if (this != &other) {
+            std::unique_lock<std::mutex> mine(mutex, std::defer_lock);
+            std::unique_lock<std::mutex> theirs(other.mutex, std::defer_lock);
+            std::lock(mine, theirs);
+            copy_from(other);
+            space_cond.notify_all();  // The parked threads recheck against the new items
+            items_cond.notify_all();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move an item into the buffer, waiting for a free slot
+     * @param item the item
+     */
+    void insert(T&& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        bool waited = !has_space();
+        wait_for_space(lock);
+        HoldTimer hold(*this);
+        push(std::move(item));
+        if (waited) {
+            pass_on_wake_up();
+        }
+    }
+
+    /**
+     * @brief Construct an item in the next slot, waiting for a free slot. The item is built in place, so nothing
+     *        is moved; if its constructor throws, the slot is left default constructed and unused.
+     * @param args the arguments of T's constructor
+     */
+    template <class... Args>
+    void emplace(Args&&... args) {
+        T* slot = reserve_insert();
+        slot->~T();
+        try {
+            new (slot) T(std::forward<Args>(args)...);
+        } catch (...) {
+            new (slot) T();
+            commit_insert(slot);  // Publish the default item rather than stall the slots after it
+            throw;
+        }
+        commit_insert(slot);
+    }
+
+    /**
+     * @brief Move an item into the buffer if a slot is free, without waiting
+     * @param item the item, left untouched when the buffer is full
+     * @return true if the item was inserted
+     */
+    bool try_insert(T&& item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!has_space()) {
+            return false;
+        }
+        HoldTimer hold(*this);
+        push(std::move(item));
+        return true;
+    }
+
+    /**
+     * @brief Move an item into the buffer, waiting at most a given time for a free slot
+     * @param item the item, left untouched when the time runs out
+     * @param timeout_us the longest time to wait, in microseconds
+     * @param after receives up to max_n of the items right after the insert, under the same lock, or nullptr
+     * @param max_n the largest number of items to copy into after
+     * @param count receives the number of items right after the insert, when after is given
+     * @return true if the item was inserted
+     */
+    bool timed_insert(T&& item, long timeout_us, T* after = nullptr, int max_n = 0, int* count = nullptr) {
+        std::unique_lock<std::mutex> lock(mutex);
+        bool waited = !has_space();
+        Deadline deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+        if (!wait_for_space(lock, &deadline)) {
+            return false;
+        }
+        HoldTimer hold(*this);
+        push(std::move(item));
+        if (after != nullptr) {
+            *count = copy_published(after, max_n);
+        }
+        if (waited) {
+            pass_on_wake_up();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Move an item out of the buffer, waiting for one
+     * @param item receives the item
+     */
+    void remove(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        bool waited = !has_items();
+        wait_for_items(lock);
+        HoldTimer hold(*this);
+        pop(item);
+        if (waited) {
+            pass_on_wake_up();
+        }
+    }
+
+    /**
+     * @brief Move an item out of the buffer if there is one, without waiting
+     * @param item receives the item
+     * @return true if an item was removed
+     */
+    bool try_remove(T& item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!has_items()) {
+            return false;
+        }
+        HoldTimer hold(*this);
+        pop(item);
+        return true;
+    }
+
+    /**
+     * @brief Move an item out of the buffer, waiting at most a given time for one
+     * @param item receives the item
+     * @param timeout_us the longest time to wait, in microseconds
+     * @param after receives up to max_n of the items right after the removal, under the same lock, or nullptr
+     * @param max_n the largest number of items to copy into after
+     * @param count receives the number of items right after the removal, when after is given
+     * @return true if an item was removed
+     */
+    bool timed_remove(T& item, long timeout_us, T* after = nullptr, int max_n = 0, int* count = nullptr) {
+        std::unique_lock<std::mutex> lock(mutex);
+        bool waited = !has_items();
+        Deadline deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+        if (!wait_for_items(lock, &deadline)) {
+            return false;
+        }
+        HoldTimer hold(*this);
+        pop(item);
+        if (after != nullptr) {
+            *count = copy_published(after, max_n);
+        }
+        if (waited) {
+            pass_on_wake_up();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Copy a batch of items in under a single lock, waiting for at least one free slot. The batch is
+     *        copied in at most two runs, around the end of the slots, and wakes up a single consumer.
+     * @param first a forward iterator to the first item; pass a std::move_iterator to move the items instead
+     * @param n the number of items
+     * @return the number of items inserted, from 1 to n (0 only when n is 0)
+     */
+    template <class InputIt>
+    int insert_many(InputIt first, int n) {
+        if (n <= 0) {
+            return 0;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        bool waited = !has_space();
+        wait_for_space(lock);
+        HoldTimer hold(*this);
+        size_t count = std::min((size_t)n, capacity - (reserved_w - freed));
+        size_t start = reserved_w % capacity;
+        size_t run = std::min(count, capacity - start);  // Items that fit before the end of the slots
+        for (size_t i = 0; i < count; i++) {
+            committed[(start + i) % capacity] = 1;
+        }
+        std::copy_n(first, run, slots.begin() + start);
+        std::advance(first, run);
+        std::copy_n(first, count - run, slots.begin());  // The rest wraps around to the start
+        reserved_w += count;
+        advance_published();
+        if (waited) {
+            pass_on_wake_up();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Move a batch of items out under a single lock, waiting for at least one item
+     * @param out receives the items, oldest first
+     * @param max_n the largest number of items to remove
+     * @return the number of items removed, from 1 to max_n (0 only when max_n is 0)
+     */
+    template <class OutputIt>
+    int remove_many(OutputIt out, int max_n) {
+        if (max_n <= 0) {
+            return 0;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        bool waited = !has_items();
+        wait_for_items(lock);
+        HoldTimer hold(*this);
+        size_t count = std::min((size_t)max_n, published - reserved_r);
+        size_t start = reserved_r % capacity;
+        size_t run = std::min(count, capacity - start);  // Items before the end of the slots
+        for (size_t i = 0; i < count; i++) {
+            released[(start + i) % capacity] = 1;
+        }
+        out = std::move(slots.begin() + start, slots.begin() + start + run, out);
+        std::move(slots.begin(), slots.begin() + (count - run), out);  // The rest wrapped around to the start
+        reserved_r += count;
+        advance_freed();
+        if (waited) {
+            pass_on_wake_up();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Reserve the next slot for filling in place, waiting for a free slot. The slot still holds whatever
+     *        item it held last; the caller assigns the parts it needs and then calls commit_insert.
+     * @return the slot
+     */
+    T* reserve_insert() {
+        std::unique_lock<std::mutex> lock(mutex);
+        bool waited = !has_space();
+        wait_for_space(lock);
+        HoldTimer hold(*this);
+        T* slot = &slots[reserved_w++ % capacity];
+        update_hints();
+        if (waited) {
+            pass_on_wake_up();
+        }
+        return slot;
+    }
+
+    /**
+     * @brief Publish a slot filled after reserve_insert. It becomes readable once every earlier slot is published.
+     * @param slot the slot returned by reserve_insert
+     */
+    void commit_insert(T* slot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        HoldTimer hold(*this);
+        committed[slot - slots.data()] = 1;
+        advance_published();
+    }
+
+    /**
+     * @brief Reserve the next item for reading in place, waiting for one. The caller reads or moves from it and
+     *        then calls commit_remove.
+     * @return the slot holding the item
+     */
+    T* reserve_remove() {
+        std::unique_lock<std::mutex> lock(mutex);
+        bool waited = !has_items();
+        wait_for_items(lock);
+        HoldTimer hold(*this);
+        T* slot = &slots[reserved_r++ % capacity];
+        update_hints();
+        if (waited) {
+            pass_on_wake_up();
+        }
+        return slot;
+    }
+
+    /**
+     * @brief Free a slot after reserve_remove. It becomes writable once every earlier slot is freed.
+     * @param slot the slot returned by reserve_remove
+     */
+    void commit_remove(T* slot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        HoldTimer hold(*this);
+        released[slot - slots.data()] = 1;
+        advance_freed();
+    }
+
+    /**
+     * @brief Copy the published items, holding the lock only for the copy
+     * @param out receives up to max_n of the items, oldest first
+     * @param max_n the largest number of items to copy
+     * @return the number of published items
+     */
+    int snapshot(T* out, int max_n) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return copy_published(out, max_n);
+    }
+
+    /**
+     * @brief Change how threads wait. Call it before the threads start.
+     * @param wait_strategy the new strategy
+     */
+    void set_wait_strategy(const WaitStrategy& wait_strategy) {
+        std::lock_guard<std::mutex> lock(mutex);
+        strategy = wait_strategy;
+    }
+
+    /**
+     * @brief Start keeping the counters, from zero. Call it before the threads start.
+     */
+    void enable_stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats_enabled = true;
+        counters = BufferStats(capacity);
+    }
+
+    /**
+     * @brief Get a copy of the counters, all zero unless enable_stats was called
+     * @return the counters
+     */
+    BufferStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return counters;
+    }
+
+    /**
+     * @brief Get the number of slots
+     * @return the number of slots
+     */
+    int size() const { return capacity; }
+
+    /**
+     * @brief Get the number of published items, not counting those reserved by consumers
+     * @return the number of items
+     */
+    int count() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return published - reserved_r;
+    }
+
+    /**
+     * @brief Check for published items
+     * @return true if no item can be removed right now
+     */
+    bool empty() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !has_items();
+    }
+
+    /**
+     * @brief Check for free slots
+     * @return true if no slot can be reserved right now
+     */
+    bool full() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !has_space();
+    }
+};
+
+#endif // BASIC_BUFFER_H
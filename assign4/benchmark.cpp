@@ -0,0 +1,188 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file benchmark.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Implementation file for the throughput and latency benchmark of the bounded buffers
+ * @version 0.1
+ */
+#include "benchmark.h"
+#include <atomic>   // For the flags that stop the threads
+#include <chrono>   // For the timestamps of the items
+#include <cstdio>   // For printf
+#include <thread>   // For the producer and consumer threads
+
+using namespace std;
+
+/**
+ * @brief Constructor for the LatencyHistogram class
+ */
+LatencyHistogram::LatencyHistogram() : buckets(NUM_BUCKETS, 0), total(0), largest(0) {}
+
+/**
+ * @brief Finds the bucket of a value
+ *
+ * Values below LINEAR_LIMIT have a bucket each. Above that, the highest set bit picks the power of two and the
+ * next four bits pick one of its 16 buckets.
+ *
+ * @param ns The value
+ * @return The index of its bucket
+ */
+int LatencyHistogram::bucket_of(uint32_t ns) {
+    if (ns < (uint32_t)LINEAR_LIMIT) {
+        return ns;
+    }
+    int octave = 31 - __builtin_clz(ns);  // At least 5, as LINEAR_LIMIT is 32
+    int sub = (ns >> (octave - 4)) & (SUB_BUCKETS - 1);
+    return LINEAR_LIMIT + (octave - 5) * SUB_BUCKETS + sub;
+}
+
+/**
+ * @brief Finds the lowest value of a bucket, the inverse of bucket_of
+ * @param bucket The index of the bucket
+ * @return The lowest value that falls into it
+ */
+uint32_t LatencyHistogram::lowest_of(int bucket) {
+    if (bucket < LINEAR_LIMIT) {
+        return bucket;
+    }
+    int octave = (bucket - LINEAR_LIMIT) / SUB_BUCKETS + 5;
+    int sub = (bucket - LINEAR_LIMIT) % SUB_BUCKETS;
+    return (uint32_t)(SUB_BUCKETS + sub) << (octave - 4);
+}
+
+/**
+ * @brief Records a latency
+ * @param ns The latency in nanoseconds
+ */
+void LatencyHistogram::record(uint32_t ns) {
+    buckets[bucket_of(ns)]++;
+    total++;
+    if (ns > largest) {
+        largest = ns;
+    }
+}
+
+/**
+ * @brief Adds the samples of another histogram
+ * @param other The histogram to add
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        buckets[i] += other.buckets[i];
+    }
+    total += other.total;
+    if (other.largest > largest) {
+        largest = other.largest;
+    }
+}
+
+/**
+ * @brief Gets a percentile of the latencies
+ * @param percent The percentile, from 0 to 100
+ * @return The lowest latency of the bucket holding the percentile, in nanoseconds, or 0 without samples
+ */
+uint32_t LatencyHistogram::percentile(double percent) const {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(percent / 100.0 * (total - 1));  // Number of samples below the percentile
+    uint64_t seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen > rank) {
+            return lowest_of(i);
+        }
+    }
+    return largest;
+}
+
+/**
+ * @brief Reads the low 32 bits of the steady clock in nanoseconds, the timestamp carried by each item
+ * @return The timestamp
+ */
+static uint32_t timestamp() {
+    return (uint32_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// How long a thread waits on a full or empty buffer before it checks whether to stop, in microseconds
+static const long POLL_US = 1000;
+
+/**
+ * @brief Runs producers and consumers flat out against a buffer, then stops and joins all of them
+ * @param buffer The buffer, empty at the start
+ * @param config The numbers of threads and the duration
+ * @return The counts, the elapsed time and the latency histogram
+ */
+BenchmarkResult run_benchmark(BoundedBuffer& buffer, const BenchmarkConfig& config) {
+    atomic<bool> stop(false);             // Set when the time is up, the producers finish their last insert
+    atomic<bool> producers_done(false);   // Set once every producer was joined, the consumers then drain the buffer
+    vector<uint64_t> produced(config.producers, 0);
+    vector<uint64_t> consumed(config.consumers, 0);
+    vector<LatencyHistogram> latencies(config.consumers);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> producers, consumers;
+    for (int i = 0; i < config.producers; i++) {
+        producers.push_back(thread([&, i] {
+            uint64_t count = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                if (buffer.timed_insert_item((buffer_item)timestamp(), POLL_US)) {
+                    count++;
+                }
+            }
+            produced[i] = count;
+        }));
+    }
+    for (int i = 0; i < config.consumers; i++) {
+        consumers.push_back(thread([&, i] {
+            LatencyHistogram& latency = latencies[i];
+            uint64_t count = 0;
+            buffer_item item;
+            while (true) {
+                if (buffer.timed_remove_item(&item, POLL_US)) {
+                    latency.record(timestamp() - (uint32_t)item);
+                    count++;
+                } else if (producers_done.load(memory_order_acquire)) {
+                    break;  // Nothing left and nothing more will come
+                }
+            }
+            consumed[i] = count;
+        }));
+    }
+
+    this_thread::sleep_for(chrono::duration<double>(config.seconds));
+    stop.store(true, memory_order_relaxed);
+    for (size_t i = 0; i < producers.size(); i++) {
+        producers[i].join();
+    }
+    producers_done.store(true, memory_order_release);
+    for (size_t i = 0; i < consumers.size(); i++) {
+        consumers[i].join();
+    }
+
+    BenchmarkResult result;
+    result.elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    result.produced = 0;
+    result.consumed = 0;
+    for (int i = 0; i < config.producers; i++) {
+        result.produced += produced[i];
+    }
+    for (int i = 0; i < config.consumers; i++) {
+        result.consumed += consumed[i];
+        result.latency.merge(latencies[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Prints the throughput and the latency percentiles of a benchmark run
+ * @param result The result of run_benchmark
+ */
+void print_benchmark(const BenchmarkResult& result) {
+    printf("Items: %llu produced, %llu consumed in %.3f s\n", (unsigned long long)result.produced,
+           (unsigned long long)result.consumed, result.elapsed);
+    printf("Throughput: %.0f items/s\n", result.elapsed > 0 ? result.consumed / result.elapsed : 0.0);
+    const LatencyHistogram& latency = result.latency;
+    printf("Latency (ns): p50 %u  p90 %u  p99 %u  p99.9 %u  max %u\n", latency.percentile(50), latency.percentile(90),
+           latency.percentile(99), latency.percentile(99.9), latency.max());
+}
@@ -0,0 +1,119 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file benchmark.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A throughput and latency benchmark of the bounded buffers, with no sleeps and no per-item printing.
+ * @version 0.1
+ */
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstdint>
+#include <vector>
+#include "bounded_buffer.h"
+
+/**
+ * @brief A histogram of latencies in nanoseconds, with 16 buckets per power of two, so percentiles are within
+ *        about 6% of the exact value. Recording is a few instructions and needs no allocation.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKETS = 16;                          // Buckets per power of two
+    static const int LINEAR_LIMIT = 2 * SUB_BUCKETS;            // Values below this have a bucket of their own
+    static const int NUM_BUCKETS = LINEAR_LIMIT + (32 - 5) * SUB_BUCKETS;  // Covers every 32-bit value
+
+    /**
+     * @brief Construct an empty histogram
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Record a latency
+     * @param ns the latency in nanoseconds
+     */
+    void record(uint32_t ns);
+
+    /**
+     * @brief Add the samples of another histogram
+     * @param other the histogram to add
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Get the number of samples
+     * @return the number of samples
+     */
+    uint64_t count() const { return total; }
+
+    /**
+     * @brief Get the largest recorded latency
+     * @return the largest latency in nanoseconds
+     */
+    uint32_t max() const { return largest; }
+
+    /**
+     * @brief Get a percentile of the latencies
+     * @param percent the percentile, from 0 to 100
+     * @return the lowest latency of the bucket holding the percentile, in nanoseconds
+     */
+    uint32_t percentile(double percent) const;
+
+private:
+    std::vector<uint64_t> buckets;  // Number of samples in each bucket
+    uint64_t total;                 // Number of samples
+    uint32_t largest;               // Largest sample
+
+    /**
+     * @brief Find the bucket of a value
+     * @param ns the value
+     * @return the index of its bucket
+     */
+    static int bucket_of(uint32_t ns);
+
+    /**
+     * @brief Find the lowest value of a bucket
+     * @param bucket the index of the bucket
+     * @return the lowest value that falls into it
+     */
+    static uint32_t lowest_of(int bucket);
+};
+
+/**
+ * @brief The settings of a benchmark run
+ */
+struct BenchmarkConfig {
+    int producers;      // Number of producer threads
+    int consumers;      // Number of consumer threads
+    double seconds;     // How long the producers keep inserting
+};
+
+/**
+ * @brief The outcome of a benchmark run
+ */
+struct BenchmarkResult {
+    uint64_t produced;          // Items inserted
+    uint64_t consumed;          // Items removed, equal to produced after the drain
+    double elapsed;             // Seconds from the start until every thread was joined
+    LatencyHistogram latency;   // Time from the insert to the remove of each item
+};
+
+/**
+ * @brief Run producers and consumers flat out against a buffer, then stop and join all of them
+ *
+ * Every item carries the low 32 bits of the steady clock in nanoseconds at its insertion, and the consumer that
+ * removes it records the difference to its own clock. Latencies wrap after about 4 seconds, far beyond any wait
+ * in the buffer. When the time is up the producers stop, the consumers drain what is left, and every thread is joined.
+ *
+ * @param buffer the buffer, empty at the start
+ * @param config the numbers of threads and the duration
+ * @return the counts, the elapsed time and the latency histogram
+ */
+BenchmarkResult run_benchmark(BoundedBuffer& buffer, const BenchmarkConfig& config);
+
+/**
+ * @brief Print the throughput and the latency percentiles of a benchmark run
+ * @param result the result of run_benchmark
+ */
+void print_benchmark(const BenchmarkResult& result);
+
+#endif // BENCHMARK_H
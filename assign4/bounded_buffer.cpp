@@ -0,0 +1,78 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file bounded_buffer.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Implementation file for the formatting shared by the bounded buffer implementations
+ * @version 0.1
+ */
+#include "bounded_buffer.h"
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Inserts an item, then copies the buffer with snapshot()
+ * @param item The item to insert into the buffer
+ * @param timeout_us The longest time to wait, in microseconds
+ * @param items Receives up to max_n of the items
+ * @param max_n The largest number of items to copy
+ * @param count Receives the number of items in the buffer
+ * @return true if the item was inserted, false if the buffer stayed full
+ */
+bool BoundedBuffer::timed_insert_and_snapshot(buffer_item item, long timeout_us, buffer_item* items, int max_n,
+                                              int& count) {
+    if (!timed_insert_item(item, timeout_us)) {
+        return false;
+    }
+    count = snapshot(items, max_n);
+    return true;
+}
+
+/**
+ * @brief Removes an item, then copies the buffer with snapshot()
+ * @param item Pointer to a variable to store the removed item
+ * @param timeout_us The longest time to wait, in microseconds
+ * @param items Receives up to max_n of the items
+ * @param max_n The largest number of items to copy
+ * @param count Receives the number of items in the buffer
+ * @return true if an item was removed, false if the buffer stayed empty
+ */
+bool BoundedBuffer::timed_remove_and_snapshot(buffer_item* item, long timeout_us, buffer_item* items, int max_n,
+                                              int& count) {
+    if (!timed_remove_item(item, timeout_us)) {
+        return false;
+    }
+    count = snapshot(items, max_n);
+    return true;
+}
+
+/**
+ * @brief Formats copied items as "Buffer: [a, b, c]"
+ * @param items The copied items, oldest first
+ * @param shown The number of copied items
+ * @param count The number of items in the buffer; ", ..." stands for the ones that were not copied
+ * @return The formatted buffer
+ */
+string BoundedBuffer::format_items(const buffer_item* items, int shown, int count) {
+    string text = "Buffer: [";
+    if (count == 0) {
+        text += "-- Buffer is empty --";  // If the buffer is empty, print this message
+    } else {
+        for (int i = 0; i < shown && i < count; i++) {
+            if (i > 0) text += ", ";  // Add commas between items
+            text += to_string(items[i]);
+        }
+        if (shown < count) text += ", ...";
+    }
+    return text + "]";
+}
+
+/**
+ * @brief Formats the items of the buffer, from the oldest to the newest
+ * @return The formatted buffer
+ */
+string BoundedBuffer::contents() {
+    vector<buffer_item> items(get_size());
+    int count = snapshot(items.data(), items.size());
+    return format_items(items.data(), count < (int)items.size() ? count : items.size(), count);
+}
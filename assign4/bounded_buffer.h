@@ -0,0 +1,188 @@
+/**
+* Assignment 4: Producer Consumer Problem
+ * @file bounded_buffer.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief The interface shared by the bounded buffer implementations, so the main program can switch between them.
+ * @version 0.1
+ */
+#ifndef BOUNDED_BUFFER_H
+#define BOUNDED_BUFFER_H
+
+#include <iostream>
+#include <string>
+#include "buffer_stats.h"
+
+// Define the data type of the buffer items
+typedef int buffer_item;
+
+/**
+ * @brief A bounded buffer of items. All the synchronisation between producers and consumers lives inside the
+ *        buffer: callers need no lock or semaphore of their own.
+ *        Every operation comes in three flavours: insert_item and remove_item wait as long as needed, the try_
+ *        variants never wait, and the timed_ variants wait at most a given time.
+ */
+class BoundedBuffer {
+public:
+    /**
+     * @brief Destroy the BoundedBuffer object
+     */
+    virtual ~BoundedBuffer() {}
+
+    /**
+     * @brief Insert an item into the buffer, waiting for a free slot
+     * @param item the item to insert
+     * @return true if successful
+     * @return false if not successful
+     */
+    virtual bool insert_item(buffer_item item) = 0;
+
+    /**
+     * @brief Remove an item from the buffer, waiting for an item
+     * @param item the item to remove
+     * @return true if successful
+     * @return false if not successful
+     */
+    virtual bool remove_item(buffer_item* item) = 0;
+
+    /**
+     * @brief Insert an item into the buffer if there is a free slot, without waiting
+     * @param item the item to insert
+     * @return true if the item was inserted, false if the buffer is full
+     */
+    virtual bool try_insert_item(buffer_item item) = 0;
+
+    /**
+     * @brief Remove an item from the buffer if there is one, without waiting
+     * @param item receives the removed item
+     * @return true if an item was removed, false if the buffer is empty
+     */
+    virtual bool try_remove_item(buffer_item* item) = 0;
+
+    /**
+     * @brief Insert an item into the buffer, waiting at most a given time for a free slot
+     * @param item the item to insert
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if the item was inserted, false if the buffer stayed full
+     */
+    virtual bool timed_insert_item(buffer_item item, long timeout_us) = 0;
+
+    /**
+     * @brief Remove an item from the buffer, waiting at most a given time for an item
+     * @param item receives the removed item
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if an item was removed, false if the buffer stayed empty
+     */
+    virtual bool timed_remove_item(buffer_item* item, long timeout_us) = 0;
+
+    /**
+     * @brief Insert an item like timed_insert_item and copy the buffer as it is right after the insert. A buffer
+     *        with a lock copies in the same critical section; the default copies with snapshot() right after,
+     *        since the lock-free buffers have no critical section to share.
+     * @param item the item to insert
+     * @param timeout_us the longest time to wait, in microseconds
+     * @param items receives up to max_n of the items, oldest first
+     * @param max_n the largest number of items to copy
+     * @param count receives the number of items in the buffer, which may be more than max_n
+     * @return true if the item was inserted, false if the buffer stayed full and nothing was copied
+     */
+    virtual bool timed_insert_and_snapshot(buffer_item item, long timeout_us, buffer_item* items, int max_n,
+                                           int& count);
+
+    /**
+     * @brief Remove an item like timed_remove_item and copy the buffer as it is right after the removal. A
+     *        buffer with a lock copies in the same critical section; the default copies with snapshot() right
+     *        after.
+     * @param item receives the removed item
+     * @param timeout_us the longest time to wait, in microseconds
+     * @param items receives up to max_n of the items, oldest first
+     * @param max_n the largest number of items to copy
+     * @param count receives the number of items in the buffer, which may be more than max_n
+     * @return true if an item was removed, false if the buffer stayed empty and nothing was copied
+     */
+    virtual bool timed_remove_and_snapshot(buffer_item* item, long timeout_us, buffer_item* items, int max_n,
+                                           int& count);
+
+    /**
+     * @brief Insert a batch of items, waiting until there is at least one free slot
+     * @param items the items to insert, oldest first
+     * @param n the number of items
+     * @return the number of items inserted, from 1 to n (0 only when n is 0); the caller retries the rest
+     */
+    virtual int insert_items(const buffer_item* items, int n) = 0;
+
+    /**
+     * @brief Remove a batch of items, waiting until there is at least one item
+     * @param items receives the removed items, oldest first
+     * @param max_n the largest number of items to remove
+     * @return the number of items removed, from 1 to max_n (0 only when max_n is 0)
+     */
+    virtual int remove_items(buffer_item* items, int max_n) = 0;
+
+    /**
+     * @brief Get the size of the buffer
+     * @return the size of the buffer
+     */
+    virtual int get_size() = 0;
+
+    /**
+     * @brief Get the number of items in the buffer
+     * @return the number of items in the buffer
+     */
+    virtual int get_count() = 0;
+
+    /**
+     * @brief Chceck if the buffer is empty
+     * @return true if the buffer is empty, else false
+     */
+    virtual bool is_empty() = 0;
+
+    /**
+     * @brief Check if the buffer is full
+     * @return true if the buffer is full, else false
+     */
+    virtual bool is_full() = 0;
+
+    /**
+     * @brief Start counting waits, blocked time, lock hold time and occupancy, for buffers that support it.
+     *        Call it before the threads start.
+     * @return true if the buffer keeps the counters
+     */
+    virtual bool enable_stats() { return false; }
+
+    /**
+     * @brief Get a snapshot of the counters
+     * @param stats receives the counters
+     * @return true if the buffer keeps the counters, false if stats is left untouched
+     */
+    virtual bool get_stats(BufferStats& stats) { (void)stats; return false; }
+
+    /**
+     * @brief Copy the items of the buffer, from the oldest to the newest, without formatting anything
+     * @param items receives up to max_n of the items
+     * @param max_n the largest number of items to copy
+     * @return the number of items in the buffer, which may be more than max_n
+     */
+    virtual int snapshot(buffer_item* items, int max_n) = 0;
+
+    /**
+     * @brief Format copied items as "Buffer: [a, b, c]", ending in ", ..." when not all of them were copied
+     * @param items the copied items
+     * @param shown the number of copied items
+     * @param count the number of items in the buffer
+     * @return the formatted buffer
+     */
+    static std::string format_items(const buffer_item* items, int shown, int count);
+
+    /**
+     * @brief Format the items of the buffer, from the oldest to the newest, as "Buffer: [a, b, c]"
+     * @return the formatted buffer
+     */
+    std::string contents();
+
+    /**
+     * @brief Print the buffer
+     */
+    void print_buffer() { std::cout << contents() + "\n"; }
+};
+
+#endif // BOUNDED_BUFFER_H
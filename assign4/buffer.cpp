@@ -1,4 +1,3 @@
-
 /**
 * Assignment 4: Producer Consumer Problem
  * @file buffer.cpp
@@ -7,147 +6,170 @@
  * @version 0.1
  */
 #include "buffer.h"
-#include <iostream>
-#include <mutex>  // For using std::mutex and std::unique_lock for thread synchronization
 
 using namespace std;
 
 /**
  * @brief Constructor for the Buffer class
  * 
- * This constructor initializes the buffer with a specified size. It allocates memory for
- * the buffer array, sets the initial item count to 0, and initializes the front and rear indices.
- * The buffer is initially empty.
+ * This constructor initializes the buffer with a specified size. The slots are allocated once,
+ * here, and the buffer is initially empty.
  *
  * @param size The size of the buffer (default is 5)
+ * @param strategy How threads wait on a full or empty buffer: spins, then yields, then parking
  */
-Buffer::Buffer(int size) {
-    max_size = size;            // Set the maximum size of the buffer
-    current_count = 0;          // Initially, there are no items in the buffer
-    front_idx = 0;              // The front index starts at 0 (initial position to remove items from)
-    rear_idx = -1;              // The rear index starts at -1 (indicating the buffer is empty)
-    items = new buffer_item[max_size];  // Dynamically allocate memory for the buffer array
-}
+Buffer::Buffer(int size, const WaitStrategy& strategy) : queue(size, strategy) {}
 
 /**
  * @brief Destructor for the Buffer class
  * 
- * The destructor cleans up the dynamically allocated memory for the buffer array
- * to prevent memory leaks when the buffer object is destroyed.
+ * The slots belong to the BasicBuffer, which releases them when the buffer object is destroyed.
  */
-Buffer::~Buffer() {
-    delete[] items;  // Free the dynamically allocated buffer array
-}
+Buffer::~Buffer() {}
 
 /**
  * @brief Copy constructor for the Buffer class
  * 
- * This constructor is used to create a new buffer as a copy of an existing buffer.
- * It allocates new memory and copies the contents of the other buffer, ensuring both
- * buffers are independent.
+ * This constructor creates a new buffer holding a copy of the items of an existing buffer, oldest first.
  * 
  * @param other The buffer object to copy from
  */
-Buffer::Buffer(const Buffer& other) {
-    max_size = other.max_size;
-    current_count = other.current_count;
-    front_idx = other.front_idx;
-    rear_idx = other.rear_idx;
-    
-    items = new buffer_item[max_size];  // Allocate new memory for the buffer array
-    for (int i = 0, index = front_idx; i < current_count; i++) {
-        items[i] = other.items[index];  // Copy each item from the other buffer
-        index = (index + 1) % max_size;  // Handle circular buffer logic to wrap around
-    }
-}
+Buffer::Buffer(const Buffer& other) : BoundedBuffer(), queue(other.queue) {}
 
 /**
  * @brief Assignment operator for the Buffer class
  * 
- * This operator handles the assignment of one buffer to another. It first cleans up
- * any existing buffer data and then copies the contents of the other buffer into the 
- * current buffer. It also checks for self-assignment to prevent unnecessary work.
- *
+ * This operator replaces the items of the buffer with a copy of the items of another buffer.
+ * 
  * @param other The buffer object to assign from
- * @return A reference to the current buffer object
+ * @return A reference to this buffer object
  */
 Buffer& Buffer::operator=(const Buffer& other) {
-    // Check for self-assignment
-    if (this == &other) {
-        return *this;
-    }
-
-    // Clean up old buffer data
-    delete[] items;
-
-    // Copy the values from the other buffer
-    max_size = other.max_size;
-    current_count = other.current_count;
-    front_idx = other.front_idx;
-    rear_idx = other.rear_idx;
-    
-    items = new buffer_item[max_size];  // Allocate new memory for the buffer array
-    for (int i = 0, index = front_idx; i < current_count; i++) {
-        items[i] = other.items[index];  // Copy each item from the other buffer
-        index = (index + 1) % max_size;  // Handle circular buffer logic to wrap around
-    }
-
+    queue = other.queue;  // Self-assignment is handled by BasicBuffer
     return *this;
 }
 
 /**
  * @brief Inserts an item into the buffer
  * 
- * This function inserts an item into the buffer if there is space available.
- * It locks the mutex to ensure thread safety, waits if the buffer is full, and signals
- * the consumer thread when an item is successfully added.
+ * This function inserts an item into the buffer, waiting while the buffer is full.
+ * The buffer locks its mutex and signals a consumer thread when the item is added.
  * 
  * @param item The item to insert into the buffer
- * @return true if the item was successfully inserted
- * @return false if the buffer is full and the item could not be inserted
+ * @return true when the item was inserted
  */
 bool Buffer::insert_item(buffer_item item) {
-    std::unique_lock<std::mutex> lock(mutex);  // Lock the mutex to ensure thread safety
-
-    // Wait until the buffer is not full (use condition variable to wait)
-    while (is_full()) {
-        empty_cond.wait(lock);  // Wait for space to become available
-    }
-
-    // Insert the item at the rear index and update the rear index
-    rear_idx = (rear_idx + 1) % max_size;  // Circular buffer logic: wrap around when full
-    items[rear_idx] = item;  // Store the item in the buffer
-    current_count++;  // Increment the current item count
-
-    full_cond.notify_one();  // Signal the consumer that an item was added
+    queue.insert(std::move(item));
     return true;
 }
 
 /**
  * @brief Removes an item from the buffer
  * 
- * This function removes an item from the buffer if it is not empty. It locks the mutex 
- * to ensure thread safety, waits if the buffer is empty, and signals the producer thread 
- * when space is available after removing an item.
+ * This function removes an item from the buffer, waiting while the buffer is empty.
+ * The buffer locks its mutex and signals a producer thread when space is freed.
  * 
  * @param item Pointer to a variable to store the removed item
- * @return true if an item was successfully removed
- * @return false if the buffer is empty and no item could be removed
+ * @return true when an item was removed
  */
 bool Buffer::remove_item(buffer_item* item) {
-    std::unique_lock<std::mutex> lock(mutex);  // Lock the mutex to ensure thread safety
+    queue.remove(*item);
+    return true;
+}
+
+/**
+ * @brief Inserts an item into the buffer if there is a free slot, without waiting
+ * @param item The item to insert into the buffer
+ * @return true if the item was inserted, false if the buffer is full
+ */
+bool Buffer::try_insert_item(buffer_item item) {
+    return queue.try_insert(std::move(item));
+}
 
-    // Wait until the buffer is not empty (use condition variable to wait)
-    while (is_empty()) {
-        full_cond.wait(lock);  // Wait for an item to become available
-    }
+/**
+ * @brief Removes an item from the buffer if there is one, without waiting
+ * @param item Pointer to a variable to store the removed item
+ * @return true if an item was removed, false if the buffer is empty
+ */
+bool Buffer::try_remove_item(buffer_item* item) {
+    return queue.try_remove(*item);
+}
 
-    *item = items[front_idx];  // Remove the item from the front of the buffer
-    front_idx = (front_idx + 1) % max_size;  // Circular buffer logic: wrap around when empty
-    current_count--;  // Decrease the current item count
+/**
+ * @brief Inserts an item into the buffer, waiting at most a given time for a free slot
+ * @param item The item to insert into the buffer
+ * @param timeout_us The longest time to wait, in microseconds
+ * @return true if the item was inserted, false if the buffer stayed full
+ */
+bool Buffer::timed_insert_item(buffer_item item, long timeout_us) {
+    return queue.timed_insert(std::move(item), timeout_us);
+}
 
-    empty_cond.notify_one();  // Signal the producer that space was freed
-    return true;
+/**
+ * @brief Removes an item from the buffer, waiting at most a given time for an item
+ * @param item Pointer to a variable to store the removed item
+ * @param timeout_us The longest time to wait, in microseconds
+ * @return true if an item was removed, false if the buffer stayed empty
+ */
+bool Buffer::timed_remove_item(buffer_item* item, long timeout_us) {
+    return queue.timed_remove(*item, timeout_us);
+}
+
+/**
+ * @brief Inserts an item, waiting at most a given time, and copies the buffer in the same critical section
+ * @param item The item to insert into the buffer
+ * @param timeout_us The longest time to wait, in microseconds
+ * @param items Receives up to max_n of the items
+ * @param max_n The largest number of items to copy
+ * @param count Receives the number of items in the buffer
+ * @return true if the item was inserted, false if the buffer stayed full
+ */
+bool Buffer::timed_insert_and_snapshot(buffer_item item, long timeout_us, buffer_item* items, int max_n,
+                                       int& count) {
+    return queue.timed_insert(std::move(item), timeout_us, items, max_n, &count);
+}
+
+/**
+ * @brief Removes an item, waiting at most a given time, and copies the buffer in the same critical section
+ * @param item Pointer to a variable to store the removed item
+ * @param timeout_us The longest time to wait, in microseconds
+ * @param items Receives up to max_n of the items
+ * @param max_n The largest number of items to copy
+ * @param count Receives the number of items in the buffer
+ * @return true if an item was removed, false if the buffer stayed empty
+ */
+bool Buffer::timed_remove_and_snapshot(buffer_item* item, long timeout_us, buffer_item* items, int max_n,
+                                       int& count) {
+    return queue.timed_remove(*item, timeout_us, items, max_n, &count);
+}
+
+/**
+ * @brief Inserts a batch of items into the buffer under a single lock
+ * 
+ * This function waits while the buffer is full, then copies as many items as fit in at most two
+ * contiguous runs, one up to the end of the array and one from its start. The consumer waiting for
+ * items, if any, is woken up once for the whole batch.
+ * 
+ * @param batch The items to insert, oldest first
+ * @param n The number of items
+ * @return The number of items inserted, from 1 to n (0 only when n is 0)
+ */
+int Buffer::insert_items(const buffer_item* batch, int n) {
+    return queue.insert_many(batch, n);
+}
+
+/**
+ * @brief Removes a batch of items from the buffer under a single lock
+ * 
+ * This function waits while the buffer is empty, then copies out up to max_n items in at most two
+ * contiguous runs. The producer waiting for space, if any, is woken up once for the whole batch.
+ * 
+ * @param batch Receives the removed items, oldest first
+ * @param max_n The largest number of items to remove
+ * @return The number of items removed, from 1 to max_n (0 only when max_n is 0)
+ */
+int Buffer::remove_items(buffer_item* batch, int max_n) {
+    return queue.remove_many(batch, max_n);
 }
 
 /**
@@ -158,7 +180,7 @@ bool Buffer::remove_item(buffer_item* item) {
  * @return The maximum size of the buffer
  */
 int Buffer::get_size() {
-    return max_size;  // Return the maximum size of the buffer
+    return queue.size();  // Return the maximum size of the buffer
 }
 
 /**
@@ -169,50 +191,61 @@ int Buffer::get_size() {
  * @return The current number of items in the buffer
  */
 int Buffer::get_count() {
-    return current_count;  // Return the current number of items in the buffer
+    return queue.count();  // Return the current number of items in the buffer
 }
 
 /**
  * @brief Checks if the buffer is empty
  * 
- * This function checks if the buffer is empty by comparing the item count to 0.
+ * This function checks if there is no item to remove.
  * 
  * @return true if the buffer is empty, false otherwise
  */
 bool Buffer::is_empty() {
-    return current_count == 0;  // Return true if the buffer is empty
+    return queue.empty();  // Return true if the buffer is empty
 }
 
 /**
  * @brief Checks if the buffer is full
  * 
- * This function checks if the buffer is full by comparing the item count to
- * the maximum size of the buffer.
+ * This function checks if there is no free slot to insert into.
  * 
  * @return true if the buffer is full, false otherwise
  */
 bool Buffer::is_full() {
-    return current_count == max_size;  // Return true if the buffer is full
-}
-
-/**
- * @brief Prints the contents of the buffer
- * 
- * This function prints the current items in the buffer. If the buffer is empty,
- * it prints a message indicating that the buffer is empty. It handles the circular
- * nature of the buffer when printing the items.
- */
-void Buffer::print_buffer() {
-    cout << "Buffer: [";
-    if (is_empty()) {
-        cout << "-- Buffer is empty --";  // If the buffer is empty, print this message
-    } else {
-        // Print the buffer items, handling the circular buffer logic
-        for (int i = 0, index = front_idx; i < current_count; i++) {
-            cout << items[index];  // Print each item in the buffer
-            if (i < current_count - 1) cout << ", ";  // Add commas between items
-            index = (index + 1) % max_size;  // Circular buffer logic: wrap around when empty
-        }
-    }
-    cout << "]\n";  // End the buffer printout
-}
\ No newline at end of file
+    return queue.full();  // Return true if the buffer is full
+}
+
+/**
+ * @brief Copies the contents of the buffer
+ * 
+ * This function copies the current items in the buffer under the lock, so the snapshot is consistent even while
+ * producers and consumers are running. The lock is held only for the copy, in at most two runs around the
+ * end of the array; the caller formats the items afterwards.
+ *
+ * @param batch Receives up to max_n of the items, oldest first
+ * @param max_n The largest number of items to copy
+ * @return The number of items in the buffer
+ */
+int Buffer::snapshot(buffer_item* batch, int max_n) {
+    return queue.snapshot(batch, max_n);
+}
+
+/**
+ * @brief Starts counting waits, blocked time, lock hold time and occupancy
+ * @return true, as the buffer keeps the counters
+ */
+bool Buffer::enable_stats() {
+    queue.enable_stats();
+    return true;
+}
+
+/**
+ * @brief Gets a snapshot of the counters
+ * @param stats Receives the counters
+ * @return true, as the buffer keeps the counters
+ */
+bool Buffer::get_stats(BufferStats& stats) {
+    stats = queue.stats();
+    return true;
+}
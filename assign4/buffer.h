@@ -8,43 +8,36 @@
 #ifndef BUFFER_H
 #define BUFFER_H
 
-#include <mutex>   // For std::mutex to handle thread synchronization
-#include <condition_variable> // For std::condition_variable to handle waiting and signaling
-
-// Define the data type of the buffer items
-typedef int buffer_item;
+#include "basic_buffer.h"  // For the templated buffer that does the work
+#include "bounded_buffer.h"  // For the BoundedBuffer interface and buffer_item
 
 /**
  * @brief The bounded buffer class. The number of items in the buffer cannot exceed the size of the buffer.
+ *        It is protected by a mutex, and producers and consumers wait on condition variables.
+ *        This is BasicBuffer<buffer_item> behind the BoundedBuffer interface; use BasicBuffer directly for other item types.
  */
-class Buffer {
+class Buffer : public BoundedBuffer {
 private:
-    buffer_item* items;     // Array to store buffer items
-    int max_size;          // Maximum size of the buffer
-    int current_count;     // Number of items currently in the buffer
-    int front_idx;         // Index for the front of the buffer
-    int rear_idx;          // Index for the rear of the buffer
-    std::mutex mutex;      // Mutex for thread synchronization
-    std::condition_variable empty_cond;  // Condition variable for empty buffer
-    std::condition_variable full_cond;   // Condition variable for full buffer
+    BasicBuffer<buffer_item> queue;  // The items, with the mutex and the condition variables that protect them
 
 public:
    /**
      * @brief Construct a new Buffer object
      * @param size the size of the buffer
+     * @param strategy how threads wait on a full or empty buffer, by default parking at once
      */
-    Buffer(int size = 5);   // Constructor with default size
+    Buffer(int size = 5, const WaitStrategy& strategy = WaitStrategy());   // Constructor with default size
 
     /**
      * @brief Destroy the Buffer object
      */
-    ~Buffer();              // Destructor
+    ~Buffer() override;              // Destructor
 
     /**
      * @brief Copy constructor for the Buffer class
      * 
      * This constructor is used when creating a new buffer as a copy of an existing buffer.
-     * It allocates new memory for the buffer and copies the contents from the other buffer.
+     * It copies the items of the other buffer, oldest first.
      * 
      * @param other The buffer object to copy from
      */
@@ -53,8 +46,8 @@ public:
     /**
      * @brief Assignment operator for the Buffer class
      * 
-     * This operator handles the assignment of one buffer to another. It ensures proper memory
-     * management by deleting any existing buffer data and copying the contents from the other buffer.
+     * This operator handles the assignment of one buffer to another, replacing the items with a copy of
+     * the items of the other buffer, locking both buffers while copying.
      * 
      * @param other The buffer object to assign from
      * @return A reference to this buffer object
@@ -67,7 +60,7 @@ public:
      * @return true if successful
      * @return false if not successful
      */
-    bool insert_item(buffer_item item);   // Adds item to the buffer
+    bool insert_item(buffer_item item) override;   // Adds item to the buffer
 
     /**
      * @brief Remove an item from the buffer
@@ -75,36 +68,122 @@ public:
      * @return true if successful
      * @return false if not successful
      */
-    bool remove_item(buffer_item* item);  // Removes item from the buffer
+    bool remove_item(buffer_item* item) override;  // Removes item from the buffer
+
+    /**
+     * @brief Insert an item into the buffer if there is a free slot, without waiting
+     * @param item the item to insert
+     * @return true if the item was inserted, false if the buffer is full
+     */
+    bool try_insert_item(buffer_item item) override;
+
+    /**
+     * @brief Remove an item from the buffer if there is one, without waiting
+     * @param item receives the removed item
+     * @return true if an item was removed, false if the buffer is empty
+     */
+    bool try_remove_item(buffer_item* item) override;
+
+    /**
+     * @brief Insert an item into the buffer, waiting at most a given time for a free slot
+     * @param item the item to insert
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if the item was inserted, false if the buffer stayed full
+     */
+    bool timed_insert_item(buffer_item item, long timeout_us) override;
+
+    /**
+     * @brief Remove an item from the buffer, waiting at most a given time for an item
+     * @param item receives the removed item
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if an item was removed, false if the buffer stayed empty
+     */
+    bool timed_remove_item(buffer_item* item, long timeout_us) override;
+
+    /**
+     * @brief Insert an item, waiting at most a given time, and copy the buffer under the same lock
+     * @param item the item to insert
+     * @param timeout_us the longest time to wait, in microseconds
+     * @param items receives up to max_n of the items, oldest first
+     * @param max_n the largest number of items to copy
+     * @param count receives the number of items in the buffer
+     * @return true if the item was inserted, false if the buffer stayed full
+     */
+    bool timed_insert_and_snapshot(buffer_item item, long timeout_us, buffer_item* items, int max_n,
+                                   int& count) override;
+
+    /**
+     * @brief Remove an item, waiting at most a given time, and copy the buffer under the same lock
+     * @param item receives the removed item
+     * @param timeout_us the longest time to wait, in microseconds
+     * @param items receives up to max_n of the items, oldest first
+     * @param max_n the largest number of items to copy
+     * @param count receives the number of items in the buffer
+     * @return true if an item was removed, false if the buffer stayed empty
+     */
+    bool timed_remove_and_snapshot(buffer_item* item, long timeout_us, buffer_item* items, int max_n,
+                                   int& count) override;
+
+    /**
+     * @brief Insert a batch of items under a single lock, waiting until there is at least one free slot
+     * @param items the items to insert, oldest first
+     * @param n the number of items
+     * @return the number of items inserted, from 1 to n (0 only when n is 0)
+     */
+    int insert_items(const buffer_item* items, int n) override;
+
+    /**
+     * @brief Remove a batch of items under a single lock, waiting until there is at least one item
+     * @param items receives the removed items, oldest first
+     * @param max_n the largest number of items to remove
+     * @return the number of items removed, from 1 to max_n (0 only when max_n is 0)
+     */
+    int remove_items(buffer_item* items, int max_n) override;
 
     /**
      * @brief Get the size of the buffer
      * @return the size of the buffer
      */
-    int get_size();     // Returns buffer size
+    int get_size() override;     // Returns buffer size
 
     /**
      * @brief Get the number of items in the buffer
      * @return the number of items in the buffer
      */
-    int get_count();      // Returns the current item count
+    int get_count() override;      // Returns the current item count
 
     /**
      * @brief Chceck if the buffer is empty
      * @return true if the buffer is empty, else false
      */
-    bool is_empty();    // Returns true if buffer is empty
+    bool is_empty() override;    // Returns true if buffer is empty
 
     /**
      * @brief Check if the buffer is full
      * @return true if the buffer is full, else false
      */
-    bool is_full();     // Returns true if buffer is full
+    bool is_full() override;     // Returns true if buffer is full
+
+    /**
+     * @brief Copy the items of the buffer, holding the lock only for the copy
+     * @param items receives up to max_n of the items
+     * @param max_n the largest number of items to copy
+     * @return the number of items in the buffer
+     */
+    int snapshot(buffer_item* items, int max_n) override;   // Copies buffer contents
+
+    /**
+     * @brief Start counting waits, blocked time, lock hold time and occupancy
+     * @return true
+     */
+    bool enable_stats() override;
 
     /**
-     * @brief Print the buffer
+     * @brief Get a snapshot of the counters
+     * @param stats receives the counters
+     * @return true
      */
-    void print_buffer();   // Prints buffer contents
+    bool get_stats(BufferStats& stats) override;
 };
 
 #endif // BUFFER_H
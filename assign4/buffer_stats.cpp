@@ -0,0 +1,53 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file buffer_stats.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Implementation file for the report of the buffer counters
+ * @version 0.1
+ */
+#include "buffer_stats.h"
+#include <cstdio>   // For snprintf
+
+using namespace std;
+
+/**
+ * @brief Formats the counters for printing
+ *
+ * The occupancy is shown as the share of changes in each range of slots in use, with at most ten ranges so that a
+ * large buffer still fits on a few lines.
+ *
+ * @return The report, one line per counter
+ */
+string BufferStats::report() const {
+    char line[160];
+    string text;
+    snprintf(line, sizeof(line), "Full waits: %llu, empty waits: %llu, blocked for %.3f ms\n",
+             (unsigned long long)full_waits, (unsigned long long)empty_waits, blocked_ns / 1e6);
+    text += line;
+    snprintf(line, sizeof(line), "Lock held %llu times for %.3f ms, %.0f ns on average\n", (unsigned long long)lock_holds,
+             lock_hold_ns / 1e6, lock_holds > 0 ? (double)lock_hold_ns / lock_holds : 0.0);
+    text += line;
+    snprintf(line, sizeof(line), "High-water mark: %zu of %zu slots\n", high_water, occupancy.size() - 1);
+    text += line;
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < occupancy.size(); i++) {
+        total += occupancy[i];
+    }
+    text += "Occupancy:";
+    size_t width = (occupancy.size() + 9) / 10;  // Slots per range
+    for (size_t low = 0; low < occupancy.size(); low += width) {
+        size_t high = low + width < occupancy.size() ? low + width : occupancy.size();
+        uint64_t count = 0;
+        for (size_t i = low; i < high; i++) {
+            count += occupancy[i];
+        }
+        if (high - low == 1) {
+            snprintf(line, sizeof(line), " %zu: %.1f%%", low, total > 0 ? 100.0 * count / total : 0.0);
+        } else {
+            snprintf(line, sizeof(line), " %zu-%zu: %.1f%%", low, high - 1, total > 0 ? 100.0 * count / total : 0.0);
+        }
+        text += line;
+    }
+    return text + "\n";
+}
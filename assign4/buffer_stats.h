@@ -0,0 +1,44 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file buffer_stats.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief The contention and occupancy counters of a buffer, to tell a starved stage from a saturated one.
+ * @version 0.1
+ */
+#ifndef BUFFER_STATS_H
+#define BUFFER_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A snapshot of the counters of a buffer. Many full waits mean the consumers cannot keep up, many empty
+ *        waits that the producers cannot; the occupancy histogram shows where the buffer spends its time.
+ */
+struct BufferStats {
+    uint64_t full_waits;            // Times a producer found the buffer full and had to wait
+    uint64_t empty_waits;           // Times a consumer found the buffer empty and had to wait
+    uint64_t blocked_ns;            // Total time threads spent waiting, spinning included
+    uint64_t lock_holds;            // Critical sections that moved items or slots
+    uint64_t lock_hold_ns;          // Total time those critical sections held the lock
+    size_t high_water;              // Most slots ever in use at once
+    std::vector<uint64_t> occupancy; // occupancy[n]: changes of the buffer that left n slots in use
+
+    /**
+     * @brief Construct zeroed counters
+     * @param size the number of slots of the buffer
+     */
+    explicit BufferStats(size_t size = 0)
+        : full_waits(0), empty_waits(0), blocked_ns(0), lock_holds(0), lock_hold_ns(0), high_water(0),
+          occupancy(size + 1, 0) {}
+
+    /**
+     * @brief Format the counters for printing, with the occupancy grouped into at most ten ranges
+     * @return the report, one line per counter
+     */
+    std::string report() const;
+};
+
+#endif // BUFFER_STATS_H
@@ -7,101 +7,216 @@
  * @version 0.1
  */
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>            // For the flag that stops the threads at shutdown
+#include "async_log.h"
+#include "benchmark.h"
 #include "buffer.h"
+#include "spsc_buffer.h"
+#include "mpmc_buffer.h"
+#include "sharded_buffer.h"
 #include <unistd.h>          // For usleep() function, which allows threads to sleep for a specified period of time (in microseconds).
-#include <pthread.h>         // For using POSIX threads (pthreads). This header provides functions to create and manage threads, and for thread synchronization using mutexes and condition variables.
-#include <semaphore.h>       // For using semaphores to manage synchronization. This header provides functions for semaphore initialization, wait, and signal operations, allowing threads to coordinate their execution.
+#include <pthread.h>         // For using POSIX threads (pthreads). This header provides functions to create and manage threads.
 
 
 using namespace std;
 
-// Global buffer object with size 5
-Buffer buffer(5);  // Initialize buffer with size 5
-pthread_mutex_t mutex_lock;   // Mutex lock to synchronize access to the buffer
-sem_t empty_slots;            // Semaphore to manage empty slots in the buffer
-sem_t full_slots;             // Semaphore to manage full slots in the buffer
+// Global buffer object with size 5, created in main with the implementation chosen on the command line
+// The buffer does all of the synchronisation itself, so the threads take no locks of their own
+BoundedBuffer* buffer = nullptr;
+AsyncLog* event_log = nullptr;    // The threads log through it, so none of them ever waits for stdout
+std::atomic<bool> running(true);  // Cleared by main at shutdown, the threads then finish their current item and exit
+
+// How long a thread waits on a full or empty buffer before it checks whether to shut down, in microseconds
+const long POLL_US = 100000;
 
 /**
  * @brief Producer thread function
  * 
  * This function is executed by each producer thread. Each producer will insert its unique
- * ID (passed as a parameter) into the buffer. The producer will wait if the buffer is full
- * and insert the item when there is space available. After inserting an item, the producer 
- * signals the consumer that there is an item to consume.
+ * ID (passed as a parameter) into the buffer. The buffer makes the producer wait while it is full
+ * and wakes up a waiting consumer once the item is inserted.
  * 
- * @param param Pointer to the producer's unique ID
+ * @param param Pointer to the producer's unique ID, which is also one more than the index of its log ring
  */
 void* producer(void* param) {
     int producer_id = *((int*)param);  // Get producer ID from arguments
     buffer_item item = producer_id;    // Producer will insert its unique ID as an item
 
-    // Infinite loop to continuously produce items
-    while (true) {
+    // Loop to continuously produce items until shutdown
+    while (running) {
         /* Sleep for a random period of time to simulate production delay */
         usleep(rand() % 1000000);  
 
-        // Wait for an empty slot in the buffer (if the buffer is full, wait)
-        sem_wait(&empty_slots);  
-
-        // Enter critical section (access to the buffer is protected by mutex)
-        pthread_mutex_lock(&mutex_lock);  
-
-        // Try to insert the item into the buffer
-        if (buffer.insert_item(item)) {  
-            cout << "Producer " << producer_id << ": Inserted item " << item << endl;
-            buffer.print_buffer();  // Print the current state of the buffer
+        // Insert the item into the buffer, waiting while it is full but still checking for shutdown. The buffer
+        // is copied into the record in the same critical section as the insert, so the copy shows this insert
+        LogRecord record;
+        bool inserted = false;
+        while (running && !(inserted = buffer->timed_insert_and_snapshot(item, POLL_US, record.items,
+                                                                          LogRecord::SNAPSHOT_ITEMS, record.count))) {
+        }
+        if (inserted) {  
+            // Queue the event and the copy of the buffer; the logger thread prints them
+            record.kind = LogRecord::INSERTED;
+            record.thread_id = producer_id;
+            record.item = item;
+            event_log->log(producer_id - 1, record);
         }
-
-        // Exit critical section after modifying the buffer
-        pthread_mutex_unlock(&mutex_lock);  
-
-        // Signal that the consumer can now consume the item (buffer is no longer empty)
-        sem_post(&full_slots);  
     }
+    return NULL;
 }
 
 /**
  * @brief Consumer thread function
  * 
  * This function is executed by each consumer thread. The consumer will remove an item from
- * the buffer. The consumer will wait if the buffer is empty and consume an item when there
- * is one available. After removing an item, the consumer signals the producer that there is
- * space available in the buffer for a new item.
+ * the buffer. The buffer makes the consumer wait while it is empty and wakes up a waiting
+ * producer once there is space available for a new item.
  * 
- * @param param Unused, no arguments are passed to the consumer thread
+ * @param param Pointer to the index of the consumer's log ring
  */
 void* consumer(void* param) {
+    int log_ring = *((int*)param);  // Get the consumer's log ring from arguments
     buffer_item item;  // Variable to store the item removed from the buffer
 
-    // Infinite loop to continuously consume items
-    while (true) {
+    // Loop to continuously consume items until shutdown
+    while (running) {
         /* Sleep for a random period of time to simulate consumption delay */
         usleep(rand() % 1000000);  
 
-        // Wait for a full slot in the buffer (if the buffer is empty, wait)
-        sem_wait(&full_slots);  
+        // Remove an item from the buffer, waiting while it is empty but still checking for shutdown. The buffer
+        // is copied into the record in the same critical section as the removal
+        LogRecord record;
+        bool removed = false;
+        while (running && !(removed = buffer->timed_remove_and_snapshot(&item, POLL_US, record.items,
+                                                                        LogRecord::SNAPSHOT_ITEMS, record.count))) {
+        }
+        if (removed) {  
+            // Queue the event and the copy of the buffer; the logger thread prints them
+            record.kind = LogRecord::REMOVED;
+            record.thread_id = 0;
+            record.item = item;
+            event_log->log(log_ring, record);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Create the buffer implementation named on the command line
+ *
+ * "mutex" is the Buffer protected by a mutex and condition variables, "spsc" the lock-free ring for one producer
+ * and one consumer, "mpmc" the lock-free queue for any number of producers and consumers, and "sharded" one
+ * lock-free queue per producer with the consumers stealing from each other's queues.
+ *
+ * @param name The name of the implementation
+ * @param size The size of the buffer
+ * @param strategy How the threads wait on the mutex and sharded buffers; the other lock-free buffers always yield
+ * @param shards The number of shards of the sharded buffer, one per producer
+ * @return The buffer, or nullptr if the name is unknown
+ */
+BoundedBuffer* make_buffer(const char* name, int size, const WaitStrategy& strategy = WaitStrategy(), int shards = 1) {
+    if (strcmp(name, "mutex") == 0) return new Buffer(size, strategy);
+    if (strcmp(name, "spsc") == 0) return new SpscBuffer(size);
+    if (strcmp(name, "mpmc") == 0) return new MpmcBuffer(size);
+    if (strcmp(name, "sharded") == 0) return new ShardedBuffer(size, shards, strategy);
+    return nullptr;
+}
 
-        // Enter critical section (access to the buffer is protected by mutex)
-        pthread_mutex_lock(&mutex_lock);  
+/**
+ * @brief Print the counters of a buffer, if it keeps them
+ * @param buffer The buffer
+ */
+void print_stats(BoundedBuffer& buffer) {
+    BufferStats stats;
+    if (buffer.get_stats(stats)) {
+        cout << "Buffer statistics:\n" << stats.report() << flush;
+    }
+}
 
-        // Try to remove an item from the buffer
-        if (buffer.remove_item(&item)) {  
-            cout << "Consumer: Removed item " << item << endl;
-            buffer.print_buffer();  // Print the current state of the buffer
-        }
+/**
+ * @brief Run the benchmark mode: ./prog4 -b [-k kind] [-p producers] [-c consumers] [-s size] [-d seconds]
+ *        [-w spins[,yields]] [-S]
+ * @param argc The number of arguments
+ * @param argv The arguments, starting with -b
+ * @return The exit status
+ */
+int benchmark_main(int argc, char* argv[]) {
+    const char* kind = "mutex";
+    int size = 1024;
+    WaitStrategy strategy;
+    bool with_stats = false;
+    BenchmarkConfig config;
+    config.producers = 1;
+    config.consumers = 1;
+    config.seconds = 2;
 
-        // Exit critical section after modifying the buffer
-        pthread_mutex_unlock(&mutex_lock);  
+    int opt;
+    optind = 2;  // Skip the -b
+    while ((opt = getopt(argc, argv, "k:p:c:s:d:w:S")) != -1) {
+        switch (opt) {
+        case 'k': kind = optarg; break;
+        case 'p': config.producers = atoi(optarg); break;
+        case 'c': config.consumers = atoi(optarg); break;
+        case 's': size = atoi(optarg); break;
+        case 'd': config.seconds = atof(optarg); break;
+        case 'w': {
+            char* rest;
+            strategy.spins = strtol(optarg, &rest, 10);
+            strategy.yields = *rest == ',' ? atoi(rest + 1) : 0;
+            break;
+        }
+        case 'S': with_stats = true; break;
+        default:
+            cout << "Usage: ./prog4 -b [-k mutex|spsc|mpmc|sharded] [-p producers] [-c consumers] [-s size] [-d seconds]"
+                 << " [-w spins[,yields]] [-S]" << endl;
+            return 1;
+        }
+    }
+    if (config.producers < 1 || config.consumers < 1 || size < 1 || config.seconds <= 0) {
+        cout << "The numbers of producers and consumers, the size and the duration must be positive" << endl;
+        return 1;
+    }
+    if (strategy.spins < 0 || strategy.yields < 0) {
+        cout << "The numbers of spins and yields cannot be negative" << endl;
+        return 1;
+    }
+    if (strcmp(kind, "spsc") == 0 && (config.producers != 1 || config.consumers != 1)) {
+        cout << "The spsc buffer needs exactly 1 producer and 1 consumer" << endl;
+        return 1;
+    }
+    BoundedBuffer* bench_buffer = make_buffer(kind, size, strategy, config.producers);
+    if (bench_buffer == nullptr) {
+        cout << "Unknown buffer implementation " << kind << endl;
+        return 1;
+    }
 
-        // Signal that space is now available in the buffer for the producer
-        sem_post(&empty_slots);  
+    cout << "Benchmark: " << kind << " buffer of size " << bench_buffer->get_size() << ", " << config.producers
+         << " producers, " << config.consumers << " consumers, " << config.seconds << " s";
+    if (strcmp(kind, "mutex") == 0 || strcmp(kind, "sharded") == 0) {
+        cout << ", waiting with " << strategy.spins << " spins and " << strategy.yields << " yields before parking";
+    }
+    cout << endl;
+    if (with_stats && !bench_buffer->enable_stats()) {
+        cout << "The " << kind << " buffer keeps no statistics" << endl;
     }
+    print_benchmark(run_benchmark(*bench_buffer, config));
+    print_stats(*bench_buffer);
+    delete bench_buffer;
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "-b") == 0) {
+        return benchmark_main(argc, argv);
+    }
+
     // Ensure correct number of arguments
-    if (argc != 4) {
-        cout << "Usage: ./producer_consumer <sleep_time> <num_producers> <num_consumers>" << endl;
+    if (argc != 4 && argc != 5) {
+        cout << "Usage: ./producer_consumer <sleep_time> <num_producers> <num_consumers> [mutex|spsc|mpmc|sharded]" << endl;
+        cout << "       ./producer_consumer -b [-k mutex|spsc|mpmc|sharded] [-p producers] [-c consumers] [-s size] [-d seconds]"
+             << " [-w spins[,yields]] [-S]" << endl;
         return 1;
     }
 
@@ -109,24 +224,35 @@ int main(int argc, char* argv[]) {
     int sleep_time = atoi(argv[1]);      // Time for which the main thread will sleep
     int num_producers = atoi(argv[2]);   // Number of producer threads
     int num_consumers = atoi(argv[3]);   // Number of consumer threads
+    const char* kind = argc == 5 ? argv[4] : "mutex";  // Buffer implementation, the mutex Buffer by default
 
-    // Initialize semaphores and mutex
-    sem_init(&empty_slots, 0, buffer.get_size());  // Set initial empty slots to buffer size
-    sem_init(&full_slots, 0, 0);                  // Set initial full slots to 0
-    pthread_mutex_init(&mutex_lock, NULL);        // Initialize the mutex lock for synchronization
+    // Create the buffer; the single-producer single-consumer ring only supports one thread on each side
+    if (strcmp(kind, "spsc") == 0 && (num_producers != 1 || num_consumers != 1)) {
+        cout << "The spsc buffer needs exactly 1 producer and 1 consumer" << endl;
+        return 1;
+    }
+    buffer = make_buffer(kind, 5, WaitStrategy(), num_producers);
+    if (buffer == nullptr) {
+        cout << "Unknown buffer implementation " << kind << endl;
+        return 1;
+    }
+    buffer->enable_stats();  // Printed at shutdown by the buffers that keep them
 
-    // Arrays to store thread IDs for producers and consumers
+    // Arrays to store thread IDs for producers and consumers, and the unique IDs of the producers
     pthread_t producers[num_producers], consumers[num_consumers];
+    int producer_ids[num_producers], consumer_rings[num_consumers];
+    event_log = new AsyncLog(num_producers + num_consumers);  // One log ring for each thread
 
     // Create producer threads
     for (int i = 0; i < num_producers; i++) {
-        int* producer_id = new int(i + 1);  // Assign a unique ID to each producer
-        pthread_create(&producers[i], NULL, producer, (void*)producer_id);  // Create producer thread
+        producer_ids[i] = i + 1;  // Assign a unique ID to each producer
+        pthread_create(&producers[i], NULL, producer, (void*)&producer_ids[i]);  // Create producer thread
     }
 
     // Create consumer threads
     for (int j = 0; j < num_consumers; j++) {
-        pthread_create(&consumers[j], NULL, consumer, NULL);  // Create consumer thread
+        consumer_rings[j] = num_producers + j;  // The consumers' log rings follow the producers'
+        pthread_create(&consumers[j], NULL, consumer, (void*)&consumer_rings[j]);  // Create consumer thread
     }
 
     // Main thread sleeps for the specified time to allow producers and consumers to run
@@ -134,10 +260,21 @@ int main(int argc, char* argv[]) {
 
     cout << "Main thread: Time's up! Shutting down..." << endl;
 
-    // Clean up and destroy semaphores and mutex before exiting
-    sem_destroy(&empty_slots);  // Destroy empty slots semaphore
-    sem_destroy(&full_slots);   // Destroy full slots semaphore
-    pthread_mutex_destroy(&mutex_lock);  // Destroy the mutex lock
+    // Stop the threads and wait for them to finish their current item before the buffer goes away
+    running = false;
+    for (int i = 0; i < num_producers; i++) {
+        pthread_join(producers[i], NULL);
+    }
+    for (int j = 0; j < num_consumers; j++) {
+        pthread_join(consumers[j], NULL);
+    }
+    event_log->stop();  // Print the events still queued
+    print_stats(*buffer);
+    if (event_log->dropped() > 0) {
+        cout << "Main thread: " << event_log->dropped() << " log records were dropped" << endl;
+    }
+    delete event_log;
+    delete buffer;
 
     return 0;  // Exit the program
 }
\ No newline at end of file
@@ -0,0 +1,390 @@
+/**
+* Assignment 4: Producer Consumer Problem
+ * @file mpmc_buffer.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Implementation file for the lock-free multi-producer multi-consumer bounded queue
+ * @version 0.1
+ */
+#include "mpmc_buffer.h"
+#include <algorithm> // For std::min
+#include <chrono>    // For the deadline of the timed operations
+#include <cstdint>   // For intptr_t to compare positions across the wrap-around
+#include <cstdlib>   // For posix_memalign and free
+#include <new>       // For std::bad_alloc
+#include <thread>  // For std::this_thread::yield while waiting
+
+using namespace std;
+
+/**
+ * @brief Constructor for the MpmcBuffer class
+ *
+ * The slots are rounded up to a power of two, and slot i starts with sequence i, ready for the producer at
+ * position i. There are at least two slots: with one, a slot filled at position p and a slot free for position
+ * p + 1 would both have sequence p + 1. The capacity stays the size asked for.
+ *
+ * @param size The size of the buffer (default is 5)
+ */
+MpmcBuffer::MpmcBuffer(int size) : enqueue_pos(0), dequeue_pos(0) {
+    capacity = size > 0 ? size : 1;
+    size_t slots = 2;
+    while (slots < capacity) {
+        slots <<= 1;
+    }
+    mask = slots - 1;
+    cells = new Cell[slots];
+    for (size_t i = 0; i < slots; i++) {
+        cells[i].sequence.store(i, memory_order_relaxed);
+        cells[i].item.store(0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Destructor for the MpmcBuffer class
+ */
+MpmcBuffer::~MpmcBuffer() {
+    delete[] cells;
+}
+
+/**
+ * @brief Allocate a buffer on a cache line boundary, so the padded counters really are on separate lines
+ * @param size The size of the object
+ * @return The memory
+ */
+void* MpmcBuffer::operator new(size_t size) {
+    void* ptr;
+    if (posix_memalign(&ptr, 64, size) != 0) {
+        throw bad_alloc();
+    }
+    return ptr;
+}
+
+/**
+ * @brief Free a buffer allocated with operator new
+ * @param ptr The memory
+ */
+void MpmcBuffer::operator delete(void* ptr) {
+    free(ptr);
+}
+
+/**
+ * @brief Try to insert an item without waiting
+ *
+ * The producer claims the next position if its slot has been emptied for this lap (sequence == position). A
+ * sequence behind the position means the slot still holds the item of the previous lap, so the buffer is full.
+ * A sequence ahead of it means another producer claimed the position first, so the producer reloads the position.
+ * When the capacity is below the number of slots, a free slot is only claimed while fewer than capacity items are
+ * ahead of it; the consumers' position only grows, so the check stays true once made.
+ *
+ * @param item The item to insert into the buffer
+ * @return true if the item was inserted, false if the buffer is full
+ */
+bool MpmcBuffer::try_insert_item(buffer_item item) {
+    size_t pos = enqueue_pos.load(memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (capacity <= mask && (intptr_t)(pos - dequeue_pos.load(memory_order_acquire)) >= (intptr_t)capacity) {
+                return false;
+            }
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueue_pos.load(memory_order_relaxed);
+        }
+    }
+    cell->item.store(item, memory_order_relaxed);
+    cell->sequence.store(pos + 1, memory_order_release);  // Hand the slot over to the consumer of this position
+    return true;
+}
+
+/**
+ * @brief Try to remove an item without waiting
+ *
+ * The consumer claims the next position if its slot has been filled for this lap (sequence == position + 1). A
+ * sequence behind that means the slot is not filled yet, so the buffer is empty.
+ *
+ * @param item Pointer to a variable to store the removed item
+ * @return true if an item was removed, false if the buffer is empty
+ */
+bool MpmcBuffer::try_remove_item(buffer_item* item) {
+    size_t pos = dequeue_pos.load(memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (dequeue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = dequeue_pos.load(memory_order_relaxed);
+        }
+    }
+    *item = cell->item.load(memory_order_relaxed);
+    cell->sequence.store(pos + mask + 1, memory_order_release);  // Hand the slot over to the producer of the next lap
+    return true;
+}
+
+/**
+ * @brief Inserts an item into the buffer, yielding the CPU while the buffer is full
+ * @param item The item to insert into the buffer
+ * @return true when the item is inserted
+ */
+bool MpmcBuffer::insert_item(buffer_item item) {
+    while (!try_insert_item(item)) {
+        this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Removes an item from the buffer, yielding the CPU while the buffer is empty
+ * @param item Pointer to a variable to store the removed item
+ * @return true when an item is removed
+ */
+bool MpmcBuffer::remove_item(buffer_item* item) {
+    while (!try_remove_item(item)) {
+        this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Inserts an item into the buffer, spinning at most a given time while it is full
+ * @param item The item to insert into the buffer
+ * @param timeout_us The longest time to wait, in microseconds
+ * @return true if the item was inserted, false if the buffer stayed full
+ */
+bool MpmcBuffer::timed_insert_item(buffer_item item, long timeout_us) {
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::microseconds(timeout_us);
+    while (!try_insert_item(item)) {
+        if (chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Removes an item from the buffer, spinning at most a given time while it is empty
+ * @param item Pointer to a variable to store the removed item
+ * @param timeout_us The longest time to wait, in microseconds
+ * @return true if an item was removed, false if the buffer stayed empty
+ */
+bool MpmcBuffer::timed_remove_item(buffer_item* item, long timeout_us) {
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::microseconds(timeout_us);
+    while (!try_remove_item(item)) {
+        if (chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Try to claim a run of positions for a batch
+ *
+ * The slots from the position onwards are ready while their sequence equals the position plus the offset. Slots
+ * at or after the claim position only ever change by becoming ready, so the run found stays valid until the
+ * compare-and-swap claims it. Producers also stop at the capacity, counted from the consumers' position.
+ *
+ * @param pos The shared claim position, enqueue_pos or dequeue_pos
+ * @param lag The sequence of a ready slot minus its position: 0 for producers, 1 for consumers
+ * @param n The largest number of positions to claim
+ * @param first Receives the first claimed position
+ * @return The number of positions claimed, 0 if the first slot is not ready
+ */
+size_t MpmcBuffer::claim_run(atomic<size_t>& pos, size_t lag, size_t n, size_t& first) {
+    size_t start = pos.load(memory_order_relaxed);
+    while (true) {
+        size_t count = 0;
+        bool raced = false;
+        size_t limit = n;
+        if (lag == 0 && capacity <= mask) {
+            intptr_t room = (intptr_t)capacity - (intptr_t)(start - dequeue_pos.load(memory_order_acquire));
+            if (room <= 0) {
+                return 0;
+            }
+            limit = std::min(limit, (size_t)room);
+        }
+        while (count < limit) {
+            intptr_t diff = (intptr_t)cells[(start + count) & mask].sequence.load(memory_order_acquire)
+                          - (intptr_t)(start + count + lag);
+            if (diff != 0) {
+                raced = diff > 0 && count == 0;  // Another thread claimed the first position already
+                break;
+            }
+            count++;
+        }
+        if (count == 0 && !raced) {
+            return 0;
+        }
+        if (count > 0 && pos.compare_exchange_weak(start, start + count, memory_order_relaxed)) {
+            first = start;
+            return count;
+        }
+        if (raced) {
+            start = pos.load(memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Inserts a batch of items by claiming a run of positions at once, yielding the CPU while the buffer is full
+ *
+ * A single compare-and-swap claims the positions. Each slot still carries its own sequence, so the items are
+ * copied and published slot by slot rather than with one block copy.
+ *
+ * @param batch The items to insert, oldest first
+ * @param n The number of items
+ * @return The number of items inserted, from 1 to n (0 only when n is 0)
+ */
+int MpmcBuffer::insert_items(const buffer_item* batch, int n) {
+    if (n <= 0) {
+        return 0;
+    }
+    int count;
+    while ((count = try_insert_items(batch, n)) == 0) {
+        this_thread::yield();
+    }
+    return count;
+}
+
+/**
+ * @brief Removes a batch of items by claiming a run of positions at once, yielding the CPU while the buffer is empty
+ * @param batch Receives the removed items, oldest first
+ * @param max_n The largest number of items to remove
+ * @return The number of items removed, from 1 to max_n (0 only when max_n is 0)
+ */
+int MpmcBuffer::remove_items(buffer_item* batch, int max_n) {
+    if (max_n <= 0) {
+        return 0;
+    }
+    int count;
+    while ((count = try_remove_items(batch, max_n)) == 0) {
+        this_thread::yield();
+    }
+    return count;
+}
+
+/**
+ * @brief Inserts a batch of items by claiming a run of positions at once, without waiting
+ * @param batch The items to insert, oldest first
+ * @param n The number of items
+ * @return The number of items inserted, 0 if the buffer is full or n is 0
+ */
+int MpmcBuffer::try_insert_items(const buffer_item* batch, int n) {
+    if (n <= 0) {
+        return 0;
+    }
+    size_t first;
+    size_t count = claim_run(enqueue_pos, 0, std::min((size_t)n, capacity), first);
+    for (size_t i = 0; i < count; i++) {
+        Cell& cell = cells[(first + i) & mask];
+        cell.item.store(batch[i], memory_order_relaxed);
+        cell.sequence.store(first + i + 1, memory_order_release);
+    }
+    return count;
+}
+
+/**
+ * @brief Removes a batch of items by claiming a run of positions at once, without waiting
+ * @param batch Receives the removed items, oldest first
+ * @param max_n The largest number of items to remove
+ * @return The number of items removed, 0 if the buffer is empty or max_n is 0
+ */
+int MpmcBuffer::try_remove_items(buffer_item* batch, int max_n) {
+    if (max_n <= 0) {
+        return 0;
+    }
+    size_t first;
+    size_t count = claim_run(dequeue_pos, 1, std::min((size_t)max_n, capacity), first);
+    for (size_t i = 0; i < count; i++) {
+        Cell& cell = cells[(first + i) & mask];
+        batch[i] = cell.item.load(memory_order_relaxed);
+        cell.sequence.store(first + i + mask + 1, memory_order_release);
+    }
+    return count;
+}
+
+/**
+ * @brief Gets the size of the buffer
+ * @return The capacity of the buffer, the size it was constructed with
+ */
+int MpmcBuffer::get_size() {
+    return capacity;
+}
+
+/**
+ * @brief Gets the current item count in the buffer
+ *
+ * The positions are read separately, so while threads are running the count is only an estimate; it is clamped
+ * to the capacity of the buffer.
+ *
+ * @return The current number of items in the buffer
+ */
+int MpmcBuffer::get_count() {
+    size_t dequeued = dequeue_pos.load(memory_order_acquire);
+    size_t enqueued = enqueue_pos.load(memory_order_acquire);
+    if (enqueued <= dequeued) {
+        return 0;
+    }
+    return enqueued - dequeued > capacity ? capacity : enqueued - dequeued;
+}
+
+/**
+ * @brief Checks if the buffer is empty
+ * @return true if the buffer is empty, false otherwise
+ */
+bool MpmcBuffer::is_empty() {
+    return get_count() == 0;
+}
+
+/**
+ * @brief Checks if the buffer is full
+ * @return true if the buffer is full, false otherwise
+ */
+bool MpmcBuffer::is_full() {
+    return get_count() == get_size();
+}
+
+/**
+ * @brief Copies the contents of the buffer, from the oldest item to the newest
+ *
+ * Each slot is read like a seqlock: its sequence must say its item is filled for this position both before and
+ * after the item is read. Otherwise a consumer emptied it or a producer has not filled it yet, and the copy, and
+ * the count returned, stop there.
+ *
+ * @param batch Receives up to max_n of the items
+ * @param max_n The largest number of items to copy
+ * @return The number of items in the buffer
+ */
+int MpmcBuffer::snapshot(buffer_item* batch, int max_n) {
+    size_t dequeued = dequeue_pos.load(memory_order_acquire);
+    int count = get_count();
+    for (int i = 0; i < count && i < max_n; i++) {
+        Cell& cell = cells[(dequeued + i) & mask];
+        size_t ready = dequeued + i + 1;
+        if (cell.sequence.load(memory_order_acquire) != ready) {
+            return i;
+        }
+        buffer_item item = cell.item.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);  // Order the read of the item before the second check
+        if (cell.sequence.load(memory_order_relaxed) != ready) {
+            return i;
+        }
+        batch[i] = item;
+    }
+    return count;
+}
@@ -0,0 +1,191 @@
+/**
+* Assignment 4: Producer Consumer Problem
+ * @file mpmc_buffer.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief header file for the lock-free multi-producer multi-consumer bounded queue
+ * @version 0.1
+ */
+#ifndef MPMC_BUFFER_H
+#define MPMC_BUFFER_H
+
+#include <atomic>  // For std::atomic positions and sequence numbers
+#include <cstddef> // For size_t
+#include "bounded_buffer.h"
+
+/**
+ * @brief A lock-free bounded buffer for any number of producer and consumer threads, after Dmitry Vyukov's bounded
+ *        MPMC queue.
+ *
+ * Every slot has a sequence number that says whose turn it is: a producer at position pos may fill the slot when
+ * its sequence is pos, and a consumer at position pos may empty it when its sequence is pos + 1. Producers and
+ * consumers claim positions with a compare-and-swap on their own counter, so they never contend with each other,
+ * and a claimed slot is handed over with a single release store of its sequence. The number of slots is a power of
+ * two, rounded up from the size, but producers only claim a position while fewer than size items are ahead of it,
+ * so the buffer holds exactly size items like the other buffers.
+ */
+class MpmcBuffer : public BoundedBuffer {
+private:
+    /**
+     * @brief A slot of the queue: the item and the sequence number that orders the accesses to it.
+     */
+    struct Cell {
+        std::atomic<size_t> sequence;
+        std::atomic<buffer_item> item;      // Relaxed accesses, ordered by the sequence; atomic so snapshot may read it
+    };
+
+    Cell* cells;            // Array of slots, with a power-of-two size
+    size_t mask;            // Number of slots minus one, to find the slot of a position
+    size_t capacity;        // The size asked for, at most mask + 1: the most items the buffer holds
+
+    alignas(64) std::atomic<size_t> enqueue_pos;  // Next position to fill, claimed by the producers
+    alignas(64) std::atomic<size_t> dequeue_pos;  // Next position to empty, claimed by the consumers
+
+    /**
+     * @brief Claim the longest run of ready positions, up to n, with a single compare-and-swap
+     * @param pos the claim position, enqueue_pos or dequeue_pos
+     * @param lag the sequence of a ready slot minus its position: 0 for producers, 1 for consumers
+     * @param n the largest number of positions to claim
+     * @param first receives the first claimed position
+     * @return the number of positions claimed, 0 if the first slot is not ready
+     */
+    size_t claim_run(std::atomic<size_t>& pos, size_t lag, size_t n, size_t& first);
+
+public:
+   /**
+     * @brief Construct a new MpmcBuffer object
+     * @param size the size of the buffer; the slots are rounded up to a power of two, the capacity is not
+     */
+    MpmcBuffer(int size = 5);
+
+    /**
+     * @brief Destroy the MpmcBuffer object
+     */
+    ~MpmcBuffer() override;
+
+    MpmcBuffer(const MpmcBuffer&) = delete;
+    MpmcBuffer& operator=(const MpmcBuffer&) = delete;
+
+    /**
+     * @brief Allocate a buffer on a cache line boundary, which plain new does not guarantee before C++17
+     * @param size the size of the object
+     * @return the memory
+     */
+    static void* operator new(size_t size);
+
+    /**
+     * @brief Free a buffer allocated with operator new
+     * @param ptr the memory
+     */
+    static void operator delete(void* ptr);
+
+    /**
+     * @brief Try to insert an item without waiting
+     * @param item the item to insert
+     * @return true if the item was inserted, false if the buffer is full
+     */
+    bool try_insert_item(buffer_item item) override;
+
+    /**
+     * @brief Try to remove an item without waiting
+     * @param item receives the removed item
+     * @return true if an item was removed, false if the buffer is empty
+     */
+    bool try_remove_item(buffer_item* item) override;
+
+    /**
+     * @brief Insert an item into the buffer, spinning while it is full
+     * @param item the item to insert
+     * @return true when the item is inserted
+     */
+    bool insert_item(buffer_item item) override;
+
+    /**
+     * @brief Remove an item from the buffer, spinning while it is empty
+     * @param item the item to remove
+     * @return true when an item is removed
+     */
+    bool remove_item(buffer_item* item) override;
+
+    /**
+     * @brief Insert an item, spinning at most a given time while the buffer is full
+     * @param item the item to insert
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if the item was inserted, false if the buffer stayed full
+     */
+    bool timed_insert_item(buffer_item item, long timeout_us) override;
+
+    /**
+     * @brief Remove an item, spinning at most a given time while the buffer is empty
+     * @param item receives the removed item
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if an item was removed, false if the buffer stayed empty
+     */
+    bool timed_remove_item(buffer_item* item, long timeout_us) override;
+
+    /**
+     * @brief Insert a batch of items by claiming a run of positions at once, waiting until there is at least one free slot
+     * @param items the items to insert, oldest first
+     * @param n the number of items
+     * @return the number of items inserted, from 1 to n (0 only when n is 0)
+     */
+    int insert_items(const buffer_item* items, int n) override;
+
+    /**
+     * @brief Remove a batch of items by claiming a run of positions at once, waiting until there is at least one item
+     * @param items receives the removed items, oldest first
+     * @param max_n the largest number of items to remove
+     * @return the number of items removed, from 1 to max_n (0 only when max_n is 0)
+     */
+    int remove_items(buffer_item* items, int max_n) override;
+
+    /**
+     * @brief Insert a batch of items by claiming a run of positions at once, without waiting
+     * @param items the items to insert, oldest first
+     * @param n the number of items
+     * @return the number of items inserted, 0 if the buffer is full
+     */
+    int try_insert_items(const buffer_item* items, int n);
+
+    /**
+     * @brief Remove a batch of items by claiming a run of positions at once, without waiting
+     * @param items receives the removed items, oldest first
+     * @param max_n the largest number of items to remove
+     * @return the number of items removed, 0 if the buffer is empty
+     */
+    int try_remove_items(buffer_item* items, int max_n);
+
+    /**
+     * @brief Get the size of the buffer
+     * @return the size of the buffer
+     */
+    int get_size() override;
+
+    /**
+     * @brief Get the number of items in the buffer, a snapshot while the threads are running
+     * @return the number of items in the buffer
+     */
+    int get_count() override;
+
+    /**
+     * @brief Chceck if the buffer is empty
+     * @return true if the buffer is empty, else false
+     */
+    bool is_empty() override;
+
+    /**
+     * @brief Check if the buffer is full
+     * @return true if the buffer is full, else false
+     */
+    bool is_full() override;
+
+    /**
+     * @brief Copy the items of the buffer, oldest first. Each copied item was in the buffer at its position; the
+     *        copy stops early at a slot that changed while it was read, and the count is cut down to match.
+     * @param items receives up to max_n of the items
+     * @param max_n the largest number of items to copy
+     * @return the number of items in the buffer
+     */
+    int snapshot(buffer_item* items, int max_n) override;
+};
+
+#endif // MPMC_BUFFER_H
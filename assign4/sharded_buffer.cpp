@@ -0,0 +1,389 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file sharded_buffer.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Implementation file for the sharded buffer with work stealing
+ * @version 0.1
+ */
+#include "sharded_buffer.h"
+#include <thread>    // For std::this_thread::yield while waiting
+#include <utility>   // For std::pair
+
+using namespace std;
+
+// Number of the next sharded buffer; addresses are reused, so buffers are told apart by number
+static atomic<size_t> next_buffer_id(0);
+
+// The calling thread's numbers as a producer and as a consumer, one (buffer, number) pair per buffer it has used
+static thread_local vector<pair<size_t, size_t> > producer_numbers;
+static thread_local vector<pair<size_t, size_t> > consumer_numbers;
+
+/**
+ * @brief Finds the calling thread's number for a buffer, drawing the next one the first time
+ * @param numbers The thread's numbers, by buffer
+ * @param id The number of the buffer
+ * @param next The buffer's counter to draw the thread's number from
+ * @return The number of the thread
+ */
+static size_t thread_number(vector<pair<size_t, size_t> >& numbers, size_t id, atomic<size_t>& next) {
+    for (size_t i = 0; i < numbers.size(); i++) {
+        if (numbers[i].first == id) {
+            return numbers[i].second;
+        }
+    }
+    size_t number = next.fetch_add(1, memory_order_relaxed);
+    numbers.push_back(make_pair(id, number));
+    return number;
+}
+
+/**
+ * @brief Constructor for the ShardedBuffer class
+ *
+ * The size is split exactly between the shards: each gets size / num_shards slots and the first size % num_shards
+ * get one more, so the shards hold size items in all. Every shard holds at least one item, so a size below the
+ * number of shards is raised to it.
+ *
+ * @param size The total size of the buffer (default is 5)
+ * @param num_shards The number of shards (default is 1)
+ * @param strategy How threads wait on a full home shard or an empty buffer (default parks at once)
+ */
+ShardedBuffer::ShardedBuffer(int size, int num_shards, const WaitStrategy& strategy)
+    : id(next_buffer_id.fetch_add(1, memory_order_relaxed)), next_producer(0), next_consumer(0), strategy(strategy),
+      space_parked(0), items_parked(0) {
+    if (num_shards < 1) {
+        num_shards = 1;
+    }
+    if (size < num_shards) {
+        size = num_shards;
+    }
+    for (int i = 0; i < num_shards; i++) {
+        shards.push_back(new MpmcBuffer(size / num_shards + (i < size % num_shards ? 1 : 0)));
+    }
+}
+
+/**
+ * @brief Destructor for the ShardedBuffer class
+ */
+ShardedBuffer::~ShardedBuffer() {
+    for (size_t i = 0; i < shards.size(); i++) {
+        delete shards[i];
+    }
+}
+
+/**
+ * @brief Finds the calling producer's home shard
+ * @return The index of the home shard
+ */
+size_t ShardedBuffer::producer_shard() {
+    return thread_number(producer_numbers, id, next_producer) % shards.size();
+}
+
+/**
+ * @brief Finds the shard the calling consumer removes from first
+ * @return The index of the home shard
+ */
+size_t ShardedBuffer::consumer_shard() {
+    return thread_number(consumer_numbers, id, next_consumer) % shards.size();
+}
+
+/**
+ * @brief Removes an item from the home shard, or else steals one from the other shards in turn
+ * @param home The index of the home shard
+ * @param item Pointer to a variable to store the removed item
+ * @return true if an item was removed, false if every shard was empty
+ */
+bool ShardedBuffer::try_remove_from(size_t home, buffer_item* item) {
+    for (size_t i = 0; i < shards.size(); i++) {
+        size_t shard = home + i < shards.size() ? home + i : home + i - shards.size();
+        if (shards[shard]->try_remove_item(item)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Removes a batch of items from the home shard, or else from the other shards in turn, without waiting
+ *
+ * Each shard is drained with batch claims, a run of its items at a time, until the batch is full or the shard is
+ * empty.
+ *
+ * @param home The index of the home shard
+ * @param batch Receives the removed items
+ * @param max_n The largest number of items to remove
+ * @return The number of items removed, 0 if every shard was empty
+ */
+int ShardedBuffer::try_remove_batch(size_t home, buffer_item* batch, int max_n) {
+    int count = 0;
+    for (size_t i = 0; i < shards.size() && count < max_n; i++) {
+        MpmcBuffer* shard = shards[home + i < shards.size() ? home + i : home + i - shards.size()];
+        int removed;
+        while (count < max_n && (removed = shard->try_remove_items(batch + count, max_n - count)) > 0) {
+            count += removed;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Retries an operation until it succeeds, waiting between the attempts as the strategy says
+ *
+ * The thread first spins, retrying with a pause in between, then yields the CPU between retries, and then parks.
+ * A parking thread counts itself in parked before its last retry, and a thread that changes a shard checks parked
+ * after the change, with a full fence on both sides, so either the retry sees the change or the other thread sees
+ * the parked thread and wakes it. The wake takes park_lock, which the parking thread holds until it waits, so the
+ * wake cannot come between the retry and the wait.
+ *
+ * @param attempt The operation, returning true when it succeeded
+ * @param cond The condition variable to park on
+ * @param parked The count of threads parked on cond
+ * @param deadline The time to give up at, or nullptr to wait as long as needed
+ * @return true if the operation succeeded, false if the deadline passed
+ */
+template <class Attempt>
+bool ShardedBuffer::wait_until_done(Attempt attempt, condition_variable& cond, atomic<int>& parked,
+                                    const Deadline* deadline) {
+    if (attempt()) {
+        return true;
+    }
+    for (int i = 0; i < strategy.spins; i++) {
+        cpu_relax();
+        if (attempt()) {
+            return true;
+        }
+    }
+    for (int i = 0; i < strategy.yields; i++) {
+        if (deadline != nullptr && chrono::steady_clock::now() >= *deadline) {
+            break;
+        }
+        this_thread::yield();
+        if (attempt()) {
+            return true;
+        }
+    }
+    unique_lock<mutex> lock(park_lock);
+    while (true) {
+        parked.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);  // Count the thread as parked before the last retry
+        if (attempt()) {
+            parked.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+        bool timed_out = false;
+        if (deadline == nullptr) {
+            cond.wait(lock);
+        } else {
+            timed_out = cond.wait_until(lock, *deadline) == cv_status::timeout;
+        }
+        parked.fetch_sub(1, memory_order_relaxed);
+        if (timed_out) {
+            return attempt();
+        }
+    }
+}
+
+/**
+ * @brief Wakes the threads parked on a condition variable, if there are any
+ * @param cond The condition variable
+ * @param parked The count of threads parked on cond
+ * @param all true to wake every parked thread, false to wake one
+ */
+void ShardedBuffer::wake(condition_variable& cond, atomic<int>& parked, bool all) {
+    atomic_thread_fence(memory_order_seq_cst);  // Change the shard before checking for parked threads
+    if (parked.load(memory_order_relaxed) > 0) {
+        lock_guard<mutex> lock(park_lock);
+        if (all) {
+            cond.notify_all();
+        } else {
+            cond.notify_one();
+        }
+    }
+}
+
+/**
+ * @brief Inserts an item into the home shard, waiting while it is full
+ * @param item The item to insert into the buffer
+ * @return true when the item is inserted
+ */
+bool ShardedBuffer::insert_item(buffer_item item) {
+    MpmcBuffer* shard = shards[producer_shard()];
+    wait_until_done([&] { return shard->try_insert_item(item); }, space_cond, space_parked, nullptr);
+    wake(items_cond, items_parked, false);
+    return true;
+}
+
+/**
+ * @brief Removes an item from the home shard or another one, waiting while every shard is empty
+ * @param item Pointer to a variable to store the removed item
+ * @return true when an item is removed
+ */
+bool ShardedBuffer::remove_item(buffer_item* item) {
+    size_t home = consumer_shard();
+    wait_until_done([&] { return try_remove_from(home, item); }, items_cond, items_parked, nullptr);
+    wake(space_cond, space_parked, true);
+    return true;
+}
+
+/**
+ * @brief Inserts an item into the home shard without waiting
+ * @param item The item to insert into the buffer
+ * @return true if the item was inserted, false if the home shard is full
+ */
+bool ShardedBuffer::try_insert_item(buffer_item item) {
+    if (!shards[producer_shard()]->try_insert_item(item)) {
+        return false;
+    }
+    wake(items_cond, items_parked, false);
+    return true;
+}
+
+/**
+ * @brief Removes an item from the home shard or another one without waiting
+ * @param item Pointer to a variable to store the removed item
+ * @return true if an item was removed, false if every shard is empty
+ */
+bool ShardedBuffer::try_remove_item(buffer_item* item) {
+    if (!try_remove_from(consumer_shard(), item)) {
+        return false;
+    }
+    wake(space_cond, space_parked, true);
+    return true;
+}
+
+/**
+ * @brief Inserts an item into the home shard, waiting at most a given time while it is full
+ * @param item The item to insert into the buffer
+ * @param timeout_us The longest time to wait, in microseconds
+ * @return true if the item was inserted, false if the home shard stayed full
+ */
+bool ShardedBuffer::timed_insert_item(buffer_item item, long timeout_us) {
+    MpmcBuffer* shard = shards[producer_shard()];
+    Deadline deadline = chrono::steady_clock::now() + chrono::microseconds(timeout_us);
+    if (!wait_until_done([&] { return shard->try_insert_item(item); }, space_cond, space_parked, &deadline)) {
+        return false;
+    }
+    wake(items_cond, items_parked, false);
+    return true;
+}
+
+/**
+ * @brief Removes an item from any shard, waiting at most a given time while every shard is empty
+ * @param item Pointer to a variable to store the removed item
+ * @param timeout_us The longest time to wait, in microseconds
+ * @return true if an item was removed, false if every shard stayed empty
+ */
+bool ShardedBuffer::timed_remove_item(buffer_item* item, long timeout_us) {
+    size_t home = consumer_shard();
+    Deadline deadline = chrono::steady_clock::now() + chrono::microseconds(timeout_us);
+    if (!wait_until_done([&] { return try_remove_from(home, item); }, items_cond, items_parked, &deadline)) {
+        return false;
+    }
+    wake(space_cond, space_parked, true);
+    return true;
+}
+
+/**
+ * @brief Inserts a batch of items into the home shard, waiting while it is full
+ * @param batch The items to insert, oldest first
+ * @param n The number of items
+ * @return The number of items inserted, from 1 to n (0 only when n is 0)
+ */
+int ShardedBuffer::insert_items(const buffer_item* batch, int n) {
+    if (n <= 0) {
+        return 0;
+    }
+    MpmcBuffer* shard = shards[producer_shard()];
+    int count = 0;
+    wait_until_done([&] { return (count = shard->try_insert_items(batch, n)) > 0; }, space_cond, space_parked,
+                    nullptr);
+    wake(items_cond, items_parked, count > 1);
+    return count;
+}
+
+/**
+ * @brief Removes a batch of items, waiting while every shard is empty
+ *
+ * The batch is filled from the home shard first and then from the other shards in turn, a run of items at a time.
+ *
+ * @param batch Receives the removed items
+ * @param max_n The largest number of items to remove
+ * @return The number of items removed, from 1 to max_n (0 only when max_n is 0)
+ */
+int ShardedBuffer::remove_items(buffer_item* batch, int max_n) {
+    if (max_n <= 0) {
+        return 0;
+    }
+    size_t home = consumer_shard();
+    int count = 0;
+    wait_until_done([&] { return (count = try_remove_batch(home, batch, max_n)) > 0; }, items_cond, items_parked,
+                    nullptr);
+    wake(space_cond, space_parked, true);
+    return count;
+}
+
+/**
+ * @brief Gets the size of the buffer
+ * @return The sum of the sizes of the shards
+ */
+int ShardedBuffer::get_size() {
+    int size = 0;
+    for (size_t i = 0; i < shards.size(); i++) {
+        size += shards[i]->get_size();
+    }
+    return size;
+}
+
+/**
+ * @brief Gets the current item count in the buffer
+ *
+ * The shards are read one after another, so while threads are running the count is only an estimate.
+ *
+ * @return The number of items in all the shards
+ */
+int ShardedBuffer::get_count() {
+    int count = 0;
+    for (size_t i = 0; i < shards.size(); i++) {
+        count += shards[i]->get_count();
+    }
+    return count;
+}
+
+/**
+ * @brief Checks if the buffer is empty
+ * @return true if every shard is empty, false otherwise
+ */
+bool ShardedBuffer::is_empty() {
+    return get_count() == 0;
+}
+
+/**
+ * @brief Checks if the buffer is full for the calling producer
+ *
+ * A producer only inserts into its home shard, so that shard being full is what makes it wait. A thread that has
+ * not inserted yet is not numbered here; it checks the shard the next number would give it.
+ *
+ * @return true if the home shard is full, false otherwise
+ */
+bool ShardedBuffer::is_full() {
+    for (size_t i = 0; i < producer_numbers.size(); i++) {
+        if (producer_numbers[i].first == id) {
+            return shards[producer_numbers[i].second % shards.size()]->is_full();
+        }
+    }
+    return shards[next_producer.load(memory_order_relaxed) % shards.size()]->is_full();
+}
+
+/**
+ * @brief Copies the contents of the buffer, shard after shard
+ * @param batch Receives up to max_n of the items
+ * @param max_n The largest number of items to copy
+ * @return The number of items in the buffer
+ */
+int ShardedBuffer::snapshot(buffer_item* batch, int max_n) {
+    int total = 0;
+    for (size_t i = 0; i < shards.size(); i++) {
+        int room = max_n > total ? max_n - total : 0;
+        total += shards[i]->snapshot(batch + (total < max_n ? total : max_n), room);
+    }
+    return total;
+}
@@ -0,0 +1,215 @@
+/**
+ * Assignment 4: Producer Consumer Problem
+ * @file sharded_buffer.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief header file for the sharded buffer, one lock-free queue per producer with work stealing by the consumers
+ * @version 0.1
+ */
+#ifndef SHARDED_BUFFER_H
+#define SHARDED_BUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "basic_buffer.h"     // For WaitStrategy and cpu_relax
+#include "bounded_buffer.h"
+#include "mpmc_buffer.h"
+
+/**
+ * @brief A bounded buffer split into shards, each an MpmcBuffer, so that producers do not contend on one queue.
+ *
+ * Each buffer numbers its producers in the order they first insert, and numbers its consumers apart from them, so
+ * a thread's home shard is its number modulo the number of shards. A producer only inserts into its home shard, so
+ * its items keep their order. A consumer drains its home shard first and steals from the other shards, going round
+ * from the next one, when its home shard is empty. With one shard per producer, each producer has a queue of its
+ * own. There is no order between the items of different shards.
+ *
+ * A thread that finds its home shard full, or every shard empty, follows the buffer's WaitStrategy like the mutex
+ * buffer: it spins, yields, and then parks on a condition variable. Only parked threads are notified. A freed slot
+ * wakes every parked producer, since only the one whose home shard it is in can use it.
+ */
+class ShardedBuffer : public BoundedBuffer {
+private:
+    std::vector<MpmcBuffer*> shards;    // The shards, each with its positions on cache lines of their own
+    const size_t id;                    // Unique number of the buffer, to find a thread's numbers for it
+    std::atomic<size_t> next_producer;  // Number of the next thread to insert into this buffer
+    std::atomic<size_t> next_consumer;  // Number of the next thread to remove from this buffer
+    WaitStrategy strategy;              // How threads wait on a full home shard or an empty buffer
+    std::mutex park_lock;               // Held by a parking thread from its last check until it waits
+    std::condition_variable space_cond; // Producers park here while their home shard is full
+    std::condition_variable items_cond; // Consumers park here while every shard is empty
+    std::atomic<int> space_parked;      // Producers parked on space_cond
+    std::atomic<int> items_parked;      // Consumers parked on items_cond
+
+    typedef std::chrono::steady_clock::time_point Deadline;
+
+    /**
+     * @brief Find the calling producer's home shard, numbering the producer on its first insert into this buffer
+     * @return the index of the home shard
+     */
+    size_t producer_shard();
+
+    /**
+     * @brief Find the calling consumer's home shard, numbering the consumer on its first removal from this buffer
+     * @return the index of the shard to remove from first
+     */
+    size_t consumer_shard();
+
+    /**
+     * @brief Remove an item from the home shard, or else from the first other shard that has one
+     * @param home the index of the home shard
+     * @param item receives the removed item
+     * @return true if an item was removed, false if every shard was empty
+     */
+    bool try_remove_from(size_t home, buffer_item* item);
+
+    /**
+     * @brief Remove a batch of items without waiting, draining the home shard and then the others with batch claims
+     * @param home the index of the home shard
+     * @param items receives the removed items
+     * @param max_n the largest number of items to remove
+     * @return the number of items removed, 0 if every shard was empty
+     */
+    int try_remove_batch(size_t home, buffer_item* items, int max_n);
+
+    /**
+     * @brief Retry an operation until it succeeds, spinning, yielding and then parking as the strategy says
+     * @param attempt the operation, returning true when it succeeded
+     * @param cond the condition variable to park on
+     * @param parked the count of threads parked on cond
+     * @param deadline the time to give up at, or nullptr to wait as long as needed
+     * @return true if the operation succeeded, false if the deadline passed
+     */
+    template <class Attempt>
+    bool wait_until_done(Attempt attempt, std::condition_variable& cond, std::atomic<int>& parked,
+                         const Deadline* deadline);
+
+    /**
+     * @brief Wake the threads parked on a condition variable, if there are any
+     * @param cond the condition variable
+     * @param parked the count of threads parked on cond
+     * @param all true to wake every parked thread, false to wake one
+     */
+    void wake(std::condition_variable& cond, std::atomic<int>& parked, bool all);
+
+public:
+    /**
+     * @brief Construct a new ShardedBuffer object
+     * @param size the total size of the buffer, split exactly between the shards, at least one slot each
+     * @param num_shards the number of shards, typically the number of producers
+     * @param strategy how threads wait on a full home shard or an empty buffer
+     */
+    ShardedBuffer(int size = 5, int num_shards = 1, const WaitStrategy& strategy = WaitStrategy());
+
+    /**
+     * @brief Destroy the ShardedBuffer object
+     */
+    ~ShardedBuffer() override;
+
+    ShardedBuffer(const ShardedBuffer&) = delete;
+    ShardedBuffer& operator=(const ShardedBuffer&) = delete;
+
+    /**
+     * @brief Insert an item into the home shard, waiting while it is full
+     * @param item the item to insert
+     * @return true when the item is inserted
+     */
+    bool insert_item(buffer_item item) override;
+
+    /**
+     * @brief Remove an item from the home shard or another one, waiting while every shard is empty
+     * @param item the item to remove
+     * @return true when an item is removed
+     */
+    bool remove_item(buffer_item* item) override;
+
+    /**
+     * @brief Insert an item into the home shard without waiting
+     * @param item the item to insert
+     * @return true if the item was inserted, false if the home shard is full
+     */
+    bool try_insert_item(buffer_item item) override;
+
+    /**
+     * @brief Remove an item from the home shard or another one without waiting
+     * @param item receives the removed item
+     * @return true if an item was removed, false if every shard is empty
+     */
+    bool try_remove_item(buffer_item* item) override;
+
+    /**
+     * @brief Insert an item into the home shard, waiting at most a given time while it is full
+     * @param item the item to insert
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if the item was inserted, false if the home shard stayed full
+     */
+    bool timed_insert_item(buffer_item item, long timeout_us) override;
+
+    /**
+     * @brief Remove an item from any shard, waiting at most a given time while every shard is empty
+     * @param item receives the removed item
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if an item was removed, false if every shard stayed empty
+     */
+    bool timed_remove_item(buffer_item* item, long timeout_us) override;
+
+    /**
+     * @brief Insert a batch of items into the home shard, waiting until there is at least one free slot
+     * @param items the items to insert, oldest first
+     * @param n the number of items
+     * @return the number of items inserted, from 1 to n (0 only when n is 0)
+     */
+    int insert_items(const buffer_item* items, int n) override;
+
+    /**
+     * @brief Remove a batch of items, from the home shard first and then from the others, waiting for at least one
+     * @param items receives the removed items
+     * @param max_n the largest number of items to remove
+     * @return the number of items removed, from 1 to max_n (0 only when max_n is 0)
+     */
+    int remove_items(buffer_item* items, int max_n) override;
+
+    /**
+     * @brief Get the size of the buffer, the sum of the sizes of the shards
+     * @return the size of the buffer
+     */
+    int get_size() override;
+
+    /**
+     * @brief Get the number of items in all the shards, a snapshot while the threads are running
+     * @return the number of items in the buffer
+     */
+    int get_count() override;
+
+    /**
+     * @brief Check if every shard is empty
+     * @return true if the buffer is empty, else false
+     */
+    bool is_empty() override;
+
+    /**
+     * @brief Check if the calling producer's home shard is full, so that its next insert would wait. A thread that
+     *        has not inserted yet checks the shard its first insert would use.
+     * @return true if the home shard is full, else false
+     */
+    bool is_full() override;
+
+    /**
+     * @brief Copy the items of the shards, shard after shard. The copy is only consistent when no thread is
+     *        modifying the buffer.
+     * @param items receives up to max_n of the items
+     * @param max_n the largest number of items to copy
+     * @return the number of items in the buffer
+     */
+    int snapshot(buffer_item* items, int max_n) override;
+
+    /**
+     * @brief Get the number of shards
+     * @return the number of shards
+     */
+    int get_shards() const { return shards.size(); }
+};
+
+#endif // SHARDED_BUFFER_H
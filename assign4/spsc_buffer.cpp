@@ -0,0 +1,279 @@
+/**
+* Assignment 4: Producer Consumer Problem
+ * @file spsc_buffer.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Implementation file for the lock-free single-producer single-consumer ring buffer
+ * @version 0.1
+ */
+#include "spsc_buffer.h"
+#include <algorithm> // For std::copy and std::min
+#include <chrono>    // For the deadline of the timed operations
+#include <cstdlib>   // For posix_memalign and free
+#include <new>       // For std::bad_alloc
+#include <thread>  // For std::this_thread::yield while waiting
+
+using namespace std;
+
+/**
+ * @brief Round a size up to a power of two
+ * @param size the size, at least 1
+ * @return the smallest power of two that is not less than the size
+ */
+static size_t round_up_pow2(size_t size) {
+    size_t capacity = 1;
+    while (capacity < size) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+/**
+ * @brief Constructor for the SpscBuffer class
+ *
+ * The slot array is rounded up to a power of two so that a slot is found with a mask instead of a division,
+ * but the buffer still holds at most size items.
+ *
+ * @param size The size of the buffer (default is 5)
+ */
+SpscBuffer::SpscBuffer(int size) : head(0), cached_tail(0), tail(0), cached_head(0) {
+    max_size = size > 0 ? size : 1;
+    size_t capacity = round_up_pow2(max_size);
+    mask = capacity - 1;
+    items = new buffer_item[capacity];
+}
+
+/**
+ * @brief Destructor for the SpscBuffer class
+ */
+SpscBuffer::~SpscBuffer() {
+    delete[] items;
+}
+
+/**
+ * @brief Allocate a buffer on a cache line boundary, so the padded counters really are on separate lines
+ * @param size The size of the object
+ * @return The memory
+ */
+void* SpscBuffer::operator new(size_t size) {
+    void* ptr;
+    if (posix_memalign(&ptr, 64, size) != 0) {
+        throw bad_alloc();
+    }
+    return ptr;
+}
+
+/**
+ * @brief Free a buffer allocated with operator new
+ * @param ptr The memory
+ */
+void SpscBuffer::operator delete(void* ptr) {
+    free(ptr);
+}
+
+/**
+ * @brief Try to insert an item without waiting
+ *
+ * The item is stored before the tail is published with a release store, so the consumer that sees the new tail
+ * also sees the item.
+ *
+ * @param item The item to insert into the buffer
+ * @return true if the item was inserted, false if the buffer is full
+ */
+bool SpscBuffer::try_insert_item(buffer_item item) {
+    size_t t = tail.load(memory_order_relaxed);
+    if (t - cached_head == max_size) {
+        cached_head = head.load(memory_order_acquire);  // Refresh the view of the consumer only when needed
+        if (t - cached_head == max_size) {
+            return false;
+        }
+    }
+    items[t & mask] = item;
+    tail.store(t + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Try to remove an item without waiting
+ *
+ * The item is read before the head is published with a release store, so the producer cannot overwrite the slot
+ * while it is being read.
+ *
+ * @param item Pointer to a variable to store the removed item
+ * @return true if an item was removed, false if the buffer is empty
+ */
+bool SpscBuffer::try_remove_item(buffer_item* item) {
+    size_t h = head.load(memory_order_relaxed);
+    if (h == cached_tail) {
+        cached_tail = tail.load(memory_order_acquire);  // Refresh the view of the producer only when needed
+        if (h == cached_tail) {
+            return false;
+        }
+    }
+    *item = items[h & mask];
+    head.store(h + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Inserts an item into the buffer, yielding the CPU while the buffer is full
+ * @param item The item to insert into the buffer
+ * @return true when the item is inserted
+ */
+bool SpscBuffer::insert_item(buffer_item item) {
+    while (!try_insert_item(item)) {
+        this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Removes an item from the buffer, yielding the CPU while the buffer is empty
+ * @param item Pointer to a variable to store the removed item
+ * @return true when an item is removed
+ */
+bool SpscBuffer::remove_item(buffer_item* item) {
+    while (!try_remove_item(item)) {
+        this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Inserts an item into the buffer, spinning at most a given time while it is full
+ * @param item The item to insert into the buffer
+ * @param timeout_us The longest time to wait, in microseconds
+ * @return true if the item was inserted, false if the buffer stayed full
+ */
+bool SpscBuffer::timed_insert_item(buffer_item item, long timeout_us) {
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::microseconds(timeout_us);
+    while (!try_insert_item(item)) {
+        if (chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Removes an item from the buffer, spinning at most a given time while it is empty
+ * @param item Pointer to a variable to store the removed item
+ * @param timeout_us The longest time to wait, in microseconds
+ * @return true if an item was removed, false if the buffer stayed empty
+ */
+bool SpscBuffer::timed_remove_item(buffer_item* item, long timeout_us) {
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::microseconds(timeout_us);
+    while (!try_remove_item(item)) {
+        if (chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Inserts a batch of items with a single publication, yielding the CPU while the buffer is full
+ *
+ * The items are copied in at most two contiguous runs, one up to the end of the array and one from its start,
+ * and the tail is advanced once for the whole batch.
+ *
+ * @param batch The items to insert, oldest first
+ * @param n The number of items
+ * @return The number of items inserted, from 1 to n (0 only when n is 0)
+ */
+int SpscBuffer::insert_items(const buffer_item* batch, int n) {
+    if (n <= 0) {
+        return 0;
+    }
+    size_t t = tail.load(memory_order_relaxed);
+    while (t - cached_head == max_size) {
+        cached_head = head.load(memory_order_acquire);
+        if (t - cached_head == max_size) {
+            this_thread::yield();
+        }
+    }
+    size_t count = std::min((size_t)n, max_size - (t - cached_head));
+    size_t start = t & mask;
+    size_t first = std::min(count, mask + 1 - start);  // Items that fit before the end of the array
+    std::copy(batch, batch + first, items + start);
+    std::copy(batch + first, batch + count, items);  // The rest wraps around to the start
+    tail.store(t + count, memory_order_release);
+    return count;
+}
+
+/**
+ * @brief Removes a batch of items with a single publication, yielding the CPU while the buffer is empty
+ * @param batch Receives the removed items, oldest first
+ * @param max_n The largest number of items to remove
+ * @return The number of items removed, from 1 to max_n (0 only when max_n is 0)
+ */
+int SpscBuffer::remove_items(buffer_item* batch, int max_n) {
+    if (max_n <= 0) {
+        return 0;
+    }
+    size_t h = head.load(memory_order_relaxed);
+    while (h == cached_tail) {
+        cached_tail = tail.load(memory_order_acquire);
+        if (h == cached_tail) {
+            this_thread::yield();
+        }
+    }
+    size_t count = std::min((size_t)max_n, cached_tail - h);
+    size_t start = h & mask;
+    size_t first = std::min(count, mask + 1 - start);  // Items before the end of the array
+    std::copy(items + start, items + start + first, batch);
+    std::copy(items, items + (count - first), batch + first);  // The rest wrapped around to the start
+    head.store(h + count, memory_order_release);
+    return count;
+}
+
+/**
+ * @brief Gets the size of the buffer
+ * @return The maximum size of the buffer
+ */
+int SpscBuffer::get_size() {
+    return max_size;
+}
+
+/**
+ * @brief Gets the current item count in the buffer
+ * @return The current number of items in the buffer
+ */
+int SpscBuffer::get_count() {
+    size_t h = head.load(memory_order_acquire);
+    size_t t = tail.load(memory_order_acquire);
+    return t - h;
+}
+
+/**
+ * @brief Checks if the buffer is empty
+ * @return true if the buffer is empty, false otherwise
+ */
+bool SpscBuffer::is_empty() {
+    return get_count() == 0;
+}
+
+/**
+ * @brief Checks if the buffer is full
+ * @return true if the buffer is full, false otherwise
+ */
+bool SpscBuffer::is_full() {
+    return get_count() == (int)max_size;
+}
+
+/**
+ * @brief Copies the contents of the buffer, from the oldest item to the newest
+ * @param batch Receives up to max_n of the items
+ * @param max_n The largest number of items to copy
+ * @return The number of items in the buffer
+ */
+int SpscBuffer::snapshot(buffer_item* batch, int max_n) {
+    size_t h = head.load(memory_order_acquire);
+    size_t t = tail.load(memory_order_acquire);
+    size_t count = t - h;
+    for (size_t i = 0; i < count && i < (size_t)max_n; i++) {
+        batch[i] = items[(h + i) & mask];
+    }
+    return count;
+}
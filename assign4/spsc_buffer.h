@@ -0,0 +1,155 @@
+/**
+* Assignment 4: Producer Consumer Problem
+ * @file spsc_buffer.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief header file for the lock-free single-producer single-consumer ring buffer
+ * @version 0.1
+ */
+#ifndef SPSC_BUFFER_H
+#define SPSC_BUFFER_H
+
+#include <atomic>  // For std::atomic head and tail counters
+#include <cstddef> // For size_t
+#include "bounded_buffer.h"
+
+/**
+ * @brief A lock-free bounded buffer for exactly one producer thread and one consumer thread.
+ *
+ * The producer only writes the tail counter and the consumer only writes the head counter, so neither side ever
+ * takes a lock or does a read-modify-write. The counters increase forever and the slot of a counter is found with a
+ * mask over a power-of-two array. The counters are on separate cache lines, and each side keeps a cached copy of the
+ * other side's counter so that it only reads the shared line when the buffer looks full or empty.
+ */
+class SpscBuffer : public BoundedBuffer {
+private:
+    buffer_item* items;     // Array of slots, with a power-of-two size
+    size_t mask;            // Number of slots minus one, to find the slot of a counter
+    size_t max_size;        // Maximum number of items in the buffer
+
+    alignas(64) std::atomic<size_t> head;  // Counter of removed items, written by the consumer
+    size_t cached_tail;                    // The consumer's last view of the tail
+    alignas(64) std::atomic<size_t> tail;  // Counter of inserted items, written by the producer
+    size_t cached_head;                    // The producer's last view of the head
+
+public:
+   /**
+     * @brief Construct a new SpscBuffer object
+     * @param size the size of the buffer
+     */
+    SpscBuffer(int size = 5);
+
+    /**
+     * @brief Destroy the SpscBuffer object
+     */
+    ~SpscBuffer() override;
+
+    SpscBuffer(const SpscBuffer&) = delete;
+    SpscBuffer& operator=(const SpscBuffer&) = delete;
+
+    /**
+     * @brief Allocate a buffer on a cache line boundary, which plain new does not guarantee before C++17
+     * @param size the size of the object
+     * @return the memory
+     */
+    static void* operator new(size_t size);
+
+    /**
+     * @brief Free a buffer allocated with operator new
+     * @param ptr the memory
+     */
+    static void operator delete(void* ptr);
+
+    /**
+     * @brief Try to insert an item without waiting. Only the producer thread may call it.
+     * @param item the item to insert
+     * @return true if the item was inserted, false if the buffer is full
+     */
+    bool try_insert_item(buffer_item item) override;
+
+    /**
+     * @brief Try to remove an item without waiting. Only the consumer thread may call it.
+     * @param item receives the removed item
+     * @return true if an item was removed, false if the buffer is empty
+     */
+    bool try_remove_item(buffer_item* item) override;
+
+    /**
+     * @brief Insert an item into the buffer, spinning while it is full
+     * @param item the item to insert
+     * @return true when the item is inserted
+     */
+    bool insert_item(buffer_item item) override;
+
+    /**
+     * @brief Remove an item from the buffer, spinning while it is empty
+     * @param item the item to remove
+     * @return true when an item is removed
+     */
+    bool remove_item(buffer_item* item) override;
+
+    /**
+     * @brief Insert an item, spinning at most a given time while the buffer is full Only the producer thread may call it.
+     * @param item the item to insert
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if the item was inserted, false if the buffer stayed full
+     */
+    bool timed_insert_item(buffer_item item, long timeout_us) override;
+
+    /**
+     * @brief Remove an item, spinning at most a given time while the buffer is empty Only the consumer thread may call it.
+     * @param item receives the removed item
+     * @param timeout_us the longest time to wait, in microseconds
+     * @return true if an item was removed, false if the buffer stayed empty
+     */
+    bool timed_remove_item(buffer_item* item, long timeout_us) override;
+
+    /**
+     * @brief Insert a batch of items with a single publication, waiting until there is at least one free slot
+     * @param items the items to insert, oldest first
+     * @param n the number of items
+     * @return the number of items inserted, from 1 to n (0 only when n is 0)
+     */
+    int insert_items(const buffer_item* items, int n) override;
+
+    /**
+     * @brief Remove a batch of items with a single publication, waiting until there is at least one item
+     * @param items receives the removed items, oldest first
+     * @param max_n the largest number of items to remove
+     * @return the number of items removed, from 1 to max_n (0 only when max_n is 0)
+     */
+    int remove_items(buffer_item* items, int max_n) override;
+
+    /**
+     * @brief Get the size of the buffer
+     * @return the size of the buffer
+     */
+    int get_size() override;
+
+    /**
+     * @brief Get the number of items in the buffer, a snapshot while the threads are running
+     * @return the number of items in the buffer
+     */
+    int get_count() override;
+
+    /**
+     * @brief Chceck if the buffer is empty
+     * @return true if the buffer is empty, else false
+     */
+    bool is_empty() override;
+
+    /**
+     * @brief Check if the buffer is full
+     * @return true if the buffer is full, else false
+     */
+    bool is_full() override;
+
+    /**
+     * @brief Copy the items of the buffer. The copy is only consistent when no thread is modifying the buffer.
+     * @param items receives up to max_n of the items
+     * @param max_n the largest number of items to copy
+     * @return the number of items in the buffer
+     */
+    int snapshot(buffer_item* items, int max_n) override;
+};
+
+#endif // SPSC_BUFFER_H
@@ -0,0 +1,107 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file car_replacement.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief A class implementing CAR (Clock with Adaptive Replacement), the clock-based form of ARC
+ * @version 0.1
+ */
+
+#include <algorithm>
+#include "car_replacement.h"
+
+// Constructor: the links of the clocks and of the history lists are allocated once
+CARReplacement::CARReplacement(int num_pages, int num_frames, PageTableKind kind)
+: Replacement(num_pages, num_frames, kind), frame_links(num_frames), frame_page(num_frames),
+  history_links(num_pages), history_of(num_pages, 0)
+{
+}
+
+// Destructor
+CARReplacement::~CARReplacement()
+{
+}
+
+// Free a frame by sweeping the clocks
+int CARReplacement::evict()
+{
+    while (true) {
+        if (t1.size >= std::max(1, p)) {
+            // T1 is at or above its target: its hand evicts an unreferenced page, or moves a referenced one to T2
+            int frame = frame_links.pop_front(t1);
+            PageEntry& entry = page_table[frame_page[frame]];
+            if (!entry.referenced) {
+                history_links.push_back(b1, frame_page[frame]);
+                history_of[frame_page[frame]] = 1;
+                return frame;
+            }
+            entry.referenced = false;
+            frame_links.push_back(t2, frame);
+        } else {
+            // T2's hand evicts an unreferenced page, or gives a referenced one another turn
+            int frame = frame_links.pop_front(t2);
+            PageEntry& entry = page_table[frame_page[frame]];
+            if (!entry.referenced) {
+                history_links.push_back(b2, frame_page[frame]);
+                history_of[frame_page[frame]] = 2;
+                return frame;
+            }
+            entry.referenced = false;
+            frame_links.push_back(t2, frame);
+        }
+    }
+}
+
+// Accesss a page alreay in physical memory
+void CARReplacement::touch_page(int page_num)
+{
+    page_table[page_num].referenced = true;
+}
+
+// Access an invalid page, but free frames are available
+void CARReplacement::load_page(int page_num)
+{
+    // Nothing has been evicted yet, so the page cannot be in the history
+    int frame = page_table[page_num].frame_num;
+    frame_page[frame] = page_num;
+    frame_links.push_back(t1, frame);
+    page_table[page_num].referenced = false;
+}
+
+// Access an invalid page and no free frames are available
+int CARReplacement::replace_page(int page_num)
+{
+    int frame = evict();
+    int victim = frame_page[frame];
+    char history = history_of[page_num];
+    // Keeps T1 and B1 within num_frames pages, and all four lists within twice that
+    if (history == 0) {
+        if (t1.size + b1.size == num_frames) {
+            history_of[history_links.pop_front(b1)] = 0;
+        } else if (t1.size + t2.size + b1.size + b2.size == 2 * num_frames) {
+            history_of[history_links.pop_front(b2)] = 0;
+        }
+    }
+    frame_page[frame] = page_num;
+    page_table[page_num].referenced = false;
+    if (history == 0) {
+        // A page not seen recently starts in T1
+        frame_links.push_back(t1, frame);
+        return victim;
+    }
+    if (history == 1) {
+        // T1 evicted it too early, so T1 should be larger
+        p = std::min(p + std::max(1, b2.size / b1.size), num_frames);
+        history_links.remove(b1, page_num);
+    } else {
+        // T2 evicted it too early, so T1 should be smaller
+        p = std::max(p - std::max(1, b1.size / b2.size), 0);
+        history_links.remove(b2, page_num);
+    }
+    history_of[page_num] = 0;
+    // A page seen again after its eviction is used often and goes to T2
+    frame_links.push_back(t2, frame);
+    return victim;
+}
+
+// The devirtualized replay, instantiated here so that it inlines the hooks above
+template class Simulator<CARReplacement>;
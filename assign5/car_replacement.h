@@ -0,0 +1,89 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file car_replacement.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A class implementing CAR (Clock with Adaptive Replacement), the clock-based form of ARC
+ * @version 0.1
+ */
+
+#pragma once
+
+#include <vector>
+#include "index_list.h"
+#include "replacement.h"
+#include "simulator.h"
+
+/**
+ * @brief A class to simulate CAR, Clock with Adaptive Replacement (Bansal and Modha, FAST 2004).
+ * @details The frames are split between two clocks: T1 holds pages seen once recently and T2 pages seen at least
+ * twice. Two history lists, B1 and B2, remember the pages recently evicted from each clock, without frames. A miss
+ * on a page in B1 means T1 was too small and grows its target size p; a miss in B2 shrinks it. A hit only sets the
+ * page's reference bit, as in the clock algorithm, so hits cost no list operations.
+ */
+class CARReplacement : public Replacement
+{
+private:
+    // Links of the clocks T1 and T2 over frame numbers; the head of each list is where its hand points
+    IndexLists frame_links;
+    IndexListHead t1;
+    IndexListHead t2;
+    // Page held by each frame
+    std::vector<int> frame_page;
+    // Links of the history lists B1 and B2 over page numbers; the head of each list is its least recent page
+    IndexLists history_links;
+    IndexListHead b1;
+    IndexListHead b2;
+    // History list holding each page: 0 for none, 1 for B1, 2 for B2
+    std::vector<char> history_of;
+    // Target size of T1, adapted on every miss in the history
+    int p = 0;
+
+    /**
+     * @brief Free a frame by sweeping the clocks, moving the evicted page into B1 or B2
+     * @return The freed frame
+     */
+    int evict();
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_pages Total number of logical pages for the simulation.
+     * @param num_frames Total number of available free frames.
+     * @param kind How the page table stores its entries.
+     */
+    CARReplacement(int num_pages, int num_frames, PageTableKind kind = PAGE_TABLE_FLAT);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~CARReplacement();
+
+    /**
+     * @brief Get the name of the algorithm, for reports
+     */
+    virtual const char* get_name() const { return "CAR"; }
+
+    /**
+     * @brief Accesss a page alreay in physical memory, setting its reference bit
+     * @param page_num The logical page number.
+     */
+    virtual void touch_page(int page_num);
+
+    /**
+     * @brief Access an invalid page, but free frames are available.
+     * The page's frame joins T1.
+     * @param page_num The logical page number.
+     */
+    virtual void load_page(int page_num);
+
+    /**
+     * @brief Access an invalid page, and there is no free frame.
+     * Evict a page from T1 or T2, trim the history lists, then place the page in T1, or in T2 if it was in the history.
+     * @param page_num The logical page number.
+     * @return Selected victim page #
+     */
+    virtual int replace_page(int page_num);
+};
+
+// Compiled in car_replacement.cpp, where the hooks can be inlined
+extern template class Simulator<CARReplacement>;
@@ -0,0 +1,73 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file clock_replacement.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief A class implementing the clock (enhanced second-chance) page replacement algorithm
+ * @version 0.1
+ */
+
+#include "clock_replacement.h"
+
+// Constructor: one slot of the circle per frame, allocated once
+ClockReplacement::ClockReplacement(int num_pages, int num_frames, PageTableKind kind)
+: Replacement(num_pages, num_frames, kind), frame_page(num_frames)
+{
+}
+
+// Destructor
+ClockReplacement::~ClockReplacement()
+{
+}
+
+// Sweep the frames once from the hand
+bool ClockReplacement::sweep(bool need_clean, bool clear)
+{
+    for (int i = 0; i < num_frames; i++) {
+        PageEntry& entry = page_table[frame_page[hand]];
+        if (!entry.referenced && !(need_clean && entry.dirty)) {
+            return true;
+        }
+        if (clear) {
+            entry.referenced = false;
+        }
+        advance();
+    }
+    return false;
+}
+
+// Accesss a page alreay in physical memory
+void ClockReplacement::touch_page(int page_num)
+{
+    page_table[page_num].referenced = true;
+}
+
+// Access an invalid page, but free frames are available
+void ClockReplacement::load_page(int page_num)
+{
+    PageEntry& entry = page_table[page_num];
+    frame_page[entry.frame_num] = page_num;
+    entry.referenced = true;
+}
+
+// Access an invalid page and no free frames are available
+int ClockReplacement::replace_page(int page_num)
+{
+    if (dirty_frames == 0) {
+        // Every page is clean, so this is the plain second-chance algorithm; it stops within one revolution
+        sweep(false, true);
+    } else {
+        // First look for a page neither referenced nor dirty without changing anything, then for any page that is
+        // not referenced while clearing the bits passed. The second pass always succeeds by its second revolution.
+        while (!sweep(true, false) && !sweep(false, true)) {
+        }
+    }
+    // The new page takes the victim's frame and the hand moves past it
+    int victim = frame_page[hand];
+    frame_page[hand] = page_num;
+    page_table[page_num].referenced = true;
+    advance();
+    return victim;
+}
+
+// The devirtualized replay, instantiated here so that it inlines the hooks above
+template class Simulator<ClockReplacement>;
@@ -0,0 +1,86 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file clock_replacement.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A class implementing the clock (enhanced second-chance) page replacement algorithm
+ * @version 0.1
+ */
+
+#pragma once
+
+#include <vector>
+#include "replacement.h"
+#include "simulator.h"
+
+/**
+ * @brief A class to simulate the clock page replacement algorithm, an approximation of LRU.
+ * @details The frames form a circle swept by a hand. A hit only sets the page's reference bit. To find a victim the
+ * hand skips referenced pages, clearing their bits, so each page gets a second chance. When some pages are dirty it
+ * uses the enhanced algorithm and prefers pages that are neither referenced nor dirty, which need no write-back.
+ */
+class ClockReplacement : public Replacement
+{
+private:
+    // Page held by each frame
+    std::vector<int> frame_page;
+    // Frame the hand points at, the next candidate victim
+    int hand = 0;
+
+    /**
+     * @brief Move the hand to the next frame
+     */
+    void advance() {
+        hand = hand + 1 == num_frames ? 0 : hand + 1;
+    }
+
+    /**
+     * @brief Sweep the frames once from the hand, stopping at the first page that is not referenced
+     * @param need_clean Whether the page must also not be dirty.
+     * @param clear Whether to clear the reference bits the hand passes.
+     * @return true if the hand stopped at such a page, false after a full revolution without one
+     */
+    bool sweep(bool need_clean, bool clear);
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_pages Total number of logical pages for the simulation.
+     * @param num_frames Total number of available free frames.
+     * @param kind How the page table stores its entries.
+     */
+    ClockReplacement(int num_pages, int num_frames, PageTableKind kind = PAGE_TABLE_FLAT);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~ClockReplacement();
+
+    /**
+     * @brief Get the name of the algorithm, for reports
+     */
+    virtual const char* get_name() const { return "Clock"; }
+
+    /**
+     * @brief Accesss a page alreay in physical memory, setting its reference bit
+     * @param page_num The logical page number.
+     */
+    virtual void touch_page(int page_num);
+
+    /**
+     * @brief Access an invalid page, but free frames are available.
+     * The page's frame joins the circle behind the hand.
+     * @param page_num The logical page number.
+     */
+    virtual void load_page(int page_num);
+
+    /**
+     * @brief Access an invalid page, and there is no free frame.
+     * Replace the first page the hand finds without a second chance.
+     * @param page_num The logical page number.
+     * @return Selected victim page #
+     */
+    virtual int replace_page(int page_num);
+};
+
+// Compiled in clock_replacement.cpp, where the hooks can be inlined
+extern template class Simulator<ClockReplacement>;
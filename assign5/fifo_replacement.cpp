@@ -1,34 +1,37 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file fifo_replacement.cpp
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief A class implementing the FIFO page replacement algorithms
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
 
 #include "fifo_replacement.h"
 
-// TODO: Add your implementation here
-FIFOReplacement::FIFOReplacement(int num_pages, int num_frames)
-: Replacement(num_pages, num_frames)
+// Constructor: the ring holds one page per frame and is allocated once
+FIFOReplacement::FIFOReplacement(int num_pages, int num_frames, PageTableKind kind)
+: Replacement(num_pages, num_frames, kind), queue(num_frames)
 {
-    // TODO: Add additional implementation code
 }
 
-// TODO: Add your implementations for desctructor, load_page, replace_page here
+// Destructor
 FIFOReplacement::~FIFOReplacement() {
-    // TODO: Add necessary code here
 }
 
 // Access an invalid page, but free frames are available
 void FIFOReplacement::load_page(int page_num) {
-    // TODO: Update your data structure FIFO replacement and pagetable
+    // The newest page goes behind all the others
+    queue[count++] = page_num;
 }
 
 // Access an invalid page and no free frames are available
 int FIFOReplacement::replace_page(int page_num) {
-    // TODO: Update your data structure FIFO replacement and pagetable
-    return 0;
-}
\ No newline at end of file
+    // The oldest page leaves, and the new page takes its slot, which is now the newest end of the ring
+    int victim = queue[head];
+    queue[head] = page_num;
+    head = head + 1 == count ? 0 : head + 1;
+    return victim;
+}
+
+// The devirtualized replay, instantiated here so that it inlines the hooks above
+template class Simulator<FIFOReplacement>;
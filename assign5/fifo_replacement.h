@@ -1,39 +1,50 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file fifo_replacement.h
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief A class implementing the FIFO page replacement algorithms
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
 
 #pragma once
 
 // Remember to add comments to your code
 
+#include <vector>
 #include "replacement.h"
+#include "simulator.h"
 
 /**
  * @brief A class to simulate FIFO page replacement algorithm.
  */
 class FIFOReplacement : public Replacement {
 private:
-    // TODO: Add necessary member variables to this class
+    // Pages in the order they were loaded, as a ring over the frames: the oldest page is at queue[head]
+    std::vector<int> queue;
+    // Position of the oldest page in the ring
+    int head = 0;
+    // Number of pages in the ring
+    int count = 0;
 
 public:
     /**
      * @brief Constructor
      * @param num_pages Total number of available free frames.
      * @param num_frames Total number of free frames.
+     * @param kind How the page table stores its entries.
      */
-    FIFOReplacement(int num_pages, int num_frames);
+    FIFOReplacement(int num_pages, int num_frames, PageTableKind kind = PAGE_TABLE_FLAT);
 
     /**
     * @brief Destructor
     */
     virtual ~FIFOReplacement();
 
+    /**
+     * @brief Get the name of the algorithm, for reports
+     */
+    virtual const char* get_name() const { return "FIFO"; }
+
     /**
      * @brief Access an invalid page, but free frames are available.
      * Assign the page to an available  frame, not replacement needed
@@ -50,3 +61,6 @@ public:
     virtual int replace_page(int page_num);
 
 };
+
+// Compiled in fifo_replacement.cpp, where the hooks can be inlined
+extern template class Simulator<FIFOReplacement>;
@@ -0,0 +1,80 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file index_list.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief Doubly-linked lists over a fixed range of indices, with the links kept in arrays and no allocation per node.
+ * @version 0.1
+ */
+
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief One list of an IndexLists: its ends and its length
+ */
+struct IndexListHead
+{
+    // First index, the oldest one, -1 when the list is empty
+    int head = -1;
+    // Last index, the newest one, -1 when the list is empty
+    int tail = -1;
+    // Number of indices in the list
+    int size = 0;
+};
+
+/**
+ * @brief The links of any number of lists over the indices 0 to n-1, such as frame or page numbers.
+ * An index is in at most one of the lists at a time, so one pair of link arrays serves all of them and every
+ * operation is O(1).
+ */
+class IndexLists
+{
+private:
+    // Index before each index in its list, -1 at the head
+    std::vector<int> prev;
+    // Index after each index in its list, -1 at the tail
+    std::vector<int> next;
+
+public:
+    /**
+     * @brief Constructor
+     * @param n Number of indices.
+     */
+    explicit IndexLists(int n) : prev(n, -1), next(n, -1) {}
+
+    /**
+     * @brief Append an index that is in no list
+     * @param list The list.
+     * @param i The index.
+     */
+    void push_back(IndexListHead& list, int i) {
+        prev[i] = list.tail;
+        next[i] = -1;
+        if (list.tail != -1) next[list.tail] = i; else list.head = i;
+        list.tail = i;
+        list.size++;
+    }
+
+    /**
+     * @brief Remove an index from the list holding it
+     * @param list The list.
+     * @param i The index.
+     */
+    void remove(IndexListHead& list, int i) {
+        if (prev[i] != -1) next[prev[i]] = next[i]; else list.head = next[i];
+        if (next[i] != -1) prev[next[i]] = prev[i]; else list.tail = prev[i];
+        list.size--;
+    }
+
+    /**
+     * @brief Remove and return the head of a list that is not empty
+     * @param list The list.
+     * @return The former head
+     */
+    int pop_front(IndexListHead& list) {
+        int i = list.head;
+        remove(list, i);
+        return i;
+    }
+};
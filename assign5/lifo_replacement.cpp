@@ -1,34 +1,36 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file lifo_replacement.cpp
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief A class implementing the Last in First Out (LIFO) page replacement algorithms
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
 
 #include "lifo_replacement.h"
 
-// TODO: Add your implementation here
-LIFOReplacement::LIFOReplacement(int num_pages, int num_frames)
-: Replacement(num_pages, num_frames)
+// Constructor: the stack is reserved for one page per frame, so loading never reallocates
+LIFOReplacement::LIFOReplacement(int num_pages, int num_frames, PageTableKind kind)
+: Replacement(num_pages, num_frames, kind)
 {
-    // TODO: Add additional implementation code
+    stack.reserve(num_frames);
 }
 
-// TODO: Add your implementations for desctructor, load_page, replace_page here
+// Destructor
 LIFOReplacement::~LIFOReplacement() {
-    // TODO: Add necessary code here
 }
 
 // Access an invalid page, but free frames are available
 void LIFOReplacement::load_page(int page_num) {
-    // TODO: Add necessary code here
+    stack.push_back(page_num);
 }
 
 // Access an invalid page and no free frames are available
 int LIFOReplacement::replace_page(int page_num) {
-    // TODO: Add necessary code here
-    return 0;
-}
\ No newline at end of file
+    // The most recently loaded page leaves, and the new page becomes the most recently loaded one
+    int victim = stack.back();
+    stack.back() = page_num;
+    return victim;
+}
+
+// The devirtualized replay, instantiated here so that it inlines the hooks above
+template class Simulator<LIFOReplacement>;
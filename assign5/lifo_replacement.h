@@ -1,39 +1,46 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file lifo_replacement.h
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief A class implementing the LIFO page replacement algorithms
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
 
 #pragma once
 
 // Remember to add comments to your code
 
+#include <vector>
 #include "replacement.h"
+#include "simulator.h"
 
 /**
  * @brief A class to simulate LIFO (last in first out) page replacement algorithm.
  */
 class LIFOReplacement : public Replacement {
 private:
-    // TODO: Add necessary member variables to this class
+    // Pages in the order they were loaded, the most recently loaded one last
+    std::vector<int> stack;
 
 public:
     /**
      * @brief Constructor
      * @param num_pages Total number of available free frames.
      * @param num_frames Total number of free frames.
+     * @param kind How the page table stores its entries.
      */
-    LIFOReplacement(int num_pages, int num_frames);
+    LIFOReplacement(int num_pages, int num_frames, PageTableKind kind = PAGE_TABLE_FLAT);
 
     /**
     * @brief Destructor
     */
     virtual ~LIFOReplacement();
 
+    /**
+     * @brief Get the name of the algorithm, for reports
+     */
+    virtual const char* get_name() const { return "LIFO"; }
+
     /**
      * @brief Access an invalid page, but free frames are available.
      * Assign the page to an available  frame, not replacement needed
@@ -50,3 +57,6 @@ public:
     virtual int replace_page(int page_num);
 
 };
+
+// Compiled in lifo_replacement.cpp, where the hooks can be inlined
+extern template class Simulator<LIFOReplacement>;
@@ -1,41 +1,71 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file lru_replacement.cpp
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief A class implementing the LRU page replacement algorithms
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
 
 #include "lru_replacement.h"
 
-// TODO: Add your implementation here
-LRUReplacement::LRUReplacement(int num_pages, int num_frames)
-: Replacement(num_pages, num_frames)
+// Constructor: one list node per frame, allocated once
+LRUReplacement::LRUReplacement(int num_pages, int num_frames, PageTableKind kind)
+: Replacement(num_pages, num_frames, kind), nodes(num_frames)
 {
-    // TODO: Complete this constructor
 }
 
-// TODO: Add your implementations for desctructor, touch_page, load_page, replace_page here
+// Destructor
 LRUReplacement::~LRUReplacement()
 {
-    // TODO: Add necessary code here
+}
+
+// Remove a frame from the list
+void LRUReplacement::unlink(int frame)
+{
+    Node& node = nodes[frame];
+    if (node.prev != -1) nodes[node.prev].next = node.next; else head = node.next;
+    if (node.next != -1) nodes[node.next].prev = node.prev; else tail = node.prev;
+}
+
+// Put a frame at the most recently used end of the list
+void LRUReplacement::push_front(int frame)
+{
+    Node& node = nodes[frame];
+    node.prev = -1;
+    node.next = head;
+    if (head != -1) nodes[head].prev = frame; else tail = frame;
+    head = frame;
 }
 
 // Accesss a page alreay in physical memory
 void LRUReplacement::touch_page(int page_num)
 {
-    // TODO: Update your data structure LRU replacement
+    // The page becomes the most recently used one
+    int frame = page_table[page_num].frame_num;
+    if (frame != head) {
+        unlink(frame);
+        push_front(frame);
+    }
 }
 
 // Access an invalid page, but free frames are available
 void LRUReplacement::load_page(int page_num) {
-    // TODO: Update your data structure LRU replacement and pagetable
+    // The page already has its frame, which joins the list as the most recently used one
+    int frame = page_table[page_num].frame_num;
+    nodes[frame].page = page_num;
+    push_front(frame);
 }
 
 // Access an invalid page and no free frames are available
 int LRUReplacement::replace_page(int page_num) {
-    // TODO: Update your data structure LRU replacement and pagetable
-    return 0;
-}
\ No newline at end of file
+    // The least recently used frame is handed to the new page and becomes the most recently used one
+    int frame = tail;
+    int victim = nodes[frame].page;
+    nodes[frame].page = page_num;
+    unlink(frame);
+    push_front(frame);
+    return victim;
+}
+
+// The devirtualized replay, instantiated here so that it inlines the hooks above
+template class Simulator<LRUReplacement>;
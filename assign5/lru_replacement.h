@@ -1,38 +1,72 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file lru_replacement.h
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief A class implementing the LRU page replacement algorithms
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
 
 #pragma once
 
 // Remember to add comments to your code
 
+#include <vector>
 #include "replacement.h"
+#include "simulator.h"
 
 /**
  * @brief A class to simulate the least recently used (LRU) page replacement algorithm.
  */
 class LRUReplacement : public Replacement
 {
-	// TODO: Add your implementation to this class
+private:
+    /**
+     * @brief A node of the recency list. There is one node per frame, found through the frame number in the
+     * page table, so the list needs no allocation and no lookup.
+     */
+    struct Node {
+        int prev;   // Frame used just more recently, -1 at the most recent end
+        int next;   // Frame used just less recently, -1 at the least recent end
+        int page;   // Page held by the frame
+    };
+    // The nodes, indexed by frame number
+    std::vector<Node> nodes;
+    // Most recently used frame, -1 while the list is empty
+    int head = -1;
+    // Least recently used frame, the next victim
+    int tail = -1;
+
+    /**
+     * @brief Remove a frame from the list
+     * @param frame The frame number.
+     */
+    void unlink(int frame);
+
+    /**
+     * @brief Put a frame at the most recently used end of the list
+     * @param frame The frame number.
+     */
+    void push_front(int frame);
+
 public:
 	/**
 	 * @brief Constructor
 	 * @param num_pages 
 	 * @param num_frames 
+	 * @param kind How the page table stores its entries.
 	 */
-	LRUReplacement(int num_pages, int num_frames);
+	LRUReplacement(int num_pages, int num_frames, PageTableKind kind = PAGE_TABLE_FLAT);
 	
     /**
     * @brief Destructor
     */
     virtual ~LRUReplacement();
 
+    /**
+     * @brief Get the name of the algorithm, for reports
+     */
+    virtual const char* get_name() const { return "LRU"; }
+
     /**
      * @brief Accesss a page alreay in physical memory
      * It may be overridden in a subclass 
@@ -55,4 +89,7 @@ public:
      */
     virtual int replace_page(int page_num);
 
-};
\ No newline at end of file
+};
+
+// Compiled in lru_replacement.cpp, where the hooks can be inlined
+extern template class Simulator<LRUReplacement>;
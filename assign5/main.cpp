@@ -5,10 +5,19 @@
 #include <cstdlib>
 #include <cmath>
 #include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <thread>
 
 #include "fifo_replacement.h"
 #include "lru_replacement.h"
 #include "lifo_replacement.h"
+#include "clock_replacement.h"
+#include "car_replacement.h"
+#include "trace.h"
+#include "sweep.h"
 
 // Check if an integer is power of 2
 bool isPowerOfTwo(unsigned int x) {
@@ -16,6 +25,53 @@ bool isPowerOfTwo(unsigned int x) {
     return x && (!(x & (x - 1)));
 }
 
+// Simulate a list of page numbers with a replacement algorithm, then print its statistics and run-time.
+// The replay calls the algorithm's hooks directly rather than through access_page.
+template <class Policy>
+ReplacementStats simulate(Policy& vm, const std::vector<uint32_t>& pages) {
+    Simulator<Policy>(vm).run(pages);
+    ReplacementStats stats = vm.get_stats();
+    vm.print_statistics();
+    printf("Elapsed time = %f seconds\n", stats.seconds);
+    return stats;
+}
+
+// Write the stats of Test 2 as one JSON document, with the configuration they were run with
+bool write_stats_json(const char *path, const char *trace_path, unsigned int page_size, unsigned int phys_mem_size,
+                      PageTableKind kind, const TlbConfig& tlb_config, const std::vector<ReplacementStats>& runs) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        return false;
+    }
+    std::string trace;
+    for (const char *c = trace_path; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            trace += '\\';
+        }
+        trace += *c;
+    }
+    fprintf(out, "{\"trace\": \"%s\", \"page_size\": %u, \"memory_mb\": %u, \"page_table\": \"%s\", \"tlb_entries\": %d, "
+            "\"tlb_ways\": %d,\n \"runs\": [\n", trace.c_str(), page_size, phys_mem_size >> 20, PageTable::kind_name(kind),
+            tlb_config.entries, tlb_config.ways);
+    for (size_t i = 0; i < runs.size(); i++) {
+        fprintf(out, "  %s%s\n", runs[i].to_json().c_str(), i + 1 < runs.size() ? "," : "");
+    }
+    fprintf(out, " ]}\n");
+    return fclose(out) == 0;
+}
+
+// Time a lookup of every page of a trace in a fresh page table, then print the cost per lookup and the table's footprint
+void measure_page_table(int num_pages, PageTableKind kind, const std::vector<uint32_t>& pages) {
+    PageTable table(num_pages, kind);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::vector<uint32_t>::const_iterator it = pages.begin(); it != pages.end(); ++it) {
+        table[*it].referenced = 1;
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    printf("Page table: %s, %.2f ns per lookup, %zu bytes after the trace\n", PageTable::kind_name(kind),
+           pages.empty() ? 0.0 : elapsed.count() / pages.size(), table.memory_bytes());
+}
+
 int main(int argc, char *argv[]) {
     //Print basic information about the program
     std::cout << "=================================================================" << std::endl;
@@ -26,12 +82,84 @@ int main(int argc, char *argv[]) {
     std::cout << "Description : Program to simulate different page replacement algorithms" << std::endl;
     std::cout << "=================================================================\n" << std::endl;
 
+    // Options, before or after the other arguments: -t selects the page table layout, -l the logical address bits,
+    // -T the TLB as entries[,ways[,lru|random]], -s a CSV file for a sweep of every configuration, -j its threads,
+    // -J a JSON file for the stats of Test 2
+    PageTableKind kind = PAGE_TABLE_FLAT;
+    int logic_mem_bits = 27;        // 27-bit logical memory (128 MB logical memory assumed by the assignment)
+    TlbConfig tlb_config;
+    char tlb_eviction[16] = "lru";
+    const char *sweep_path = NULL;
+    const char *json_path = NULL;
+    int num_threads = std::thread::hardware_concurrency();
+    int opt;
+    while ((opt = getopt(argc, argv, "t:l:T:s:j:J:")) != -1) {
+        if (opt == 't' && strcmp(optarg, "flat") == 0) {
+            kind = PAGE_TABLE_FLAT;
+        } else if (opt == 't' && strcmp(optarg, "radix") == 0) {
+            kind = PAGE_TABLE_RADIX;
+        } else if (opt == 't' && strcmp(optarg, "hashed") == 0) {
+            kind = PAGE_TABLE_HASHED;
+        } else if (opt == 'l') {
+            logic_mem_bits = atoi(optarg);
+        } else if (opt == 'T' && sscanf(optarg, "%d,%d,%15s", &tlb_config.entries, &tlb_config.ways, tlb_eviction) >= 1
+                   && (strcmp(tlb_eviction, "lru") == 0 || strcmp(tlb_eviction, "random") == 0)) {
+            tlb_config.eviction = strcmp(tlb_eviction, "lru") == 0 ? TLB_LRU : TLB_RANDOM;
+        } else if (opt == 's') {
+            sweep_path = optarg;
+        } else if (opt == 'J') {
+            json_path = optarg;
+        } else if (opt == 'j' && atoi(optarg) > 0) {
+            num_threads = atoi(optarg);
+        } else {
+            std::cout << "Options: -t flat|radix|hashed for the page table layout, -l bits for the logical address size," << std::endl
+                      << "         -T entries[,ways[,lru|random]] for a TLB (4 ways and LRU by default)," << std::endl
+                      << "         -s file.csv [trace] to sweep every page size and memory size, on -j threads," << std::endl
+                      << "         -J file.json to save the stats of Test 2" << std::endl;
+            exit(1);
+        }
+    }
+    if (tlb_config.entries != 0 && !tlb_config.is_valid()) {
+        std::cout << "The TLB entries must split into a power-of-two number of sets of the given ways." << std::endl;
+        return 1;
+    }
+    // The remaining arguments, numbered from 1 as before
+    argv += optind - 1;
+    argc -= optind - 1;
+
+    if (sweep_path != NULL) {
+        // Sweep mode: every algorithm at every page size and memory size, and only the trace as an argument
+        const char *trace_path = argc > 1 ? argv[1] : "large_refs.txt";
+        std::vector<uint32_t> refs;
+        if (logic_mem_bits < 27 || logic_mem_bits - 8 > 30) {
+            std::cout << "The logical address size must be at least 27 bits, with at most 2^30 pages." << std::endl;
+            return 1;
+        }
+        if (!read_pages(trace_path, 8, refs)) {
+            std::cerr << "Cannot read " << trace_path << ". Please check your path, or use a binary trace saved with 256-byte pages." << std::endl;
+            return 1;
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<SweepResult> results = run_sweep(refs, logic_mem_bits, kind, num_threads);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (!write_sweep_csv(sweep_path, results)) {
+            std::cerr << "Cannot write " << sweep_path << std::endl;
+            return 1;
+        }
+        printf("Swept %zu configurations of %zu references on %d threads in %f seconds\n", results.size(), refs.size(),
+               num_threads, elapsed.count());
+        return 0;
+    }
+
     if (argc < 3) {
         // user does not enter enough parameters
         std::cout << "You have entered too few parameters to run the program.  You must enter" << std::endl
                   << "two command-line arguments:" << std::endl
                   << " - page size (in bytes): between 256 and 8192, inclusive" << std::endl
-                  << " - physical memory size (in megabytes): between 4 and 64, inclusive" << std::endl;
+                  << " - physical memory size (in megabytes): between 4 and 64, inclusive" << std::endl
+                  << "optionally followed by:" << std::endl
+                  << " - the trace for Test 2, text or binary (default large_refs.txt)" << std::endl
+                  << " - a file to save the trace's page numbers to, as a binary trace" << std::endl;
         exit(1);
     }
 
@@ -51,7 +179,10 @@ int main(int argc, char *argv[]) {
     }
 
     // calculate number of pages and frames;
-    int logic_mem_bits = 27;        // 27-bit logical memory (128 MB logical memory assumed by the assignment)
+    if (logic_mem_bits < 27 || logic_mem_bits - (int)std::log2(page_size) > 30) {
+        std::cout << "The logical address size must be at least 27 bits, with at most 2^30 pages." << std::endl;
+        return 1;
+    }
     int phys_mem_bits = std::log2(
             phys_mem_size);        // Num of bits for physical memory addresses, calculated from physical memory size, e.g. 24 bits for 16 MB memory
     int page_offset_bits = std::log2(
@@ -82,11 +213,12 @@ int main(int argc, char *argv[]) {
         small_refs.push_back(val);
     }
     // Create a virtual memory simulation using FIFO replacement algorithm
-    FIFOReplacement vm(num_pages, num_frames);
+    FIFOReplacement vm(num_pages, num_frames, kind);
+    vm.configure_tlb(tlb_config);
     for (std::vector<int>::const_iterator it = small_refs.begin(); it != small_refs.end(); ++it) {
         int page_num = (*it) >> page_offset_bits;
         bool isPageFault = vm.access_page(page_num, 0);
-        PageEntry pg = vm.getPageEntry(page_num);
+        const PageEntry& pg = vm.getPageEntry(page_num);
         std::cout << "Logical address: " << *it << ", \tpage number: " << page_num;
         std::cout << ", \tframe number = " << pg.frame_num << ", \tis page fault? " << isPageFault << std::endl;
     }
@@ -95,17 +227,66 @@ int main(int argc, char *argv[]) {
 
     // Test 2: Read and simulate the large list of logical addresses from the input file "large_refs.txt"
     std::cout << "\n================================Test 2==================================================\n";
+    // Read the trace once as page numbers, every algorithm replays the same list
+    const char *trace_path = argc > 3 ? argv[3] : "large_refs.txt";
+    std::vector<uint32_t> large_refs;
+    if (!read_pages(trace_path, page_offset_bits, large_refs)) {
+        std::cerr << "Cannot read " << trace_path << ". Please check your path, or use a binary trace saved with a page size no larger than this one." << std::endl;
+        return 1;
+    }
+    if (argc > 4 && !write_pages(argv[4], page_offset_bits, large_refs)) {
+        std::cerr << "Cannot write the binary trace " << argv[4] << std::endl;
+        return 1;
+    }
+    std::cout << "Total number of references: " << large_refs.size() << std::endl;
+    measure_page_table(num_pages, kind, large_refs);
+    std::vector<ReplacementStats> runs;
 
     std::cout << "****************Simulate FIFO replacement****************************" << std::endl;
-    // TODO: Add your code to calculate number of page faults using FIFO replacement algorithm
-    // TODO: print the statistics and run-time
+    // Calculate number of page faults using FIFO replacement algorithm
+    {
+        FIFOReplacement fifo(num_pages, num_frames, kind);
+        fifo.configure_tlb(tlb_config);
+        runs.push_back(simulate(fifo, large_refs));
+    }
 
     std::cout << "****************Simulate LIFO replacement****************************" << std::endl;
-    // TODO: Add your code to calculate number of page faults using LIFO replacement algorithm
-    // TODO: print the statistics and run-time
+    // Calculate number of page faults using LIFO replacement algorithm
+    {
+        LIFOReplacement lifo(num_pages, num_frames, kind);
+        lifo.configure_tlb(tlb_config);
+        runs.push_back(simulate(lifo, large_refs));
+    }
 
     std::cout << "****************Simulate LRU replacement****************************" << std::endl;
-    // TODO: Add your code to calculate number of page faults using LRU replacement algorithm
-    // TODO: print the statistics and run-time
+    // Calculate number of page faults using LRU replacement algorithm
+    {
+        LRUReplacement lru(num_pages, num_frames, kind);
+        lru.configure_tlb(tlb_config);
+        runs.push_back(simulate(lru, large_refs));
+    }
+
+    std::cout << "****************Simulate Clock replacement****************************" << std::endl;
+    // Calculate number of page faults using the clock (second-chance) approximation of LRU
+    {
+        ClockReplacement clock(num_pages, num_frames, kind);
+        clock.configure_tlb(tlb_config);
+        runs.push_back(simulate(clock, large_refs));
+    }
+
+    std::cout << "****************Simulate CAR replacement****************************" << std::endl;
+    // Calculate number of page faults using CAR, the adaptive clock
+    {
+        CARReplacement car(num_pages, num_frames, kind);
+        car.configure_tlb(tlb_config);
+        runs.push_back(simulate(car, large_refs));
+    }
+
+    std::cout << "****************Summary****************************" << std::endl;
+    print_stats_table(runs);
+    if (json_path != NULL && !write_stats_json(json_path, trace_path, page_size, phys_mem_size, kind, tlb_config, runs)) {
+        std::cerr << "Cannot write " << json_path << std::endl;
+        return 1;
+    }
 
 }
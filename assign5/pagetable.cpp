@@ -1,24 +1,147 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file pagetable.cpp
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief This class represents a traditional pagetable data structure.
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
 
 #include "pagetable.h"
 
-// TODO: Add your implementation of PageTable
-// Constrcutor
-// TODO: Add your code
-PageTable::PageTable(int num_pages) {
-    
+const PageEntry PageTable::empty_entry;
+
+// Constructor: the flat layout creates one invalid entry for every logical page, the others start empty
+PageTable::PageTable(int num_pages, PageTableKind kind)
+: kind(kind), num_pages(num_pages)
+{
+    if (kind == PAGE_TABLE_FLAT) {
+        pages.resize(num_pages);
+    } else if (kind == PAGE_TABLE_RADIX) {
+        // Enough levels of RADIX_BITS to cover every page number, with at least a root above the leaves
+        int bits = 0;
+        while (bits < 31 && (1u << bits) < (unsigned)num_pages) {
+            bits++;
+        }
+        radix_levels = (bits + RADIX_BITS - 1) / RADIX_BITS;
+        if (radix_levels < 2) {
+            radix_levels = 2;
+        }
+        radix_root = new void *[RADIX_SIZE]();
+        radix_nodes.push_back(radix_root);
+    } else {
+        hash_slots.assign(16, HashSlot{-1, 0});
+        hash_shift = 32 - 4;
+    }
 }
 
 // Destructor
-// TODO: Add your code
 PageTable::~PageTable() {
-    
-}
\ No newline at end of file
+    for (size_t i = 0; i < radix_nodes.size(); i++) {
+        delete[] radix_nodes[i];
+    }
+    for (size_t i = 0; i < radix_leaves.size(); i++) {
+        delete[] radix_leaves[i];
+    }
+    for (size_t i = 0; i < hash_blocks.size(); i++) {
+        delete[] hash_blocks[i];
+    }
+}
+
+// Find or create the entry of a page in the radix tree
+PageEntry& PageTable::radix_entry(int i) {
+    void **node = radix_root;
+    // Each level uses the next RADIX_BITS of the page number to pick a child, created on first use
+    for (int level = radix_levels - 1; level > 1; level--) {
+        void *&child = node[(i >> (level * RADIX_BITS)) & (RADIX_SIZE - 1)];
+        if (child == nullptr) {
+            void **created = new void *[RADIX_SIZE]();
+            radix_nodes.push_back(created);
+            child = created;
+        }
+        node = (void **)child;
+    }
+    void *&leaf = node[(i >> RADIX_BITS) & (RADIX_SIZE - 1)];
+    if (leaf == nullptr) {
+        PageEntry *created = new PageEntry[RADIX_SIZE];
+        radix_leaves.push_back(created);
+        leaf = created;
+    }
+    return ((PageEntry *)leaf)[i & (RADIX_SIZE - 1)];
+}
+
+// Find the slot of a page in the hashed table
+size_t PageTable::hash_find(int i) const {
+    // Fibonacci hashing spreads neighbouring page numbers over the slots
+    size_t mask = hash_slots.size() - 1;
+    size_t slot = ((uint32_t)i * 2654435769u) >> hash_shift;
+    while (hash_slots[slot].page != i && hash_slots[slot].page != -1) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Double the number of slots of the hashed table
+void PageTable::hash_grow() {
+    vector<HashSlot> old;
+    old.swap(hash_slots);
+    hash_slots.assign(old.size() * 2, HashSlot{-1, 0});
+    hash_shift--;
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].page != -1) {
+            hash_slots[hash_find(old[i].page)] = old[i];
+        }
+    }
+}
+
+// Find or create the entry of a page in the hashed table
+PageEntry& PageTable::hashed_entry(int i) {
+    size_t slot = hash_find(i);
+    if (hash_slots[slot].page == -1) {
+        // Keeps the table at most half full, so probes stay short
+        if (2 * (hash_count + 1) > hash_slots.size()) {
+            hash_grow();
+            slot = hash_find(i);
+        }
+        if (hash_count % HASH_BLOCK == 0) {
+            hash_blocks.push_back(new PageEntry[HASH_BLOCK]);
+        }
+        hash_slots[slot].page = i;
+        hash_slots[slot].index = hash_count++;
+    }
+    uint32_t index = hash_slots[slot].index;
+    return hash_blocks[index / HASH_BLOCK][index % HASH_BLOCK];
+}
+
+// Find the entry of a page in a lazy layout without creating it
+const PageEntry *PageTable::find_entry(int i) const {
+    if (kind == PAGE_TABLE_RADIX) {
+        void **node = radix_root;
+        for (int level = radix_levels - 1; level > 0 && node != nullptr; level--) {
+            node = (void **)node[(i >> (level * RADIX_BITS)) & (RADIX_SIZE - 1)];
+        }
+        return node != nullptr ? &((const PageEntry *)node)[i & (RADIX_SIZE - 1)] : nullptr;
+    }
+    const HashSlot& slot = hash_slots[hash_find(i)];
+    return slot.page == i ? &hash_blocks[slot.index / HASH_BLOCK][slot.index % HASH_BLOCK] : nullptr;
+}
+
+// Get the name of a layout
+const char *PageTable::kind_name(PageTableKind kind) {
+    switch (kind) {
+    case PAGE_TABLE_RADIX:
+        return "radix";
+    case PAGE_TABLE_HASHED:
+        return "hashed";
+    default:
+        return "flat";
+    }
+}
+
+// Get the memory taken by the page table
+size_t PageTable::memory_bytes() const {
+    return pages.size() * sizeof(PageEntry)
+        + radix_nodes.size() * RADIX_SIZE * sizeof(void *)
+        + radix_leaves.size() * RADIX_SIZE * sizeof(PageEntry)
+        + hash_slots.size() * sizeof(HashSlot)
+        + hash_blocks.size() * HASH_BLOCK * sizeof(PageEntry);
+}
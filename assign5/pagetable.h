@@ -1,16 +1,15 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file pagetable.h
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief This class represents a traditional pagetable data structure.
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
 
 #pragma once
 
 // Remember to add comments to your code
+#include <cstdint>
 #include <vector>
 using namespace std;
 
@@ -20,42 +19,177 @@ using namespace std;
  * @details Each page has one entry in the page table. It contains the following fields:
  * - frame number
  * - valid bit
+ * - dirty bit
+ * - reference bit
+ * The fields are packed into one 32-bit word, so an entry takes 4 bytes instead of 8 and a cache line holds 16 of them.
  */
 class PageEntry
 {
 public:
-	// Physical frame number for a given page
-	int frame_num;
+	// Physical frame number for a given page, -1 until the page is first loaded; 29 bits allow 2^28 frames
+	int32_t frame_num : 29;
 	// valid bit represents whether a page is in the physical memory
-	bool valid = false;
+	uint32_t valid : 1;
     // dirty bit represents whether a page is changed
-    bool dirty = false;
+    uint32_t dirty : 1;
+    // reference bit, set on access and cleared by the clock-based replacement algorithms
+    uint32_t referenced : 1;
+
+    // Constructor: an invalid entry with no frame
+    PageEntry() : frame_num(-1), valid(0), dirty(0), referenced(0) {}
 };
+static_assert(sizeof(PageEntry) == sizeof(uint32_t), "PageEntry must pack into one 32-bit word");
 
 
+/**
+ * @brief The ways a page table can store its entries
+ */
+enum PageTableKind
+{
+    // One entry per logical page, allocated up front
+    PAGE_TABLE_FLAT,
+    // A radix tree of 1024-entry nodes, like a multi-level hardware page table, allocated on first touch
+    PAGE_TABLE_RADIX,
+    // A hash table from page number to entry, holding only the pages touched so far
+    PAGE_TABLE_HASHED
+};
+
 /**
  * @brief A page table is like an array of page entries.
- * The size of the page table should equal to the number of pages in logical memory
+ * The size of the page table should equal to the number of pages in logical memory.
+ * @details The flat layout suits a small, dense logical space. The radix and hashed layouts allocate entries only
+ * for the pages that are touched, so sparse or very large logical spaces cost memory in proportion to their use.
+ * In every layout an entry stays at the same address once created, so references to entries remain valid.
  */
 class PageTable
 {
 private:
-    // A page table is like an array of page entries.
+    // Bits of the page number consumed by each level of the radix tree, and the size of its nodes
+    static const int RADIX_BITS = 10;
+    static const int RADIX_SIZE = 1 << RADIX_BITS;
+    // Number of entries in each block of the hashed table's entry storage
+    static const int HASH_BLOCK = 1024;
+
+    /**
+     * @brief A slot of the hashed table, mapping a page number to the position of its entry
+     */
+    struct HashSlot {
+        int page;       // The page number, -1 if the slot is empty
+        uint32_t index; // Position of the entry in the blocks
+    };
+
+    // How the entries are stored
+    PageTableKind kind;
+    // Number of logical pages
+    int num_pages;
+
+    // The flat layout: a page table is like an array of page entries.
     vector<PageEntry> pages;
+
+    // The radix layout: number of levels, the root node, and every node and leaf allocated, for the destructor
+    int radix_levels = 0;
+    void **radix_root = nullptr;
+    vector<void **> radix_nodes;
+    vector<PageEntry *> radix_leaves;
+
+    // The hashed layout: open-addressed slots with linear probing, a power of two in number, and blocks of
+    // entries that never move when the slots are rehashed
+    vector<HashSlot> hash_slots;
+    int hash_shift = 0;
+    uint32_t hash_count = 0;
+    vector<PageEntry *> hash_blocks;
+
+    // The entry returned by const lookups of pages the lazy layouts have not created
+    static const PageEntry empty_entry;
+
+    /**
+     * @brief Find or create the entry of a page in the radix tree
+     */
+    PageEntry& radix_entry(int i);
+
+    /**
+     * @brief Find or create the entry of a page in the hashed table
+     */
+    PageEntry& hashed_entry(int i);
+
+    /**
+     * @brief Find the entry of a page in a lazy layout without creating it
+     * @return The entry, or nullptr if the page has never been touched
+     */
+    const PageEntry *find_entry(int i) const;
+
+    /**
+     * @brief Find the slot of a page in the hashed table
+     * @return The slot holding the page, or the empty slot where it would go
+     */
+    size_t hash_find(int i) const;
+
+    /**
+     * @brief Double the number of slots of the hashed table and reinsert the pages
+     */
+    void hash_grow();
+
 public:
-    // Constructor
-    PageTable(int num_pages);
+    /**
+     * @brief Constructor
+     * @param num_pages Total number of logical pages.
+     * @param kind How to store the entries.
+     */
+    PageTable(int num_pages, PageTableKind kind = PAGE_TABLE_FLAT);
     // Destructor
     ~PageTable();
 
-	// TODO: Add your implementation of the page table here
+    PageTable(const PageTable&) = delete;
+    PageTable& operator=(const PageTable&) = delete;
 
     /**
-     * @brief Access a page in the page table.
-     * @param i
-     * @return
+     * @brief Access a page in the page table, creating its entry in a lazy layout.
+     * @param i The logical page number.
+     * @return The entry of the page
      */
     PageEntry& operator [] (int i) {
-        return pages[i];
+        if (kind == PAGE_TABLE_FLAT) {
+            return pages[i];
+        }
+        return kind == PAGE_TABLE_RADIX ? radix_entry(i) : hashed_entry(i);
     }
-};
\ No newline at end of file
+
+    /**
+     * @brief Read a page in the page table.
+     * @param i The logical page number.
+     * @return The entry of the page, an invalid one if a lazy layout has not created it
+     */
+    const PageEntry& operator [] (int i) const {
+        if (kind == PAGE_TABLE_FLAT) {
+            return pages[i];
+        }
+        const PageEntry *entry = find_entry(i);
+        return entry != nullptr ? *entry : empty_entry;
+    }
+
+    /**
+     * @brief Get the number of entries, one per logical page.
+     * @return The number of pages
+     */
+    int size() const {
+        return num_pages;
+    }
+
+    /**
+     * @brief Get how the entries are stored
+     */
+    PageTableKind get_kind() const {
+        return kind;
+    }
+
+    /**
+     * @brief Get the name of a layout, as used on the command line
+     */
+    static const char *kind_name(PageTableKind kind);
+
+    /**
+     * @brief Get the memory taken by the entries and the structures that find them
+     * @return The footprint in bytes
+     */
+    size_t memory_bytes() const;
+};
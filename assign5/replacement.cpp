@@ -1,45 +1,92 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file replacement.cpp
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief A base class for different page replacement algorithms.
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
+#include <cstdio>
 #include <iostream>
 #include "replacement.h"
 
-// TODO: Add your implementation of the Replacement member functions here
-
 // Constructor
-Replacement::Replacement(int num_pages, int num_frames)
-: page_table(num_pages)
+Replacement::Replacement(int num_pages, int num_frames, PageTableKind kind)
+: page_table(num_pages, kind), num_frames(num_frames)
 {
-	//TODO: Add your implementation here
 }
 
 // Destructor
 Replacement::~Replacement()
 {
-    // TOOD: Add your code here
 }
 
 // Simulate a single page access 
 // @return true if it's a page fault
 bool Replacement::access_page(int page_num, bool is_write)
 {
-    // TODO: Add your implementation here
-    // If the page is valid, it calls the touch_page function. 
-    // If the page is not valid but free frames are available, it calls the load_page function.
-    // If the page is not valid and there is no free frame, it calls the replace_page function.
-    return false;
+    return access_with(page_num, is_write,
+                       [this](int page) { touch_page(page); },
+                       [this](int page) { load_page(page); },
+                       [this](int page) { return replace_page(page); });
 }
 
 // Print out statistics of simulation
 void Replacement::print_statistics() const {
-        // TODO: print out the number of references, number of page faults and number of page replacements
-		std::cout << "Number of references: \t\t"  << std::endl;
-		std::cout << "Number of page faults: \t\t" << std::endl;
-		std::cout << "Number of page replacements: \t"  << std::endl;
-}
\ No newline at end of file
+		std::cout << "Number of references: \t\t" << num_references << std::endl;
+		std::cout << "Number of page faults: \t\t" << num_faults << std::endl;
+		std::cout << "Number of page replacements: \t" << num_replacements << std::endl;
+		if (tlb.enabled()) {
+			long lookups = tlb.get_hits() + tlb.get_misses();
+			std::cout << "Number of TLB hits: \t\t" << tlb.get_hits() << std::endl;
+			std::cout << "Number of TLB misses: \t\t" << tlb.get_misses() << std::endl;
+			std::cout << "TLB hit rate: \t\t\t" << (lookups ? 100.0 * tlb.get_hits() / lookups : 0.0) << "%" << std::endl;
+		}
+}
+
+// Get all the counters and the replay time
+ReplacementStats Replacement::get_stats() const {
+    ReplacementStats stats;
+    stats.policy = get_name();
+    stats.references = num_references;
+    stats.hits = num_references - num_faults;
+    stats.loads = num_faults - num_replacements;
+    stats.replacements = num_replacements;
+    stats.writebacks = num_writebacks;
+    stats.tlb_hits = tlb.get_hits();
+    stats.tlb_misses = tlb.get_misses();
+    stats.seconds = run_seconds;
+    return stats;
+}
+
+// References simulated per second of replay
+double ReplacementStats::references_per_second() const {
+    return seconds > 0 ? references / seconds : 0.0;
+}
+
+// Average time of one access in nanoseconds
+double ReplacementStats::ns_per_access() const {
+    return references > 0 ? seconds * 1e9 / references : 0.0;
+}
+
+// Format the stats as one JSON object; the policy names need no escaping
+std::string ReplacementStats::to_json() const {
+    char text[512];
+    snprintf(text, sizeof(text),
+             "{\"policy\": \"%s\", \"references\": %ld, \"hits\": %ld, \"loads\": %ld, \"replacements\": %ld, "
+             "\"writebacks\": %ld, \"tlb_hits\": %ld, \"tlb_misses\": %ld, \"seconds\": %.9f, "
+             "\"references_per_second\": %.1f, \"ns_per_access\": %.3f}",
+             policy, references, hits, loads, replacements, writebacks, tlb_hits, tlb_misses, seconds,
+             references_per_second(), ns_per_access());
+    return text;
+}
+
+// Print stats as a table, one line per run
+void print_stats_table(const std::vector<ReplacementStats>& runs) {
+    printf("%-8s %10s %10s %10s %10s %10s %10s %12s %10s\n", "policy", "references", "hits", "loads", "replaced",
+           "writebacks", "time (s)", "refs/s", "ns/access");
+    for (size_t i = 0; i < runs.size(); i++) {
+        const ReplacementStats& r = runs[i];
+        printf("%-8s %10ld %10ld %10ld %10ld %10ld %10.6f %12.0f %10.2f\n", r.policy, r.references, r.hits, r.loads,
+               r.replacements, r.writebacks, r.seconds, r.references_per_second(), r.ns_per_access());
+    }
+}
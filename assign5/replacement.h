@@ -1,16 +1,60 @@
 /**
 * Assignment 5: Page replacement algorithms
  * @file replacement.h
- * @author ??? (TODO: your name)
+ * @author Noya Hafiz, Christian Lim
  * @brief A base class for different page replacement algorithms.
  * @version 0.1
  */
-//You must complete the all parts marked as "TODO". Delete "TODO" after you are done.
-// Remember to add sufficient and clear comments to your code
 #pragma once
 
 #include "pagetable.h"
+#include <string>
+#include <vector>
+#include "tlb.h"
 
+template <class Policy> class Simulator;
+
+/**
+ * @brief The counters of a simulation and the time spent replaying traces, the same for every algorithm
+ */
+struct ReplacementStats
+{
+    // Name of the replacement algorithm
+    const char *policy = "";
+    // Number of page accesses, split into hits, faults given a free frame and faults that replaced a page
+    long references = 0;
+    long hits = 0;
+    long loads = 0;
+    long replacements = 0;
+    // Number of replaced pages that were dirty and so written back
+    long writebacks = 0;
+    // Number of TLB hits and misses, both 0 without a TLB
+    long tlb_hits = 0;
+    long tlb_misses = 0;
+    // Wall time of the trace replays, in seconds
+    double seconds = 0;
+
+    /**
+     * @brief Get the references simulated per second of replay, 0 before any timed replay
+     */
+    double references_per_second() const;
+
+    /**
+     * @brief Get the average time of one access in nanoseconds, 0 before any timed replay
+     */
+    double ns_per_access() const;
+
+    /**
+     * @brief Format the stats as one JSON object, with the rates included
+     */
+    std::string to_json() const;
+};
+
+/**
+ * @brief Print stats as a table, one line per run
+ * @param runs The stats of each run.
+ */
+void print_stats_table(const std::vector<ReplacementStats>& runs);
 
 /**
  * @brief A base class to simulate page replacement algorithms.
@@ -18,30 +62,124 @@
  */
 class Replacement
 {
+    // The devirtualized replay drives the page table and counters like access_page
+    template <class Policy> friend class Simulator;
+
 protected:      // subclasses can access these members
     // Member variable for the page table
     PageTable page_table;
-	// TODO: Add additional member variables to this class
-	
+    // The TLB consulted before the page table, disabled unless configured
+    Tlb tlb;
+    // Number of physical frames
+    int num_frames;
+    // Number of frames handed out so far; frames are given out in order, so the next free frame is this one
+    int frames_used = 0;
+    // Number of valid pages with the dirty bit set, so a policy can tell when no page needs writing back
+    int dirty_frames = 0;
+    // Number of page accesses, page faults and page replacements so far
+    int num_references = 0;
+    int num_faults = 0;
+    int num_replacements = 0;
+    // Number of dirty victims written back
+    int num_writebacks = 0;
+    // Wall time spent in Simulator::run, in seconds
+    double run_seconds = 0;
+
+    /**
+     * @brief Handle a page fault: give the page the next free frame, or the frame of the policy's victim
+     * @details Both access_page and Simulator go through here; they only differ in how they call the hooks.
+     * @param page_num The logical page number.
+     * @param entry The page's entry in the page table.
+     * @param is_write whether this access a memory write
+     * @param load Calls load_page(page_num).
+     * @param replace Calls replace_page(page_num) and returns the victim page #.
+     */
+    template <class Load, class Replace>
+    void fault_with(int page_num, PageEntry& entry, bool is_write, Load load, Replace replace)
+    {
+        num_faults++;
+        if (frames_used < num_frames) {
+            // If the page is not valid but free frames are available, it calls the load_page function.
+            entry.frame_num = frames_used++;
+            entry.valid = true;
+            entry.dirty = is_write;
+            dirty_frames += is_write;
+            load(page_num);
+        } else {
+            // If the page is not valid and there is no free frame, it calls the replace_page function.
+            num_replacements++;
+            int victim_page = replace(page_num);
+            tlb.invalidate(victim_page);
+            PageEntry& victim = page_table[victim_page];
+            entry.frame_num = victim.frame_num;
+            entry.valid = true;
+            num_writebacks += victim.dirty;
+            dirty_frames += (int)is_write - (int)victim.dirty;
+            entry.dirty = is_write;
+            victim.valid = false;
+            victim.dirty = false;
+            victim.referenced = false;
+        }
+        tlb.insert(page_num);
+    }
+
+    /**
+     * @brief Simulate a single page access, calling the hooks through the given functions
+     * @param page_num The logical page number.
+     * @param is_write whether this access a memory write
+     * @param touch Calls touch_page(page_num).
+     * @param load Calls load_page(page_num).
+     * @param replace Calls replace_page(page_num) and returns the victim page #.
+     * @return whether it's a page fault: true if it's a page fault
+     */
+    template <class Touch, class Load, class Replace>
+    bool access_with(int page_num, bool is_write, Touch touch, Load load, Replace replace)
+    {
+        num_references++;
+        if (tlb.lookup(page_num)) {
+            if (is_write && !page_table[page_num].dirty) {
+                page_table[page_num].dirty = true;
+                dirty_frames++;
+            }
+            touch(page_num);
+            return false;
+        }
+        PageEntry& entry = page_table[page_num];
+        // If the page is valid, it calls the touch_page function.
+        if (entry.valid) {
+            if (is_write && !entry.dirty) {
+                entry.dirty = true;
+                dirty_frames++;
+            }
+            touch(page_num);
+            tlb.insert(page_num);
+            return false;
+        }
+        fault_with(page_num, entry, is_write, load, replace);
+        return true;
+    }
+
 public:
 	/**
 	 * @brief 
 	 * @param num_pages Total number of logical pages for the simulation.
 	 * @param num_frames Total number of available free frames.
+	 * @param kind How the page table stores its entries.
 	 */
-	Replacement(int num_pages, int num_frames);
+	Replacement(int num_pages, int num_frames, PageTableKind kind = PAGE_TABLE_FLAT);
 
     /**
      * @brief Destructor
      */
     virtual ~Replacement();
 
-	// TODO: Add additional member variables and functions if needed
     /**
 	 * @brief Simulate a single page access.
      * @details If the page is valid, it calls the touch_page function. 
      *          If the page is not valid but free frames are available, it calls the load_page function.
      *          If the page is not valid and there is no free frame, it calls the replace_page function.
+     *          The page table itself is updated here, so the subclasses only keep the state of their policy.
+     *          A page found in the TLB is known to be valid, so only a write has to go to its page entry.
      * @param page_num The logical page number.
 	 * @param is_write whether this access a memory write
 	 * @return whether it's a page fault: true if it's a page fault
@@ -58,6 +196,7 @@ public:
     /**
      * @brief Access an invalid page, but free frames are available.
      * Assign the page to an available frame, not replacement needed
+     * It is called after the page has been given the next free frame and marked valid.
      * It may be overridden in a subclass 
      * @param page_num The logical page number.
      */
@@ -67,6 +206,7 @@ public:
     /**
 	 * @brief Access an invalid page and no free frame is available.
      * Select a victim page to be replaced.
+     * The caller then moves the victim's frame to the new page and marks the victim invalid.
 	 * It is a pure virtual function to be implemented in specific replacement subclasses.
      * @param page_num  The logical page number of the desired page.
 	 * @return Selected victim page #
@@ -74,14 +214,61 @@ public:
     virtual int replace_page(int page_num) = 0;
 
     /**
-	 * @brief Get the ith entry of the page table
+	 * @brief Get the ith entry of the page table, without copying it
 	 */
-    PageEntry getPageEntry(int page_num) {
+    const PageEntry& getPageEntry(int page_num) const {
         return page_table[page_num];
     }
 
+    /**
+     * @brief Get the page table, for its layout and memory footprint
+     */
+    const PageTable& get_page_table() const {
+        return page_table;
+    }
+
+    /**
+     * @brief Put a TLB in front of the page table, replacing any earlier one. Call it before the first access.
+     * @param config The shape of the TLB, which must be valid or have no entries
+     */
+    void configure_tlb(const TlbConfig& config) {
+        tlb = Tlb(config);
+    }
+
+    /**
+     * @brief Get the TLB, for its hit and miss counts
+     */
+    const Tlb& get_tlb() const {
+        return tlb;
+    }
+
     /**
 	 * @brief Print the statistics of simulation
 	 */
     void print_statistics() const;
+
+    /**
+     * @brief Get the name of the algorithm, for reports
+     */
+    virtual const char* get_name() const = 0;
+
+    /**
+     * @brief Get all the counters and the replay time
+     */
+    ReplacementStats get_stats() const;
+
+    /**
+     * @brief Get the number of page accesses so far
+     */
+    int get_num_references() const { return num_references; }
+
+    /**
+     * @brief Get the number of page faults so far
+     */
+    int get_num_faults() const { return num_faults; }
+
+    /**
+     * @brief Get the number of page replacements so far
+     */
+    int get_num_replacements() const { return num_replacements; }
 };
\ No newline at end of file
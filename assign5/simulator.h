@@ -0,0 +1,164 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file simulator.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A replay of page references with the hooks of one replacement algorithm called directly, not virtually.
+ * @version 0.1
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "replacement.h"
+
+/**
+ * @brief Simulate page accesses on a replacement algorithm whose type is known at compile time.
+ * @details It uses the same bookkeeping as Replacement::access_page, Replacement::access_with and fault_with, but
+ *          passes them the hooks qualified with Policy, so they are ordinary calls that the compiler can inline. Simulator<Policy> is
+ *          instantiated in the policy's own source file, next to the hooks; the policy's header declares that
+ *          instantiation so that no other file compiles its own copy.
+ * @tparam Policy A subclass of Replacement.
+ */
+template <class Policy>
+class Simulator
+{
+private:
+    // The algorithm, with its page table and counters
+    Policy& vm;
+
+    // Whether the policy keeps the touch_page of Replacement, which does nothing. &Policy::touch_page only has the
+    // type of a pointer to a member of Replacement when Policy does not declare its own.
+    static const bool TOUCH_IS_NOOP = std::is_same<decltype(&Policy::touch_page), void (Replacement::*)(int)>::value;
+
+    /**
+     * @brief Handle a page fault: give the page the next free frame, or the frame of the policy's victim
+     * @param page_num The logical page number.
+     * @param entry The page's entry in the page table.
+     * @param is_write whether this access a memory write
+     */
+    void fault(int page_num, PageEntry& entry, bool is_write);
+
+    /**
+     * @brief Simulate reads of a list of pages when there is no TLB
+     * @param pages The logical page numbers, in order.
+     */
+    void replay(const std::vector<uint32_t>& pages);
+
+    /**
+     * @brief Simulate reads of a list of pages through the TLB
+     * @param pages The logical page numbers, in order.
+     */
+    void replay_tlb(const std::vector<uint32_t>& pages);
+
+public:
+    /**
+     * @brief Constructor
+     * @param vm The algorithm to drive. It can still be used through Replacement, before or after.
+     */
+    explicit Simulator(Policy& vm) : vm(vm) {}
+
+    /**
+     * @brief Simulate a single page access, exactly like Replacement::access_page
+     * @param page_num The logical page number.
+     * @param is_write whether this access a memory write
+     * @return whether it's a page fault: true if it's a page fault
+     */
+    bool access_page(int page_num, bool is_write = false);
+
+    /**
+     * @brief Simulate reads of a list of pages
+     * @details Without a TLB a hit is only a probe of the page table and, unless the policy's touch_page does
+     *          nothing, a call to it; the references are counted once at the end. With a TLB the probe of the TLB is
+     *          inlined into the same kind of loop, and its misses are counted once at the end too. The wall time of
+     *          the replay is added to the algorithm's stats.
+     * @param pages The logical page numbers, in order.
+     */
+    void run(const std::vector<uint32_t>& pages);
+};
+
+// The members below are not inline, so a file that sees the extern instantiation of a policy calls the copy
+// compiled next to its hooks
+
+// Handle a page fault: take the next free frame, or else the victim's frame
+template <class Policy>
+void Simulator<Policy>::fault(int page_num, PageEntry& entry, bool is_write)
+{
+    Policy& policy = vm;
+    vm.fault_with(page_num, entry, is_write,
+                  [&policy](int page) { policy.Policy::load_page(page); },
+                  [&policy](int page) { return policy.Policy::replace_page(page); });
+}
+
+// Simulate a single page access
+template <class Policy>
+bool Simulator<Policy>::access_page(int page_num, bool is_write)
+{
+    Policy& policy = vm;
+    return vm.access_with(page_num, is_write,
+                          [&policy](int page) { policy.Policy::touch_page(page); },
+                          [&policy](int page) { policy.Policy::load_page(page); },
+                          [&policy](int page) { return policy.Policy::replace_page(page); });
+}
+
+// Simulate reads of a list of pages
+template <class Policy>
+void Simulator<Policy>::run(const std::vector<uint32_t>& pages)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (vm.tlb.enabled()) {
+        replay_tlb(pages);
+    } else {
+        replay(pages);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    vm.run_seconds += elapsed.count();
+}
+
+// Replay reads without a TLB
+template <class Policy>
+void Simulator<Policy>::replay(const std::vector<uint32_t>& pages)
+{
+    for (std::vector<uint32_t>::const_iterator it = pages.begin(); it != pages.end(); ++it) {
+        int page_num = *it;
+        PageEntry& entry = vm.page_table[page_num];
+        if (entry.valid) {
+            if (!TOUCH_IS_NOOP) {
+                vm.Policy::touch_page(page_num);
+            }
+            continue;
+        }
+        fault(page_num, entry, false);
+    }
+    vm.num_references += pages.size();
+}
+
+// Replay reads through the TLB
+template <class Policy>
+void Simulator<Policy>::replay_tlb(const std::vector<uint32_t>& pages)
+{
+    long misses = 0;
+    for (std::vector<uint32_t>::const_iterator it = pages.begin(); it != pages.end(); ++it) {
+        int page_num = *it;
+        if (vm.tlb.contains(page_num)) {
+            if (!TOUCH_IS_NOOP) {
+                vm.Policy::touch_page(page_num);
+            }
+            continue;
+        }
+        misses++;
+        PageEntry& entry = vm.page_table[page_num];
+        if (entry.valid) {
+            if (!TOUCH_IS_NOOP) {
+                vm.Policy::touch_page(page_num);
+            }
+            vm.tlb.insert(page_num);
+            continue;
+        }
+        fault(page_num, entry, false);
+    }
+    vm.tlb.count((long)pages.size() - misses, misses);
+    vm.num_references += pages.size();
+}
@@ -0,0 +1,229 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file sweep.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief A sweep of every replacement algorithm over every page size and memory size, run on a thread pool.
+ * @version 0.1
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include "sweep.h"
+#include "fifo_replacement.h"
+#include "lifo_replacement.h"
+#include "lru_replacement.h"
+#include "clock_replacement.h"
+#include "car_replacement.h"
+
+namespace {
+
+// The range of the sweep, as powers of two: 256 to 8192 byte pages and 4 to 64 MB of memory
+const int MIN_PAGE_BITS = 8;
+const int MAX_PAGE_BITS = 13;
+const int MIN_MEMORY_BITS = 22;
+const int MAX_MEMORY_BITS = 26;
+const int NUM_MEMORY_SIZES = MAX_MEMORY_BITS - MIN_MEMORY_BITS + 1;
+
+// The algorithms, in the order of the results
+enum SweepPolicy { SWEEP_FIFO, SWEEP_LIFO, SWEEP_LRU, SWEEP_CLOCK, SWEEP_CAR, NUM_SWEEP_POLICIES };
+const char *const POLICY_NAMES[NUM_SWEEP_POLICIES] = {"FIFO", "LIFO", "LRU", "Clock", "CAR"};
+
+// One piece of work for the pool: one simulation, or the whole LRU curve of a page size
+struct SweepTask
+{
+    SweepPolicy policy;
+    int page_bits;
+    // Index of the memory size from MIN_MEMORY_BITS, unused for LRU which covers every size
+    int memory_index;
+};
+
+// Simulate one algorithm over a trace and keep its counts
+template <class Policy>
+void replay(const std::vector<uint32_t>& pages, int num_pages, int num_frames, PageTableKind kind, SweepResult& result)
+{
+    Policy vm(num_pages, num_frames, kind);
+    Simulator<Policy>(vm).run(pages);
+    result.num_references = vm.get_num_references();
+    result.num_faults = vm.get_num_faults();
+    result.num_replacements = vm.get_num_replacements();
+}
+
+// The index of a result, ordered by policy, then page size, then memory size
+size_t result_index(SweepPolicy policy, int page_bits, int memory_index)
+{
+    return ((size_t)policy * (MAX_PAGE_BITS - MIN_PAGE_BITS + 1) + (page_bits - MIN_PAGE_BITS)) * NUM_MEMORY_SIZES + memory_index;
+}
+
+// Count the distinct pages of a trace, for the replacements of the LRU curve
+long count_distinct(const std::vector<uint32_t>& pages)
+{
+    std::vector<uint32_t> sorted(pages);
+    std::sort(sorted.begin(), sorted.end());
+    return std::unique(sorted.begin(), sorted.end()) - sorted.begin();
+}
+
+}
+
+// Count the LRU page faults of a trace for many numbers of frames in one pass
+std::vector<long> lru_fault_curve(const std::vector<uint32_t>& pages, const std::vector<int>& frame_counts)
+{
+    int max_frames = 0;
+    uint32_t max_page = 0;
+    for (size_t i = 0; i < frame_counts.size(); i++) {
+        max_frames = std::max(max_frames, frame_counts[i]);
+    }
+    for (size_t i = 0; i < pages.size(); i++) {
+        max_page = std::max(max_page, pages[i]);
+    }
+
+    // tree is a Fenwick tree over the positions 1 to n of the trace; last is each page's latest position, 0 if none
+    size_t n = pages.size();
+    std::vector<int> tree(n + 1, 0);
+    std::vector<uint32_t> last(pages.empty() ? 0 : (size_t)max_page + 1, 0);
+    // distances[d] counts the references at stack distance d, with every distance beyond max_frames in the last slot
+    std::vector<long> distances(max_frames + 2, 0);
+    long cold = 0;
+    for (size_t t = 1; t <= n; t++) {
+        uint32_t page = pages[t - 1];
+        uint32_t previous = last[page];
+        if (previous == 0) {
+            cold++;
+        } else {
+            // The ones after previous are the pages referenced since, each counted once at its latest position
+            long since = 0;
+            for (size_t i = t - 1; i > 0; i -= i & -i) {
+                since += tree[i];
+            }
+            for (size_t i = previous; i > 0; i -= i & -i) {
+                since -= tree[i];
+            }
+            distances[std::min<long>(since + 1, max_frames + 1)]++;
+            for (size_t i = previous; i <= n; i += i & -i) {
+                tree[i]--;
+            }
+        }
+        for (size_t i = t; i <= n; i += i & -i) {
+            tree[i]++;
+        }
+        last[page] = t;
+    }
+
+    // The faults with f frames are the cold misses and the references at a distance beyond f
+    std::vector<long> beyond(max_frames + 2, 0);
+    for (int d = max_frames; d >= 0; d--) {
+        beyond[d] = beyond[d + 1] + distances[d + 1];
+    }
+    std::vector<long> faults;
+    for (size_t i = 0; i < frame_counts.size(); i++) {
+        faults.push_back(cold + beyond[frame_counts[i]]);
+    }
+    return faults;
+}
+
+// Simulate every algorithm at every page size and memory size on a pool of threads
+std::vector<SweepResult> run_sweep(const std::vector<uint32_t>& pages, int logic_mem_bits, PageTableKind kind, int num_threads)
+{
+    // The trace at every page size, shared read-only by the threads
+    std::vector<std::vector<uint32_t> > traces(MAX_PAGE_BITS - MIN_PAGE_BITS + 1);
+    for (int bits = MIN_PAGE_BITS; bits <= MAX_PAGE_BITS; bits++) {
+        std::vector<uint32_t>& trace = traces[bits - MIN_PAGE_BITS];
+        trace.resize(pages.size());
+        for (size_t i = 0; i < pages.size(); i++) {
+            trace[i] = pages[i] >> (bits - MIN_PAGE_BITS);
+        }
+    }
+
+    // Every task writes only its own results, so the threads share nothing but the next task's index
+    std::vector<SweepResult> results(NUM_SWEEP_POLICIES * traces.size() * NUM_MEMORY_SIZES);
+    for (int policy = 0; policy < NUM_SWEEP_POLICIES; policy++) {
+        for (int bits = MIN_PAGE_BITS; bits <= MAX_PAGE_BITS; bits++) {
+            for (int m = 0; m < NUM_MEMORY_SIZES; m++) {
+                SweepResult& result = results[result_index((SweepPolicy)policy, bits, m)];
+                result.policy = POLICY_NAMES[policy];
+                result.page_size = 1 << bits;
+                result.memory_mb = 1 << (MIN_MEMORY_BITS + m - 20);
+                result.num_frames = 1 << (MIN_MEMORY_BITS + m - bits);
+            }
+        }
+    }
+    // The LRU curves come first, as each one is the longest task
+    std::vector<SweepTask> tasks;
+    for (int bits = MIN_PAGE_BITS; bits <= MAX_PAGE_BITS; bits++) {
+        SweepTask task = {SWEEP_LRU, bits, 0};
+        tasks.push_back(task);
+    }
+    for (int policy = 0; policy < NUM_SWEEP_POLICIES; policy++) {
+        for (int bits = MIN_PAGE_BITS; bits <= MAX_PAGE_BITS && policy != SWEEP_LRU; bits++) {
+            for (int m = 0; m < NUM_MEMORY_SIZES; m++) {
+                SweepTask task = {(SweepPolicy)policy, bits, m};
+                tasks.push_back(task);
+            }
+        }
+    }
+
+    std::atomic<size_t> next_task(0);
+    std::vector<std::thread> pool;
+    for (int i = 0; i < std::max(num_threads, 1); i++) {
+        pool.push_back(std::thread([&]() {
+            for (size_t t = next_task++; t < tasks.size(); t = next_task++) {
+                const SweepTask& task = tasks[t];
+                const std::vector<uint32_t>& trace = traces[task.page_bits - MIN_PAGE_BITS];
+                int num_pages = 1 << (logic_mem_bits - task.page_bits);
+                SweepResult& result = results[result_index(task.policy, task.page_bits, task.memory_index)];
+                switch (task.policy) {
+                case SWEEP_FIFO:
+                    replay<FIFOReplacement>(trace, num_pages, result.num_frames, kind, result);
+                    break;
+                case SWEEP_LIFO:
+                    replay<LIFOReplacement>(trace, num_pages, result.num_frames, kind, result);
+                    break;
+                case SWEEP_CLOCK:
+                    replay<ClockReplacement>(trace, num_pages, result.num_frames, kind, result);
+                    break;
+                case SWEEP_CAR:
+                    replay<CARReplacement>(trace, num_pages, result.num_frames, kind, result);
+                    break;
+                default: {
+                    // SWEEP_LRU: every memory size of this page size at once; frames are only replaced once all are in use
+                    std::vector<int> frame_counts;
+                    for (int m = 0; m < NUM_MEMORY_SIZES; m++) {
+                        frame_counts.push_back(results[result_index(SWEEP_LRU, task.page_bits, m)].num_frames);
+                    }
+                    std::vector<long> faults = lru_fault_curve(trace, frame_counts);
+                    long distinct = count_distinct(trace);
+                    for (int m = 0; m < NUM_MEMORY_SIZES; m++) {
+                        SweepResult& lru = results[result_index(SWEEP_LRU, task.page_bits, m)];
+                        lru.num_references = trace.size();
+                        lru.num_faults = faults[m];
+                        lru.num_replacements = faults[m] - std::min<long>(distinct, lru.num_frames);
+                    }
+                    break;
+                }
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < pool.size(); i++) {
+        pool[i].join();
+    }
+    return results;
+}
+
+// Write sweep results as CSV
+bool write_sweep_csv(const char *path, const std::vector<SweepResult>& results)
+{
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        return false;
+    }
+    fprintf(out, "policy,page_size,memory_mb,frames,references,faults,replacements,fault_rate\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const SweepResult& r = results[i];
+        fprintf(out, "%s,%d,%d,%d,%ld,%ld,%ld,%.6f\n", r.policy, r.page_size, r.memory_mb, r.num_frames,
+                r.num_references, r.num_faults, r.num_replacements,
+                r.num_references ? (double)r.num_faults / r.num_references : 0.0);
+    }
+    return fclose(out) == 0;
+}
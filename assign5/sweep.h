@@ -0,0 +1,66 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file sweep.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A sweep of every replacement algorithm over every page size and memory size, run on a thread pool.
+ * @version 0.1
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "pagetable.h"
+
+/**
+ * @brief The outcome of one algorithm at one page size and memory size
+ */
+struct SweepResult
+{
+    // Name of the replacement algorithm
+    const char *policy;
+    // Page size in bytes
+    int page_size;
+    // Physical memory size in megabytes
+    int memory_mb;
+    // Number of physical frames
+    int num_frames;
+    // Number of references, page faults and page replacements
+    long num_references;
+    long num_faults;
+    long num_replacements;
+};
+
+/**
+ * @brief Count the LRU page faults of a trace for many numbers of frames in one pass (Mattson's stack algorithm).
+ * @details The stack distance of a reference is the number of distinct pages referenced since the last reference
+ *          to the same page, plus one. LRU with n frames faults exactly when the distance exceeds n, or on the
+ *          first reference to a page. The distinct pages in between are counted with a Fenwick tree over the
+ *          positions of the trace, holding a one at the latest reference of each page, so a reference costs
+ *          O(log length) whatever the number of frames.
+ * @param pages The page numbers of the trace.
+ * @param frame_counts The numbers of frames.
+ * @return The number of faults for each number of frames, in the same order
+ */
+std::vector<long> lru_fault_curve(const std::vector<uint32_t>& pages, const std::vector<int>& frame_counts);
+
+/**
+ * @brief Simulate FIFO, LIFO, LRU, Clock and CAR for every page size from 256 to 8192 bytes and every memory size
+ *        from 4 to 64 MB, both in powers of two.
+ * @details The trace is shared by all threads, read once with the smallest page size and shifted for the others.
+ *          The simulations are handed out to a pool of threads, one at a time, and LRU takes one pass per page size.
+ * @param pages The page numbers of the trace, for 256-byte pages.
+ * @param logic_mem_bits Number of bits of the logical addresses.
+ * @param kind How the page tables store their entries.
+ * @param num_threads Number of threads of the pool.
+ * @return The results, ordered by policy, then page size, then memory size
+ */
+std::vector<SweepResult> run_sweep(const std::vector<uint32_t>& pages, int logic_mem_bits, PageTableKind kind, int num_threads);
+
+/**
+ * @brief Write sweep results as CSV, with a header line
+ * @param path The path of the file to create.
+ * @param results The results of run_sweep.
+ * @return true on success, false if the file cannot be written
+ */
+bool write_sweep_csv(const char *path, const std::vector<SweepResult>& results);
@@ -0,0 +1,108 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file tlb.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief A set-associative translation lookaside buffer consulted before the page table.
+ * @version 0.1
+ */
+
+#include "tlb.h"
+
+// Definitions of the tags, which are passed by reference
+const int32_t Tlb::EMPTY;
+const int32_t Tlb::PADDING;
+
+// Check that the entries split into a power-of-two number of sets
+bool TlbConfig::is_valid() const
+{
+    if (entries <= 0 || ways <= 0 || entries % ways != 0) {
+        return false;
+    }
+    int sets = entries / ways;
+    return (sets & (sets - 1)) == 0;
+}
+
+// Constructor: every entry starts free, and the ways of each set are padded up to a multiple of four
+Tlb::Tlb(const TlbConfig& config)
+: config(config)
+{
+    if (config.entries <= 0) {
+        return;
+    }
+    int sets = config.entries / config.ways;
+    set_mask = sets - 1;
+    stride = (config.ways + 3) & ~3;
+    tags.assign((size_t)sets * stride, PADDING);
+    last_used.assign(tags.size(), UINT32_MAX);    // The padding is never the oldest
+    free_entries = config.entries;
+    for (int set = 0; set < sets; set++) {
+        for (int way = 0; way < config.ways; way++) {
+            tags[(size_t)set * stride + way] = EMPTY;
+            last_used[(size_t)set * stride + way] = 0;
+        }
+    }
+}
+
+// Find the entry of a set used longest ago
+int Tlb::oldest(const uint32_t* used) const
+{
+#ifdef __SSE2__
+    // SSE2 only compares signed integers, so the times are offset by 2^31 to compare them as unsigned; the minimum
+    // of the set is found four lanes at a time, then across the lanes, and then its way with find
+    const __m128i bias = _mm_set1_epi32(INT32_MIN);
+    __m128i low = _mm_xor_si128(_mm_loadu_si128((const __m128i*)used), bias);
+    for (int way = 4; way < stride; way += 4) {
+        __m128i time = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(used + way)), bias);
+        __m128i less = _mm_cmplt_epi32(time, low);
+        low = _mm_or_si128(_mm_and_si128(less, time), _mm_andnot_si128(less, low));
+    }
+    for (int shift = 0; shift < 2; shift++) {
+        __m128i other = shift == 0 ? _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)) : _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128i less = _mm_cmplt_epi32(other, low);
+        low = _mm_or_si128(_mm_and_si128(less, other), _mm_andnot_si128(less, low));
+    }
+    return find((const int32_t*)used, _mm_cvtsi128_si32(low) ^ INT32_MIN);
+#else
+    int way = 0;
+    for (int i = 1; i < config.ways; i++) {
+        if (used[i] < used[way]) {
+            way = i;
+        }
+    }
+    return way;
+#endif
+}
+
+// Put a page into a free entry of a set, or else evict one
+void Tlb::fill(uint32_t base, int page_num)
+{
+    int way = free_entries > 0 ? find(&tags[base], EMPTY) : -1;
+    if (way >= 0) {
+        free_entries--;
+    } else {
+        if (config.eviction == TLB_LRU) {
+            way = oldest(&last_used[base]);
+        } else {
+            random_state ^= random_state << 13;
+            random_state ^= random_state >> 17;
+            random_state ^= random_state << 5;
+            way = random_state % config.ways;
+        }
+    }
+    tags[base + way] = page_num;
+    last_used[base + way] = ++now;
+}
+
+// Shoot down a page that is no longer in memory, freeing its entry
+void Tlb::invalidate(int page_num)
+{
+    if (!enabled()) {
+        return;
+    }
+    uint32_t base = (page_num & set_mask) * stride;
+    int way = find(&tags[base], page_num);
+    if (way >= 0) {
+        tags[base + way] = EMPTY;
+        free_entries++;
+    }
+}
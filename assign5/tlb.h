@@ -0,0 +1,215 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file tlb.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief A set-associative translation lookaside buffer consulted before the page table.
+ * @version 0.1
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief How a full set of the TLB chooses the entry to evict
+ */
+enum TlbEviction {
+    TLB_LRU,        // The least recently used entry of the set
+    TLB_RANDOM      // Any entry of the set, chosen by a pseudo-random generator
+};
+
+/**
+ * @brief The shape of a TLB. A TLB with no entries is disabled.
+ */
+struct TlbConfig {
+    // Total number of entries, 0 for no TLB
+    int entries = 0;
+    // Entries per set; the number of sets, entries / ways, must be a power of two
+    int ways = 4;
+    // Eviction within a full set
+    TlbEviction eviction = TLB_LRU;
+
+    /**
+     * @brief Check that the entries split into a power-of-two number of sets
+     */
+    bool is_valid() const;
+};
+
+/**
+ * @brief A set-associative TLB of page numbers.
+ * A page maps to the set given by the low bits of its number. The tags of a set are contiguous and padded to a
+ * multiple of four, so a lookup compares four tags per SSE2 instruction. The TLB only caches which pages are
+ * valid; the caller must invalidate a page when it is evicted from memory.
+ */
+class Tlb
+{
+private:
+    // Tag of a free entry, and of the padding after the last way of a set; neither is a page number
+    static const int32_t EMPTY = -1;
+    static const int32_t PADDING = -2;
+
+    // The configuration it was built with
+    TlbConfig config;
+    // Number of sets minus one, to select a set from a page number
+    uint32_t set_mask = 0;
+    // Tags per set including the padding, a multiple of four
+    int stride = 0;
+    // Page number held by each entry, set after set
+    std::vector<int32_t> tags;
+    // Time of the last use of each entry, for LRU eviction; the padding has the latest possible time
+    std::vector<uint32_t> last_used;
+    // Counter of lookups, the time for LRU
+    uint32_t now = 0;
+    // Number of free entries, so a full TLB does not look for one on every miss
+    int free_entries = 0;
+    // State of the xorshift generator for random eviction
+    uint32_t random_state = 2463534242u;
+    // Number of lookups that found and missed their page
+    long hits = 0;
+    long misses = 0;
+
+    /**
+     * @brief Find a tag in a set
+     * @details Sixteen tags are compared at a time while the set has that many left, their four compare results
+     *          packed into one mask of sixteen bytes, then four at a time.
+     * @param set The first tag of the set
+     * @param tag The tag to look for
+     * @return Its way, or -1 if the set does not hold it
+     */
+    int find(const int32_t* set, int32_t tag) const {
+#ifdef __SSE2__
+        __m128i key = _mm_set1_epi32(tag);
+        int way = 0;
+        for (; way + 16 <= stride; way += 16) {
+            __m128i equal0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(set + way)), key);
+            __m128i equal1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(set + way + 4)), key);
+            __m128i equal2 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(set + way + 8)), key);
+            __m128i equal3 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(set + way + 12)), key);
+            __m128i packed = _mm_packs_epi16(_mm_packs_epi32(equal0, equal1), _mm_packs_epi32(equal2, equal3));
+            int mask = _mm_movemask_epi8(packed);
+            if (mask != 0) {
+                return way + __builtin_ctz(mask);
+            }
+        }
+        for (; way < stride; way += 4) {
+            __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(set + way)), key);
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+            if (mask != 0) {
+                return way + __builtin_ctz(mask);
+            }
+        }
+#else
+        for (int way = 0; way < config.ways; way++) {
+            if (set[way] == tag) {
+                return way;
+            }
+        }
+#endif
+        return -1;
+    }
+
+    /**
+     * @brief Put a page into a free entry of a set, or else into the entry the eviction policy chooses
+     * @param base The index of the first tag of the set
+     * @param page_num The logical page number.
+     */
+    void fill(uint32_t base, int page_num);
+
+    /**
+     * @brief Find the entry of a full set used longest ago. Every time is distinct, so there is one such entry.
+     * @param used The time of the last use of the first entry of the set
+     * @return Its way
+     */
+    int oldest(const uint32_t* used) const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param config The shape of the TLB, which must be valid or have no entries
+     */
+    Tlb(const TlbConfig& config = TlbConfig());
+
+    /**
+     * @brief Whether the TLB has any entries
+     */
+    bool enabled() const { return stride != 0; }
+
+    /**
+     * @brief Look up a page in an enabled TLB without counting a hit or a miss, for a caller that counts them itself
+     *        with count. A hit refreshes the entry for LRU eviction.
+     * @param page_num The logical page number.
+     * @return true if the TLB holds the page
+     */
+    bool contains(int page_num) {
+        uint32_t base = (page_num & set_mask) * stride;
+        int way = find(&tags[base], page_num);
+        if (way < 0) {
+            return false;
+        }
+        last_used[base + way] = ++now;
+        return true;
+    }
+
+    /**
+     * @brief Add lookups made with contains to the counts of hits and misses
+     * @param hits The number of lookups that found their page
+     * @param misses The number of lookups that missed
+     */
+    void count(long hits, long misses) {
+        this->hits += hits;
+        this->misses += misses;
+    }
+
+    /**
+     * @brief Look up a page, counting a hit or a miss. A disabled TLB always misses and counts nothing.
+     * @param page_num The logical page number.
+     * @return true if the TLB holds the page
+     */
+    bool lookup(int page_num) {
+        if (!enabled()) {
+            return false;
+        }
+        if (contains(page_num)) {
+            hits++;
+            return true;
+        }
+        misses++;
+        return false;
+    }
+
+    /**
+     * @brief Add a page after a miss, evicting an entry of its set if the set is full
+     * @param page_num The logical page number, which must not be in the TLB already.
+     */
+    void insert(int page_num) {
+        if (enabled()) {
+            fill((page_num & set_mask) * stride, page_num);
+        }
+    }
+
+    /**
+     * @brief Shoot down a page that is no longer in memory
+     * @param page_num The logical page number.
+     */
+    void invalidate(int page_num);
+
+    /**
+     * @brief Get the number of lookups that found their page
+     */
+    long get_hits() const { return hits; }
+
+    /**
+     * @brief Get the number of lookups that missed
+     */
+    long get_misses() const { return misses; }
+
+    /**
+     * @brief Get the configuration of the TLB
+     */
+    const TlbConfig& get_config() const { return config; }
+};
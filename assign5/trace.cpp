@@ -0,0 +1,167 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file trace.cpp
+ * @author Noya Hafiz, Christian Lim
+ * @brief Fast loading of reference traces, as decimal text or as a compact binary file of page numbers.
+ * @version 0.1
+ */
+
+#include "trace.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The magic number at the start of a binary trace
+static const char TRACE_MAGIC[8] = {'P', 'G', 'T', 'R', 'A', 'C', 'E', '1'};
+
+/**
+ * @brief A read-only memory mapping of a whole file, unmapped when it goes out of scope
+ */
+class MappedFile
+{
+public:
+    // Start of the file's bytes, nullptr if the file could not be mapped or is empty
+    const char *data = nullptr;
+    // Size of the file in bytes
+    size_t size = 0;
+
+    /**
+     * @brief Map a file
+     * @param path The path of the file.
+     * @return true if the file was opened, even if it is empty
+     */
+    bool open(const char *path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            return false;
+        }
+        size = info.st_size;
+        if (size > 0) {
+            void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                close(fd);
+                return false;
+            }
+            // The trace is read once from start to end
+            madvise(mapped, size, MADV_SEQUENTIAL);
+            data = (const char *)mapped;
+        }
+        // The mapping stays valid after the descriptor is closed
+        close(fd);
+        return true;
+    }
+
+    ~MappedFile() {
+        if (data != nullptr) {
+            munmap((void *)data, size);
+        }
+    }
+};
+
+// Parse the decimal numbers of a mapped text trace
+static void parse_addresses(const MappedFile& file, std::vector<uint32_t>& addresses)
+{
+    // Every number except possibly the last one ends a line, so counting newlines sizes the result
+    size_t lines = 1;
+    for (const char *p = file.data, *end = file.data + file.size; (p = (const char *)memchr(p, '\n', end - p)) != nullptr; p++) {
+        lines++;
+    }
+    addresses.resize(lines);
+    size_t count = 0;
+    const char *p = file.data;
+    const char *end = file.data + file.size;
+    while (p < end) {
+        // Skip anything that is not a digit, such as newlines and spaces
+        if ((unsigned)(*p - '0') > 9) {
+            p++;
+            continue;
+        }
+        uint32_t value = 0;
+        while (p < end && (unsigned)(*p - '0') <= 9) {
+            value = value * 10 + (*p - '0');
+            p++;
+        }
+        // A line holding several numbers needs more room than the count of lines gave
+        if (count == addresses.size()) {
+            addresses.resize(addresses.size() * 2);
+        }
+        addresses[count++] = value;
+    }
+    addresses.resize(count);
+}
+
+// Read a text trace of decimal logical addresses
+bool read_addresses(const char *path, std::vector<uint32_t>& addresses)
+{
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    addresses.clear();
+    if (file.size > 0) {
+        parse_addresses(file, addresses);
+    }
+    return true;
+}
+
+// Read the page numbers of a binary or text trace
+bool read_pages(const char *path, int page_offset_bits, std::vector<uint32_t>& pages)
+{
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    pages.clear();
+    TraceHeader header;
+    if (file.size >= sizeof(header) && memcmp(file.data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0) {
+        // A binary trace: the page numbers are copied straight out of the file
+        memcpy(&header, file.data, sizeof(header));
+        if (file.size < sizeof(header) + (size_t)header.count * sizeof(uint32_t) || (int)header.page_offset_bits > page_offset_bits) {
+            return false;
+        }
+        pages.resize(header.count);
+        if (header.count > 0) {
+            memcpy(pages.data(), file.data + sizeof(header), (size_t)header.count * sizeof(uint32_t));
+        }
+        int shift = page_offset_bits - header.page_offset_bits;
+        if (shift > 0) {
+            for (size_t i = 0; i < pages.size(); i++) {
+                pages[i] >>= shift;
+            }
+        }
+        return true;
+    }
+    // A text trace: parse the addresses and turn them into page numbers in place
+    if (file.size > 0) {
+        parse_addresses(file, pages);
+    }
+    for (size_t i = 0; i < pages.size(); i++) {
+        pages[i] >>= page_offset_bits;
+    }
+    return true;
+}
+
+// Write page numbers as a binary trace
+bool write_pages(const char *path, int page_offset_bits, const std::vector<uint32_t>& pages)
+{
+    FILE *out = fopen(path, "wb");
+    if (out == nullptr) {
+        return false;
+    }
+    TraceHeader header;
+    memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.page_offset_bits = page_offset_bits;
+    header.count = pages.size();
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+              fwrite(pages.data(), sizeof(uint32_t), pages.size(), out) == pages.size();
+    return fclose(out) == 0 && ok;
+}
@@ -0,0 +1,54 @@
+/**
+* Assignment 5: Page replacement algorithms
+ * @file trace.h
+ * @author Noya Hafiz, Christian Lim
+ * @brief Fast loading of reference traces, as decimal text or as a compact binary file of page numbers.
+ * @version 0.1
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The header of a binary trace, followed by count page numbers as native-endian uint32
+ */
+struct TraceHeader
+{
+    // "PGTRACE1", telling a binary trace from a text one
+    char magic[8];
+    // The page offset bits the logical addresses were shifted by
+    uint32_t page_offset_bits;
+    // Number of page numbers after the header
+    uint32_t count;
+};
+
+/**
+ * @brief Read a text trace of decimal logical addresses, one or more per line.
+ * The file is mapped into memory and scanned once to size the result, then once to parse it.
+ * @param path The path of the trace file.
+ * @param addresses Receives the addresses in order.
+ * @return true on success, false if the file cannot be read
+ */
+bool read_addresses(const char *path, std::vector<uint32_t>& addresses);
+
+/**
+ * @brief Read the page numbers of a trace, from either a binary or a text file.
+ * A text file is parsed and each address shifted right by page_offset_bits. A binary file written with fewer
+ * offset bits is shifted by the difference; one written with more offset bits cannot be used.
+ * @param path The path of the trace file.
+ * @param page_offset_bits Number of bits for page offset.
+ * @param pages Receives the page numbers in order.
+ * @return true on success, false if the file cannot be read or was written for larger pages
+ */
+bool read_pages(const char *path, int page_offset_bits, std::vector<uint32_t>& pages);
+
+/**
+ * @brief Write page numbers as a binary trace.
+ * @param path The path of the file to create.
+ * @param page_offset_bits Number of bits for page offset the pages were computed with.
+ * @param pages The page numbers.
+ * @return true on success, false if the file cannot be written
+ */
+bool write_pages(const char *path, int page_offset_bits, const std::vector<uint32_t>& pages);